@@ -1,14 +1,28 @@
-cbuffer MatrixBuffer
+//Written when the screen size changes, one buffer per camera
+cbuffer CameraBuffer : register(b0)
 {
-    matrix worldMatrix;
     matrix viewMatrix;
     matrix projectionMatrix;
 };
 
-struct VertexInputType
+struct SpriteInputType
 {
     float4 position : POSITION;
     float2 tex : TEXCOORD0;
+    float4 rect : TEXCOORD1;
+    float2 depthAngle : TEXCOORD2;
+    float4 uvRect : TEXCOORD3;
+};
+
+struct PlanetInputType
+{
+    float4 position : POSITION;
+    float2 tex : TEXCOORD0;
+    float4 world0 : TEXCOORD1;
+    float4 world1 : TEXCOORD2;
+    float4 world2 : TEXCOORD3;
+    float4 world3 : TEXCOORD4;
+    float slice : TEXCOORD5;
 };
 
 struct PixelInputType
@@ -17,22 +31,51 @@ struct PixelInputType
     float2 tex : TEXCOORD0;
 };
 
+struct PlanetPixelInputType
+{
+    float4 position : SV_POSITION;
+    float2 tex : TEXCOORD0;
+    nointerpolation float slice : TEXCOORD1;
+};
 
-PixelInputType TextureVertexShader(VertexInputType input)
+
+PixelInputType SpriteVertexShader(SpriteInputType input)
 {
     PixelInputType output;
-    
+    float2 halfSize = input.rect.zw * 0.5f;
+    float sinAngle;
+    float cosAngle;
 
-    //Change the position vector to be 4 units for proper matrix calculations
-    input.position.w = 1.0f;
+    //Rotate the quad around its center, then scale it to the sprite size and move it into place. This is the same
+    //transform DrawTexture2D used to build on the CPU for every sprite.
+    sincos(input.depthAngle.y, sinAngle, cosAngle);
+    float2 rotated = float2(input.position.x * cosAngle - input.position.y * sinAngle, input.position.x * sinAngle + input.position.y * cosAngle);
+    float4 position = float4(rotated * halfSize + input.rect.xy + halfSize, input.position.z + input.depthAngle.x, 1.0f);
 
-    //Calculate the position of the vertex against the world, view, and projection matrices
-    output.position = mul(input.position, worldMatrix);
+    //Sprites have no world matrix, so only the view and projection matrices are applied
+    output.position = mul(position, viewMatrix);
+    output.position = mul(output.position, projectionMatrix);
+
+    //Map the quad texture coordinates into the region of the atlas the sprite is drawn from
+    output.tex = input.uvRect.xy + input.tex * input.uvRect.zw;
+
+    return output;
+}
+
+
+PlanetPixelInputType PlanetVertexShader(PlanetInputType input)
+{
+    PlanetPixelInputType output;
+    float4x4 planetWorld = float4x4(input.world0, input.world1, input.world2, input.world3);
+
+    //Each planet carries its own world matrix in place of the one in the object buffer
+    input.position.w = 1.0f;
+    output.position = mul(input.position, planetWorld);
     output.position = mul(output.position, viewMatrix);
     output.position = mul(output.position, projectionMatrix);
 
-    //Store the texture coordinates for the pixel shader
     output.tex = input.tex;
-    
+    output.slice = input.slice;
+
     return output;
 }
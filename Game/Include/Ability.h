@@ -6,6 +6,7 @@ Programmer:		Kyle Jensen
 Date:			March 24, 2017
 */
 
+#pragma once
 
 #include "Vector.h"
 struct Ability
@@ -0,0 +1,28 @@
+/*
+File Name:		Adpcm.h
+Description:	This file holds the IMA ADPCM codec the sounds in the asset archive can be stored with. Each 16 bit sample is kept
+				as a 4 bit step from the one before, a quarter of the size, and decoding is a couple of table lookups per sample.
+				Samples are grouped into blocks laid out like WAVE_FORMAT_IMA_ADPCM stereo: a header per channel holding its first
+				sample and step index, then interleaved runs of 8 samples per channel. A block needs nothing from the blocks
+				before it, so a sound can be decoded a block at a time from any point as it plays.
+				Nothing in here depends on DirectSound.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+//Stereo blocks of this many bytes, 8 bytes of headers and 127 runs of 8 samples for each channel, plus the header sample
+#define ADPCM_CHANNELS 2
+#define ADPCM_BLOCK_BYTES 1024
+#define ADPCM_BLOCK_FRAMES 1017
+
+//ADPCM prototypes
+size_t AdpcmSize(uint32_t frameCount);
+void AdpcmEncode(const int16_t* samples, uint32_t frameCount, std::vector<unsigned char>* encoded);
+void AdpcmDecodeBlock(const unsigned char* block, int16_t* output);
+void AdpcmFirstFrame(const unsigned char* block, int16_t* output);
@@ -0,0 +1,102 @@
+/*
+File Name:		Archive.h
+Description:	This file holds the packed asset archive. Every asset is baked into one file by the asset packer, already in the
+				form the game uploads: textures as RGBA rows stored top to bottom, sprites as rectangles of the atlas pages, sounds as raw PCM or IMA ADPCM blocks, models in the binary mesh
+				format and everything else as the original bytes. The archive starts with a hash table of its entries, so the game maps the one file and finds
+				any asset by name without searching. Nothing in here depends on D3D11 or DirectSound.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "MappedFile.h"
+
+#define ARCHIVE_MAGIC 0x4B505453	//"STPK" read as a little endian integer
+#define ARCHIVE_VERSION 3
+
+//Every asset starts on a multiple of this many bytes from the start of the archive
+#define ARCHIVE_ALIGNMENT 16
+
+enum AssetType
+{
+	AssetRaw,
+	AssetTexture,
+	AssetSound,
+	AssetMesh,
+	AssetSprite
+};
+
+struct ArchiveHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t entryCount;
+
+	//Size of the hash table, always a power of two with at least one empty slot
+	uint32_t slotCount;
+
+	//The hash table follows the header, then the zero terminated names, then the assets
+	uint64_t namesOffset;
+	uint64_t namesSize;
+};
+
+struct ArchiveTextureInfo
+{
+	uint32_t width;
+	uint32_t height;
+};
+
+//A sprite packed into an atlas page, in pixels on the page. Sprites have no bytes of their own, their pixels are the page's.
+struct ArchiveSpriteInfo
+{
+	uint32_t page;
+	uint32_t x;
+	uint32_t y;
+	uint32_t width;
+	uint32_t height;
+};
+
+//Sounds are 16 bits per sample of PCM, or 4 of IMA ADPCM in the blocks of Adpcm.h
+struct ArchiveSoundInfo
+{
+	uint32_t sampleRate;
+	uint16_t channels;
+	uint16_t bitsPerSample;
+	uint32_t frameCount;
+};
+
+//A slot of the hash table. Entries are placed at their hash modulo the slot count, or the next free slot after it.
+struct ArchiveEntry
+{
+	uint64_t hash;			//0 marks an empty slot
+	uint64_t offset;
+	uint64_t size;
+	uint32_t nameOffset;
+	uint32_t type;
+
+	union
+	{
+		ArchiveTextureInfo texture;
+		ArchiveSpriteInfo sprite;
+		ArchiveSoundInfo sound;
+	};
+};
+
+class AssetArchive
+{
+public:
+	MappedFile file;
+	const ArchiveHeader* header;
+	const ArchiveEntry* slots;
+	const char* names;
+
+	bool Open(const char* fileName);
+	const ArchiveEntry* Find(const char* name) const;
+	const unsigned char* Data(const ArchiveEntry* entry) const;
+	const char* Name(const ArchiveEntry* entry) const;
+	void Touch(const ArchiveEntry* entry) const;
+};
+
+uint64_t ArchiveHash(const char* name);
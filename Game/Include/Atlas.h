@@ -0,0 +1,60 @@
+/*
+File Name:		Atlas.h
+Description:	This file holds the texture atlas packer. Images are packed onto a few square pages with shelf packing, and each
+				image gets a rectangle on its page. The asset packer runs it when it builds the archive, so the pages and the
+				rectangles are baked into it and the game only uploads them.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <vector>
+
+#define ATLAS_PAGE_SIZE 2048
+
+//Pixels around every image that repeat its border, so filtering does not bleed the neighbouring images in
+#define ATLAS_PADDING 4
+
+//Mips the pages are created with. Every image starts on a multiple of the padding and fills its cell out to the next one
+//with its border, so down to the mip where the padding is one texel, log2(ATLAS_PADDING), no texel mixes two images.
+#define ATLAS_MIP_LEVELS 3
+
+//Name the asset packer stores each page under, the sprites give the number of their page
+#define ATLAS_PAGE_NAME "Atlas/page%d.tga"
+
+//An RGBA image stored top to bottom
+struct AtlasImage
+{
+	int width;
+	int height;
+	std::vector<unsigned char> pixels;
+};
+
+//Where an image ended up, in pixels on its page
+struct AtlasRect
+{
+	int page;
+	int x;
+	int y;
+	int width;
+	int height;
+};
+
+struct AtlasPage
+{
+	int width;
+	int height;
+	std::vector<unsigned char> pixels;
+};
+
+class TextureAtlas
+{
+public:
+	std::vector<AtlasPage> pages;
+
+	//One rectangle per packed image, in the order the images were given
+	std::vector<AtlasRect> rects;
+
+	void Pack(const std::vector<AtlasImage>& images);
+};
@@ -0,0 +1,43 @@
+/*
+File Name:		AudioConvert.h
+Description:	This file holds the conversions that bring a sound into the mix format of the engine, 44.1kHz stereo: mixing any
+				speaker layout down to two channels, and a windowed-sinc resampler. They run once, when the asset packer bakes
+				a sound, so the mixer never converts anything while it plays.
+				Nothing in here depends on DirectSound.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+//Input samples each side of an output sample the resampling filter reaches, when the rate goes up. Going down the filter is
+//widened by the ratio, so it still cuts off cleanly below the new Nyquist frequency.
+#define RESAMPLE_HALF_TAPS 16
+
+//Points between two input samples the filter is worked out at, the ones in between are blended from the nearest two
+#define RESAMPLE_PHASES 256
+
+//Speaker bits of WAVEFORMATEXTENSIBLE's dwChannelMask, in the order the channels of a file are stored
+enum SpeakerBit
+{
+	SpeakerFrontLeft = 0x1,
+	SpeakerFrontRight = 0x2,
+	SpeakerFrontCenter = 0x4,
+	SpeakerLowFrequency = 0x8,
+	SpeakerBackLeft = 0x10,
+	SpeakerBackRight = 0x20,
+	SpeakerFrontLeftOfCenter = 0x40,
+	SpeakerFrontRightOfCenter = 0x80,
+	SpeakerBackCenter = 0x100,
+	SpeakerSideLeft = 0x200,
+	SpeakerSideRight = 0x400
+};
+
+//Audio conversion prototypes
+uint32_t DefaultChannelMask(int channels);
+void MixToStereo(const std::vector<float>& interleaved, int channels, uint32_t channelMask, std::vector<float>* left, std::vector<float>* right);
+void Resample(const std::vector<float>& input, uint32_t inputRate, uint32_t outputRate, std::vector<float>* output);
+void QuantizeStereo(const std::vector<float>& left, const std::vector<float>& right, std::vector<int16_t>* interleaved);
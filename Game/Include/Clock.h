@@ -0,0 +1,28 @@
+/*
+File Name:		Clock.h
+Description:	This file holds the simulation clock. It only moves when the simulation steps, by exactly the step size, so
+				cooldowns and timers behave the same whether the game runs in real time or fast-forwarded headless.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+//Milliseconds of simulation time
+typedef int64_t GameTime;
+
+#define SecondsToGameTime(seconds) ((GameTime)((seconds) * 1000))
+
+struct GameClock
+{
+	//Milliseconds since the clock was created
+	GameTime now;
+
+	//Fraction of a millisecond carried over from the last step, so 1/60s steps do not drift
+	float carry;
+
+	void Advance(float dt);
+	GameTime Since(GameTime time) const;
+};
@@ -0,0 +1,45 @@
+/*
+File Name:		Collision.h
+Description:	This file holds the batched collision test. One box is tested against many boxes stored as packed float arrays,
+				and the hits come back as a bitmask. The kernel is picked at runtime: AVX, SSE2 or a scalar fallback. Every kernel
+				gives exactly the same result as CheckCollision.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+//Boxes are stored in blocks of this many so the widest kernel never reads past the end of the arrays
+#define BOX_BLOCK_SIZE 8
+
+//Boxes stored as separate arrays of their edges. The arrays are padded to a whole block with boxes that never overlap anything.
+struct BoxArray
+{
+	int count;
+
+	std::vector<float> minX;
+	std::vector<float> minY;
+	std::vector<float> maxX;
+	std::vector<float> maxY;
+
+	//One bit per box, set by CollideBoxes when the box is hit
+	std::vector<uint32_t> hitMask;
+
+	void Clear();
+	void Add(float x, float y, float width, float height);
+	bool Hit(int index) const;
+};
+
+enum CollisionKernel
+{
+	CollisionScalar,
+	CollisionSSE2,
+	CollisionAVX
+};
+
+int CollideBoxes(float x, float y, float width, float height, BoxArray* boxes);
+CollisionKernel SelectCollisionKernel();
+void SetCollisionKernel(CollisionKernel kernel);
@@ -0,0 +1,85 @@
+/*
+File Name:		Commands.h
+Description:	This file holds the render and audio commands the simulation emits every step. The simulation only knows about
+				sprite and sound identifiers, the platform layer maps them to its own textures and sound buffers when it
+				consumes the commands. Nothing in here may depend on D3D11 or DirectSound.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include "Vector.h"
+
+#define NUM_PLANET_TYPES 11
+#define NUM_BACKGROUNDS 6
+
+//Identifiers for every texture the simulation can reference. Groups are laid out so that an ability's rocketIndex,
+//an enemy type or a planet type can be added to the first identifier of its group.
+enum SpriteId
+{
+	SpritePlayer,
+	SpriteEnemy,
+	SpriteBoss = SpriteEnemy + 2,
+	SpritePlayerRocket = SpriteBoss + 3,
+	SpriteEnemyRocket = SpritePlayerRocket + 3,
+	SpriteExplosion = SpriteEnemyRocket + 4,
+	SpritePlanet,
+	SpriteCount = SpritePlanet + NUM_PLANET_TYPES
+};
+
+//Identifiers for every sound the simulation can play. Background tracks are indexed the same way as the backgrounds.
+enum SoundId
+{
+	SoundSpaceShipMove,
+	SoundMissileFire,
+	SoundMissileHit,
+	SoundIntro,
+	SoundBackground,
+	SoundCount = SoundBackground + NUM_BACKGROUNDS
+};
+
+enum RenderCommandType
+{
+	RenderSprite,
+	RenderPlanet
+};
+
+//A single draw request. Sprites are placed in screen space, planets in world space using position, rotationAxis and angle.
+//Moving sprites also carry where they were at the start of the step, the renderer blends between the two.
+struct RenderCommand
+{
+	RenderCommandType type;
+	SpriteId sprite;
+
+	float previousX;
+	float previousY;
+	float x;
+	float y;
+	float width;
+	float height;
+	int zOrder;
+	float angle;
+
+	Vector3 position;
+	Vector3 rotationAxis;
+};
+
+enum AudioCommandType
+{
+	AudioPlay,		//Play the sound from the beginning, over any copies of it already playing
+	AudioLoop,		//Start looping the sound if it is not already playing
+	AudioStop
+};
+
+//A sound to play, loop or stop. Positional sounds also carry where they are relative to the player, in screen units, the
+//platform layer pans and attenuates them by it.
+struct AudioCommand
+{
+	AudioCommandType type;
+	SoundId sound;
+	long volume;
+
+	bool positional;
+	Vector2 offset;
+};
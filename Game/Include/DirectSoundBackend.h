@@ -0,0 +1,49 @@
+/*
+File Name:		DirectSoundBackend.h
+Description:	This file holds the DirectSound backend of the audio mixer. The mixed stream plays from one small looping sound
+				buffer split into chunks. A feeder thread watches the play cursor and keeps a few chunks ahead of it filled with
+				freshly mixed frames, so a sound the game starts is heard within the length of those few chunks.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "Platform.h"
+#include "Mixer.h"
+
+//The sound buffer is this many chunks of this many frames, 8192 frames or about 186ms of 44.1kHz 16bit stereo
+#define DSOUND_CHUNK_FRAMES 512
+#define DSOUND_CHUNK_BYTES (DSOUND_CHUNK_FRAMES * MIXER_CHANNELS * 2)
+#define DSOUND_CHUNK_COUNT 16
+
+//Chunks kept mixed past the one playing, about 58ms. Fewer is quicker to answer, too few and the feeder falls behind.
+#define DSOUND_LEAD_CHUNKS 5
+
+//How often the feeder checks the play cursor, well under the length of the lead
+#define DSOUND_FEED_INTERVAL_MS 5
+
+class DirectSoundBackend : public AudioBackend
+{
+public:
+	IDirectSound8* directSound;
+	IDirectSoundBuffer8* buffer;
+	AudioMixer* mixer;
+
+	//The feeder runs the code of the platform layer, so it keeps running while the game code is reloaded
+	std::thread feeder;
+	std::atomic<bool> running;
+
+	//The next chunk to mix into
+	int nextChunk;
+
+	DirectSoundBackend(IDirectSound8* directSound);
+	bool Start(AudioMixer* mixer);
+	void Stop();
+
+	void Feed();
+	void FillChunk(int chunk, bool silent);
+};
@@ -1,7 +1,7 @@
 /*
 File Name:		game.h
-Description:	This header file contains all the information for a game, from mouse input to game state to our
-				DLL code recompilation methods to our game logic prototypes.
+Description:	This header file contains all the platform side information for a game, from the renderer and sound resources
+				to our DLL code recompilation methods to our drawing prototypes. The game logic itself lives in Simulation.h.
 Programmer:		Kyle Jensen
 Date:			April 14, 2017
 */
@@ -13,62 +13,48 @@ Date:			April 14, 2017
 //Define a macro to easily get the count of a static array
 #define ArrayCount(array) sizeof(array)/sizeof(array[0])
 
-#define TILE_SIZE 10
-#define NUM_PLANET_TYPES 11
-#define NUM_BACKGROUNDS 6
-#define MAX_PLANETS 10
-
 #include "Platform.h"
-#include "ObjLoader.h"
+#include "Mesh.h"
 #include "Texture.h"
-#include "Ship.h"
-#include "Planet.h"
-#include "Rocket.h"
-#include "Sound.h"
+#include "Simulation.h"
+#include "Mixer.h"
+#include "SpriteRenderer.h"
+#include "PlanetRenderer.h"
+#include "RenderState.h"
+#include "Atlas.h"
+#include "Archive.h"
+#include "Replay.h"
+#include "Profiler.h"
 
 #include "DirectXTK\Inc\SpriteFont.h"
 #include "DirectXTK\Inc\SimpleMath.h"
-struct MouseInput
-{
-	bool downL;
-	bool downR;
-	bool clickedL;
-	bool clickedR;
-	int x;
-	int y;
-};
 
-struct Input
-{
-	MouseInput mouse;
-
-	bool key1;
-	bool key2;
-	bool key3;
-	bool key4;
-	bool keyE;
-	bool enter;
-};
+//The simulation always advances in steps of this size, however long the frames take
+#define SIMULATION_DT (1.0f / 60.0f)
 
-enum LevelState
-{
-	Start,
-	Exploration,
-	Discovery,
-	GameOver
-};
+//Set to 1 to draw the draw, map and bind counts of the last frame in the HUD
+#define SHOW_RENDER_STATS 0
 
+//Frames longer than this are clamped so a hitch or a debugger break does not queue up hundreds of steps
+#define MAX_FRAME_TIME 0.25f
 
-struct GameState
+//Everything the platform layer owns for the game: the renderer and sound resources, plus the simulation state they present.
+struct GameMemory
 {
+	//Every asset is loaded from this archive, it is opened by main.cpp before the first frame
+	const AssetArchive* archive;
+
 	//Buffers
-	ID3D11Buffer* matrixBuffer;
-	MatrixBufferType* shaderMatrices;
 	IDXGISwapChain* swapChain;
 	DXBuffer sphereVertexBuffer;
 	DXBuffer quadVertexBuffer;
-	MatrixBufferType perspectiveMatrices;
-	MatrixBufferType orthoMatrices;
+
+	//Constant buffers. Each camera has its own buffer, written when the game initializes, so switching between the 2D and
+	//the 3D draws only rebinds one. Sprites and planets carry their world transforms per instance.
+	ID3D11Buffer* perspectiveBuffer;
+	ID3D11Buffer* orthoBuffer;
+	CameraBufferType perspectiveMatrices;
+	CameraBufferType orthoMatrices;
 
 	//Fonts
 	SpriteBatch* spriteBatch;
@@ -76,85 +62,108 @@ struct GameState
 	SpriteFont* spriteFontLucida56;
 	
 	//Drawing stuff
-	ID3D11VertexShader* vertexShader;
 	ID3D11PixelShader* pixelShader;
-	ID3D11InputLayout* layout;
 	ID3D11RasterizerState* rasterState;
 	ID3D11SamplerState* sampleState;
 	ID3D11BlendState* blendState;
 
-	//Sound related items
+	//2D sprites are batched and drawn instanced, so are the planets. Their binds go through the render state cache.
+	SpriteRenderer spriteRenderer;
+	PlanetRenderer planetRenderer;
+	RenderStateCache renderState;
+	RenderStats renderStats;
+	RenderStats lastFrameStats;
+
+	//Sound related items, sounds are indexed by SoundId and point into the archive. The mixer is owned by main.cpp, which
+	//streams what it mixes to the sound device.
 	IDirectSound8* directSound;
 	IDirectSoundBuffer* primaryBuffer;
-	SoundHandle backgroundMusic[NUM_BACKGROUNDS];
-	SoundHandle introMusic;
-	SoundHandle spaceShipMoveSound;
-	SoundHandle missileFireSound;
-	SoundHandle missileHitSound;
-
-	LevelState levelState;
+	MixerSound sounds[SoundCount];
+	AudioMixer* mixer;
 
-	string planetNames[NUM_PLANET_TYPES] = { "Flarvis 5OW", "Sporia QR5", "Anides", "Saturn", "Earth", "Zumia", "Neptune", "Pluto", "Kestoia", "Xaglara" };
+	//Textures, sprites are indexed by SpriteId. Most sprites are regions of the atlas pages.
+	SpriteRegion sprites[SpriteCount];
 	TextureHandle backgrounds[NUM_BACKGROUNDS];
-	TextureHandle planetTextures[NUM_PLANET_TYPES];
-	size_t backgroundIndex;
+	std::vector<TextureHandle> atlasPages;
 
-	//Ship textures
-	TextureHandle playerTexture;
-	TextureHandle enemyTextures[2];
-	TextureHandle bossTextures[3];
+	//One slice per planet type, in the order of the planet sprite identifiers
+	TextureHandle planetTextures;
 
-	//Rocket textures
-	TextureHandle playerRocketTextures[3]; 
-	TextureHandle enemyRocketTextures[4];
-	TextureHandle explosionTexture;
+	//HUD textures
+	SpriteRegion energyIcon;
+	SpriteRegion scienceIcon;
+	SpriteRegion abilityIcons[4];
+	TextureHandle introBackground;
+	TextureHandle introLogo;
 
-	std::vector<Planet*> planets;
-	std::vector<Rocket*> instantiatedRockets;
+	//Whether the assets above have been loaded, they are kept when the game restarts
+	bool assetsLoaded;
 
-	int scienceGathered;
+	//Set by -serialload, the assets are paged in on the device thread alone so startup can be timed against the workers
+	bool serialLoad;
 
-	Ship* player;
-	std::vector<Ship*> enemies;
+	//Frame time that has not been simulated yet, always less than one step after a frame
+	float accumulator;
 
-	Vector2 enemySpawnpoints[3];
+	//Clicks seen on frames that ran no steps, handed to the next step so they are not lost
+	bool pendingClickL;
+	bool pendingClickR;
 
-	//Planet info
-	Planet* currentPlanet;
-	XMFLOAT3 currentPlanetLastPos;
-	bool nearPlanet;
-	bool visitingPlanet;
-	int currentSector;
-	
-	int screenWidth;
-	int screenHeight;
-	int tileWidth;
-	int tileHeight;
-
-	//Whether this game state has been initialized
-	bool started;
-	bool initialized;
+	//The SimulationRandom seed, and the recording of every step when the game is run with -record <file>
+	uint32_t seed;
+	const char* recordFileName;
+	InputRecorder recorder;
+
+	//The frame profiler, kept across reloads of the game code. F9 asks for its trace to be written.
+	Profiler* profiler;
+	bool traceRequested;
+
+	GameState state;
+};
+
+//A sprite of the atlas in the archive and the region to store where it is
+struct AtlasEntry
+{
+	SpriteRegion* region;
+	char* name;
+	const ArchiveEntry* entry;
 };
 
-//Game related prototypes
-void RunStartGame(Input input, GameState* gameState, ID3D11DeviceContext* deviceContext, ID3D11Device* device);
-void RunExplorationScene(Input input, GameState* gameState, ID3D11DeviceContext* deviceContext, ID3D11Device* device);
-void RunDiscoveryScene(Input input, GameState* gameState, ID3D11DeviceContext* deviceContext);
-void RunGameOverScene(Input input, GameState* gameState);
-bool CheckCollision(int x1, int y1, int width1, int height1, int x2, int y2, int width2, int height2);
+//A texture of its own in the archive and the handle to create it into
+struct TextureLoad
+{
+	TextureHandle* texture;
+	char* name;
 
-//Level related prototypes
-void InitializeSectorBattle(GameState* gameState);
-void GenerateLevel(GameState* gameState, ID3D11DeviceContext* deviceContext, ID3D11Device* device);
+	const ArchiveEntry* entry;
+};
+
+//A sound in the archive and where to keep it for the mixer
+struct SoundLoad
+{
+	MixerSound* sound;
+	char* name;
+
+	const ArchiveEntry* entry;
+};
 
 //Drawing related prototypes
-void OverwriteGPUShaderMatrices(ID3D11DeviceContext* deviceContext, ID3D11Buffer* matrixBuffer, MatrixBufferType* matrices);
-void DrawTexture2D(ID3D11DeviceContext* deviceContext, GameState* gameState, TextureHandle texture, int x, int y, int width, int height, int zOrder, float angle = 0.0f);
-void DrawModel(ID3D11DeviceContext* deviceContext, DXBuffer* vertexBuffer, TextureHandle texture);
+void OverwriteGPUShaderMatrices(ID3D11DeviceContext* deviceContext, ID3D11Buffer* constantBuffer, const XMMATRIX* matrices, int matrixCount);
+void ExecuteAudioCommands(GameMemory* gameMemory);
+void ExecuteRenderCommands(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, float alpha);
+void LoadAssets(ID3D11Device* device, ID3D11DeviceContext* deviceContext, GameMemory* gameMemory);
+DXBuffer CreateMeshBuffer(ID3D11Device* device, const MeshData& mesh);
+const ArchiveEntry* FindAsset(const AssetArchive* archive, char* name, AssetType type, std::string* missing);
+void LoadAtlasSprites(ID3D11Device* device, ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, AtlasEntry* entries, int entryCount, const std::vector<const ArchiveEntry*>& pages);
+void DrawTexture2D(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, const SpriteRegion& region, float x, float y, float width, float height, int zOrder, float angle = 0.0f);
+bool FlushSprites(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory);
+bool FlushPlanets(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory);
+void DrawHUDText(GameMemory* gameMemory);
+XMMATRIX PlanetWorldMatrix(const RenderCommand& command);
 
 //1. Define a macro for the definition of the GameUpdateAndRender function pointer.
 //2. Create an extern "C" variable for the GameUpdateAndRender function pointer.
 //3. Define the type as game_update_and_render
-#define GAME_UPDATE_AND_RENDER(name) void name(GameState* gameState, ID3D11DeviceContext* deviceContext, ID3D11Device* device, ID3D11RenderTargetView* renderTargetView, ID3D11DepthStencilView* depthStencilView, int bufferWidth, int bufferHeight, Input input)
+#define GAME_UPDATE_AND_RENDER(name) void name(GameMemory* gameMemory, ID3D11DeviceContext* deviceContext, ID3D11Device* device, ID3D11RenderTargetView* renderTargetView, ID3D11DepthStencilView* depthStencilView, int bufferWidth, int bufferHeight, Input input, float frameTime)
 extern "C" GAME_UPDATE_AND_RENDER(GameUpdateAndRender);
 typedef GAME_UPDATE_AND_RENDER(_GameUpdateAndRender);
\ No newline at end of file
@@ -0,0 +1,36 @@
+/*
+File Name:		Grid.h
+Description:	This file holds the definition of the uniform grid used as a broadphase for rocket collisions. Ships are stored
+				in every tile their bounding box overlaps, so a rocket only has to be tested against the ships near it.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <vector>
+#include "Ship.h"
+
+class ShipGrid
+{
+public:
+	int tilesX;
+	int tilesY;
+	float tileWidth;
+	float tileHeight;
+
+	//Ships in each tile, row major
+	std::vector<std::vector<Ship*>> tiles;
+
+	//Reused between queries so a query never allocates once it has warmed up
+	std::vector<Ship*> results;
+
+	void Initialize(int tilesX, int tilesY, float tileWidth, float tileHeight);
+	void Clear();
+	void Update(Ship* ship);
+	void Remove(Ship* ship);
+	std::vector<Ship*>& Query(float x, float y, float width, float height);
+
+private:
+	void TileRange(float x, float y, float width, float height, int* minX, int* minY, int* maxX, int* maxY);
+};
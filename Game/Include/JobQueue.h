@@ -0,0 +1,25 @@
+/*
+File Name:		JobQueue.h
+Description:	This file holds a small job queue. Jobs are added on one thread and then run on a set of worker threads,
+				the thread that runs the queue waits until every job has finished. Jobs must not touch D3D11 or DirectSound.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <vector>
+#include <functional>
+
+class JobQueue
+{
+public:
+	std::vector<std::function<void()>> jobs;
+
+	//The most threads Run uses, 0 for one per hardware thread
+	int maxThreads;
+
+	JobQueue(int maxThreads = 0);
+	void Add(std::function<void()> job);
+	void Run();
+};
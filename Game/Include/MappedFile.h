@@ -0,0 +1,42 @@
+/*
+File Name:		MappedFile.h
+Description:	This file holds a read-only memory-mapped file. Loaders parse assets straight out of the mapping instead of reading
+				them into a heap buffer first, so the only copy made is into the GPU texture or the sound buffer. Uses file
+				mapping on Windows and mmap everywhere else.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stddef.h>
+
+//Smallest page size of the platforms we run on, touching every 4KB touches every page
+#define MAPPED_FILE_PAGE_SIZE 4096
+
+class MappedFile
+{
+public:
+	const unsigned char* data;
+	size_t size;
+
+	MappedFile();
+	~MappedFile();
+
+	bool Open(const char* fileName);
+	void Close();
+	void Touch() const;
+	void Touch(size_t offset, size_t size) const;
+
+private:
+#if defined(_WIN32)
+	void* fileHandle;
+	void* mappingHandle;
+#else
+	int fileDescriptor;
+#endif
+
+	//A mapping has one owner, it is unmapped when that owner closes it
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+};
@@ -0,0 +1,60 @@
+/*
+File Name:		Mesh.h
+Description:	This file holds the binary mesh format. A mesh is a small header followed by the interleaved vertices exactly as
+				the vertex buffer holds them, then the indices if it has any. The asset packer converts the obj models into it,
+				so the game creates its buffers straight from the archive without parsing anything. The packer also welds the
+				vertices and orders the triangles for the post-transform vertex cache. Nothing in here depends on D3D11 or Assimp.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#define MESH_MAGIC 0x4853454D	//"MESH" read as a little endian integer
+#define MESH_VERSION 1
+
+//Post-transform cache size the triangle order is tuned for. GPUs have at least this many entries, so the order still helps
+//on bigger caches.
+#define MESH_CACHE_SIZE 16
+
+//Same layout as VertexType, which the vertex shader reads
+struct MeshVertex
+{
+	float x;
+	float y;
+	float z;
+	float u;
+	float v;
+};
+
+struct MeshHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t vertexCount;
+
+	//0 when the vertices are drawn as a plain triangle list
+	uint32_t indexCount;
+};
+
+//A mesh read in place, the pointers are into the data it was read from
+struct MeshData
+{
+	const MeshVertex* vertices;
+	uint32_t vertexCount;
+	const uint32_t* indices;
+	uint32_t indexCount;
+};
+
+bool ReadMesh(const unsigned char* data, size_t size, MeshData* mesh);
+void WriteMesh(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices, std::vector<unsigned char>* bytes);
+
+//Optimization prototypes
+void WeldMesh(const std::vector<MeshVertex>& triangles, std::vector<MeshVertex>* vertices, std::vector<uint32_t>* indices);
+void OptimizeVertexCache(std::vector<uint32_t>* indices, uint32_t vertexCount, int cacheSize);
+void OptimizeVertexFetch(std::vector<MeshVertex>* vertices, std::vector<uint32_t>* indices);
+float MeshACMR(const std::vector<uint32_t>& indices, uint32_t vertexCount, int cacheSize);
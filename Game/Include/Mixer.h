@@ -0,0 +1,129 @@
+/*
+File Name:		Mixer.h
+Description:	This file holds the software audio mixer. Every sound plays on one of a fixed pool of voices, and the voices are
+				mixed into a single 44.1kHz 16bit stereo stream, so a sound can overlap copies of itself and a burst of
+				explosions costs one mix pass rather than a sound buffer each. Where the stream goes is up to an audio backend:
+				DirectSound in the game, or a wave file, or nowhere, for tools and tests that run without a sound device.
+				Sounds are either 16 bit samples or IMA ADPCM blocks, which every voice decodes a block at a time as it reaches
+				them, so a compressed sound is never decoded whole. Nothing in here depends on DirectSound.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <mutex>
+#include <vector>
+
+#include "Commands.h"
+#include "Archive.h"
+#include "Adpcm.h"
+
+//The format of every sound and of the mixed stream
+#define MIXER_SAMPLE_RATE 44100
+#define MIXER_CHANNELS 2
+
+//Voices that can play at once. Past this a new sound takes the voice of the oldest one that does not loop.
+#define MIXER_MAX_VOICES 32
+
+//Frames mixed in one pass, longer requests are mixed in several
+#define MIXER_BLOCK_FRAMES 1024
+
+//Voice positions are 32.32 fixed point frames, so this is a step of one frame per frame
+#define MIXER_UNIT_STEP (1ull << 32)
+
+//Sounds quieter than this on both sides, -60dB, are not given a voice at all
+#define MIXER_AUDIBLE_GAIN 0.001f
+
+//Where positional sounds start to fade and where they are gone, as fractions of the screen diagonal from the player
+#define SPATIAL_NEAR 0.1f
+#define SPATIAL_FAR 0.9f
+
+//How the frames of a sound are stored
+enum MixerEncoding
+{
+	MixerPCM16,
+	MixerADPCM
+};
+
+//A sound to play, 44.1kHz stereo frames that have to outlive every voice playing them
+struct MixerSound
+{
+	const void* data;
+	uint32_t frameCount;
+	MixerEncoding encoding;
+};
+
+//One sound playing. A voice with no data is free.
+struct MixerVoice
+{
+	MixerSound sound;
+	uint64_t position;
+	uint64_t step;
+	float gainLeft;
+	float gainRight;
+	bool looping;
+
+	//Who asked for the voice, stopping a tag stops every voice with it, and when it started, to find the oldest
+	int tag;
+	uint32_t started;
+
+	//The ADPCM block decoded last, the voice decodes the next one when its position leaves it
+	uint32_t decodedBlock;
+	int16_t decoded[ADPCM_BLOCK_FRAMES * MIXER_CHANNELS];
+};
+
+class AudioMixer
+{
+public:
+	MixerVoice voices[MIXER_MAX_VOICES];
+	uint32_t playCount;
+
+	//Held by the game while it starts and stops voices, and by the backend while it mixes
+	std::mutex lock;
+
+	alignas(16) float accumulator[MIXER_BLOCK_FRAMES * MIXER_CHANNELS];
+
+	void Initialize();
+	int Play(const MixerSound& sound, float gainLeft, float gainRight, float pitch, bool looping, int tag, int tagLimit = 0);
+	void Stop(int tag);
+	bool IsPlaying(int tag);
+	void Mix(int16_t* output, int frameCount);
+
+	void MixVoice(MixerVoice* voice, float* output, int frameCount);
+	const int16_t* VoiceFrames(MixerVoice* voice, uint32_t frame, uint32_t* spanStart, uint32_t* spanEnd);
+	void FrameAfter(MixerVoice* voice, uint32_t spanEnd, int16_t* output);
+};
+
+//Where the mixed stream goes. A backend pulls from the mixer at the pace of its output.
+class AudioBackend
+{
+public:
+	virtual ~AudioBackend() {}
+	virtual bool Start(AudioMixer* mixer) = 0;
+	virtual void Stop() = 0;
+};
+
+//Writes the mixed stream to a wave file, or throws it away when there is no file name. Nothing plays in real time, the
+//stream only moves when Render is called, so a headless run can mix exactly the frames each step covers.
+class WaveWriterBackend : public AudioBackend
+{
+public:
+	const char* fileName;
+	FILE* file;
+	AudioMixer* mixer;
+	uint32_t framesWritten;
+
+	WaveWriterBackend(const char* fileName);
+	bool Start(AudioMixer* mixer);
+	void Stop();
+	void Render(int frameCount);
+};
+
+//Mixer prototypes
+float VolumeToGain(long volume);
+void SpatialGains(Vector2 offset, float screenWidth, float screenHeight, float* left, float* right);
+MixerSound MixerSoundFromAsset(const AssetArchive* archive, const ArchiveEntry* entry);
+void PlayAudioCommands(AudioMixer* mixer, const MixerSound* sounds, const std::vector<AudioCommand>& commands, float screenWidth, float screenHeight);
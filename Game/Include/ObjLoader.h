@@ -1,72 +1,54 @@
 /*
 File Name:		ObjLoader.h
-Description:	This file handles loading vertex buffers from obj files. It parses the obj and returns the vertex buffer.
+Description:	This file handles reading the vertices of obj files with Assimp. Only the asset packer uses it, it converts the
+				models into the binary mesh format so the game itself never loads Assimp.
 Programmer:		Kyle Jensen
 Date:			April 14, 2017
 */
 
 #pragma once
-#include "Platform.h"
+
+#include <vector>
+
+#include "assimp/Importer.hpp"
+#include "assimp/scene.h"
+#include "assimp/postprocess.h"
+
+#include "Mesh.h"
 
 class ObjLoader
 {
 public:
 
-	//Function: VertexBufferFromObj()
-	//Description: This method gives us a vertex buffer from an Obj file. It uses the Assimp library to load Obj data into
-	//				structures that we can load into our vertices array. It takes the vertex point and texture coordinate for each
-	//				vertice and adds them to the vertex buffer.
-	//Returns: DXBuffer = The vertex buffer.
-	static DXBuffer VertexBufferFromObj(ID3D11Device* device, char* filename)
+	//Function: VerticesFromObj()
+	//Description: This method uses the Assimp library to load Obj data into structures that we can load into our vertices array.
+	//				It takes the vertex point and texture coordinate for each vertice of the first mesh. Meshes without texture
+	//				coordinates get zeros.
+	//Returns: bool = whether the obj had a mesh to read.
+	static bool VerticesFromObj(const char* filename, std::vector<MeshVertex>* vertices)
 	{
-		DXBuffer vertexBuffer;
+		Assimp::Importer importer;
+		const aiScene* scene = importer.ReadFile(filename, aiProcess_Triangulate);
+		if (!scene || scene->mNumMeshes == 0)
+			return false;
 
 		// TODO: just mesh not spheremesh
-		DXBuffer* sphereVertexBuffer = &vertexBuffer;
-
-		VertexType* vertices;
-		D3D11_BUFFER_DESC vertexBufferDesc;
-		D3D11_SUBRESOURCE_DATA vertexData;
-
-		Importer importer;
-		const aiScene* scene = importer.ReadFile(filename, aiProcess_Triangulate);
 		aiMesh* sphereMesh = scene->mMeshes[0];
+		bool textured = sphereMesh->HasTextureCoords(0);
 
-		sphereVertexBuffer->size = sphereMesh->mNumVertices;
-
-		//Loop through all vertices and copy over the vertex and texture coord information to the vertex buffer
-		vertices = new VertexType[sphereVertexBuffer->size];
-		for (int i = 0; i < sphereVertexBuffer->size; i++)
+		//Loop through all vertices and copy over the vertex and texture coord information
+		vertices->resize(sphereMesh->mNumVertices);
+		for (unsigned int i = 0; i < sphereMesh->mNumVertices; i++)
 		{
-			XMFLOAT3 vertex = XMFLOAT3{ sphereMesh->mVertices[i].x, sphereMesh->mVertices[i].y, sphereMesh->mVertices[i].z };
-			XMFLOAT2 textureCoord = XMFLOAT2{ sphereMesh->mTextureCoords[0][i].x, sphereMesh->mTextureCoords[0][i].y };
-			vertices[i].position = vertex;
-			vertices[i].texture = textureCoord;
+			MeshVertex& vertex = (*vertices)[i];
+			vertex.x = sphereMesh->mVertices[i].x;
+			vertex.y = sphereMesh->mVertices[i].y;
+			vertex.z = sphereMesh->mVertices[i].z;
+			vertex.u = textured ? sphereMesh->mTextureCoords[0][i].x : 0.0f;
+			vertex.v = textured ? sphereMesh->mTextureCoords[0][i].y : 0.0f;
 		}
 
-		// Set up the description of the static vertex buffer.
-		vertexBufferDesc.Usage = D3D11_USAGE_DEFAULT;
-		vertexBufferDesc.ByteWidth = sizeof(VertexType) * sphereVertexBuffer->size;
-		vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-		vertexBufferDesc.CPUAccessFlags = 0;
-		vertexBufferDesc.MiscFlags = 0;
-		vertexBufferDesc.StructureByteStride = 0;
-
-		// Give the subresource structure a pointer to the vertex data.
-		vertexData.pSysMem = vertices;
-		vertexData.SysMemPitch = 0;
-		vertexData.SysMemSlicePitch = 0;
-
-		// Now create the vertex buffer.
-		device->CreateBuffer(&vertexBufferDesc, &vertexData, &sphereVertexBuffer->data);
-
-		//End model definition
-
-		// Release the arrays now that the vertex and index buffers have been created and loaded.
-		delete[] vertices;
-		vertices = 0;
-
-		return vertexBuffer;
+		return true;
 	}
 
-};
\ No newline at end of file
+};
@@ -7,18 +7,17 @@ Date:			March 24, 2016
 
 #pragma once
 
-#include "Platform.h"
-#include "Texture.h"
-#include <D3Dcompiler.h>
-#include <DirectXMath.h>
+#include "Commands.h"
+#include "Vector.h"
+#include <string>
 
 #define BLACK_HOLE_INDEX 10
 
 class Planet
 {
 public:
-	XMFLOAT3 position;
-	XMFLOAT3 rotationAxis;
+	Vector3 position;
+	Vector3 rotationAxis;
 
 	float angle;
 	float rotationSpeed;
@@ -30,13 +29,12 @@ public:
 
 	int energy;
 	int science;
-	string name;
+	std::string name;
 
-	TextureHandle texture;
+	SpriteId texture;
 
-	Planet(ID3D11Device* device, ID3D11DeviceContext* deviceContext, float speed, XMFLOAT3 position, TextureHandle texture);
+	Planet(float speed, Vector3 position, SpriteId texture);
 
 	void Update(float timeElapsed);
-	void SetPosition(MatrixBufferType* perspectiveMatrices);
 };
 
@@ -0,0 +1,43 @@
+/*
+File Name:		PlanetRenderer.h
+Description:	This file holds the instanced planet renderer. Planets pushed during the frame are collected into one dynamic
+				instance buffer and drawn with one DrawInstanced of the sphere mesh, each instance carries its world matrix and
+				the slice of the planet texture array it is wrapped in.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include "Platform.h"
+#include "Texture.h"
+#include "SpriteRenderer.h"
+
+//The most planets the instance buffer holds. Bigger batches are drawn in several passes.
+#define MAX_PLANET_INSTANCES 256
+
+//Per-instance data for texture.vs, matches the TEXCOORD1 to TEXCOORD5 elements of the planet input layout
+struct PlanetInstance
+{
+	XMFLOAT4X4 world;		//World matrix rows, not transposed since instance data is not packed like a constant buffer
+	float slice;			//Slice of the planet texture array
+};
+
+class PlanetRenderer
+{
+public:
+	ID3D11Buffer* instanceBuffer;
+	ID3D11VertexShader* vertexShader;
+	ID3D11PixelShader* pixelShader;
+	ID3D11InputLayout* layout;
+
+	//Instances written to the buffer since it was last discarded
+	int bufferUsed;
+
+	//Planets pushed since the last flush, in the order they were pushed
+	std::vector<PlanetInstance> instances;
+
+	bool Initialize(ID3D11Device* device);
+	void Push(const XMMATRIX& world, int slice);
+	void Flush(RenderStateCache* renderState, DXBuffer* sphereVertexBuffer, TextureHandle planetTextures, RenderStats* stats);
+};
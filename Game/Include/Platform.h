@@ -30,17 +30,12 @@ Date:			March 24, 2016
 #include <time.h>
 #include <string>
 
-#include "assimp/Importer.hpp"
-#include "assimp/scene.h"
-#include "assimp/postprocess.h"
-
 //#include "SpriteBatch.h"
 //#include "SpriteFont.h"
 //#include "SimpleMath.h"
 
 using namespace std;
 using namespace DirectX;
-using namespace Assimp;
 
 
 
@@ -51,21 +46,21 @@ struct VertexType
 	XMFLOAT2 texture;
 };
 
-//Matrix buffer type for shaders
-union MatrixBufferType
+//Camera constant buffer type for shaders, register b0. It only changes when the screen size does.
+union CameraBufferType
 {
 	struct
 	{
-		XMMATRIX world;
 		XMMATRIX view;
 		XMMATRIX projection;
 	};
 
-	XMMATRIX array[3];
+	XMMATRIX array[2];
 };
 
 
-//Drawing buffer
+
+//Drawing buffer, a vertex buffer with an optional 32 bit index buffer
 struct DXBuffer
 {
 	unsigned int STRIDE = sizeof(VertexType);
@@ -74,9 +69,28 @@ struct DXBuffer
 	ID3D11Buffer* data;
 	int size;
 
+	ID3D11Buffer* indices;
+	int indexCount;
+
 	void Draw(ID3D11DeviceContext* deviceContext)
 	{
 		deviceContext->IASetVertexBuffers(0, 1, &data, &STRIDE, &OFFSET);
-		deviceContext->Draw(size, 0);
+		if (indices)
+		{
+			deviceContext->IASetIndexBuffer(indices, DXGI_FORMAT_R32_UINT, 0);
+			deviceContext->DrawIndexed(indexCount, 0, 0);
+		}
+		else
+		{
+			deviceContext->Draw(size, 0);
+		}
+	}
+
+	void DrawInstanced(ID3D11DeviceContext* deviceContext, int instanceCount, int firstInstance)
+	{
+		if (indices)
+			deviceContext->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, firstInstance);
+		else
+			deviceContext->DrawInstanced(size, instanceCount, 0, firstInstance);
 	}
 };
\ No newline at end of file
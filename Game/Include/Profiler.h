@@ -0,0 +1,166 @@
+/*
+File Name:		Profiler.h
+Description:	This file holds the frame profiler. PROFILE_SCOPE times the rest of the scope it is placed in with the time stamp
+				counter and writes the result to a ring buffer owned by the calling thread, so timing never takes a lock. Every
+				frame the scopes the main thread ran are summed into a millisecond breakdown for the HUD, and all the rings can be
+				written out as a Chrome trace, to be opened with chrome://tracing or Perfetto.
+				The profiler is compiled in with /DPROFILER_ENABLED=1. Without it PROFILE_SCOPE expands to nothing at all.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+
+//Events each thread keeps, the oldest are overwritten. A frame is a few dozen events, so this is several seconds of frames.
+#define PROFILE_RING_SIZE 16384
+
+//Threads that can record at once, events from threads past this are dropped
+#define PROFILE_MAX_THREADS 16
+
+//Scope names, and how many characters of each are kept
+#define PROFILE_MAX_NAMES 64
+#define PROFILE_NAME_LENGTH 32
+
+#if PROFILER_ENABLED
+	#define PROFILE_JOIN_(a, b) a##b
+	#define PROFILE_JOIN(a, b) PROFILE_JOIN_(a, b)
+
+	//The name is registered the first time the scope runs, after that a scope costs two time stamps and one store
+	#define PROFILE_SCOPE(name) static const int PROFILE_JOIN(profileName, __LINE__) = ProfilerRegister(name); \
+		ProfileScope PROFILE_JOIN(profileScope, __LINE__)(PROFILE_JOIN(profileName, __LINE__))
+#else
+	#define PROFILE_SCOPE(name)
+#endif
+
+//A timed scope. The start and end are in ticks, depth is how many scopes it was nested in.
+struct ProfileEvent
+{
+	uint64_t start;
+	uint64_t end;
+	int32_t name;
+	int32_t depth;
+};
+
+//The events of one thread. Only the owner writes to it, readers take the events written before they read the count.
+struct ProfileRing
+{
+	//Hash of the id of the owning thread, 0 while the ring is free
+	std::atomic<uint64_t> owner;
+
+	//Events ever written, the newest is at (written - 1) % PROFILE_RING_SIZE
+	std::atomic<uint32_t> written;
+
+	int32_t depth;
+	ProfileEvent events[PROFILE_RING_SIZE];
+};
+
+//The time spent in one scope name over a frame
+struct ProfileTotal
+{
+	int calls;
+	double milliseconds;
+};
+
+class Profiler
+{
+public:
+	ProfileRing rings[PROFILE_MAX_THREADS];
+
+	char names[PROFILE_MAX_NAMES][PROFILE_NAME_LENGTH];
+	std::atomic<int> nameCount;
+	std::mutex nameLock;
+
+	//The time stamp counter and the wall clock when the profiler started, ticks are turned into seconds by comparing the two
+	uint64_t startTicks;
+	double startSeconds;
+	double ticksPerSecond;
+
+	//When the current frame started, and what the main thread spent in each scope name over the last one
+	uint64_t frameStart;
+	double frameMilliseconds;
+	ProfileTotal frameTotals[PROFILE_MAX_NAMES];
+
+	void Initialize();
+	void Frame();
+	bool WriteTrace(const char* fileName);
+	double Milliseconds(uint64_t ticks) const;
+};
+
+//The profiler the scopes record into, 0 when there is none
+extern Profiler* globalProfiler;
+
+//Profiler prototypes
+int ProfilerRegister(const char* name);
+ProfileRing* ProfilerThreadRing();
+
+
+//Function: ProfilerTicks()
+//Description: This method reads the time stamp counter, which runs at a constant rate on every CPU we ship on. Other CPUs use
+//the steady clock.
+//Returns: uint64_t = the current tick.
+inline uint64_t ProfilerTicks()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+
+//Times the scope it is declared in, from its construction to its destruction
+class ProfileScope
+{
+public:
+	ProfileRing* ring;
+	int32_t name;
+	uint64_t start;
+
+	//Function: ProfileScope(int name)
+	//Description: This method starts timing a scope on the ring of the calling thread.
+	//Returns: n/a.
+	ProfileScope(int name)
+	{
+		this->ring = (name >= 0) ? ProfilerThreadRing() : 0;
+		this->name = name;
+		if (this->ring)
+		{
+			this->ring->depth++;
+		}
+		this->start = ProfilerTicks();
+	}
+
+	//Function: ~ProfileScope()
+	//Description: This method writes the timed scope to the ring, overwriting the oldest event once the ring is full.
+	//Returns: n/a.
+	~ProfileScope()
+	{
+		uint64_t end = ProfilerTicks();
+		if (!this->ring)
+			return;
+
+		this->ring->depth--;
+		uint32_t index = this->ring->written.load(std::memory_order_relaxed);
+		ProfileEvent& event = this->ring->events[index % PROFILE_RING_SIZE];
+		event.start = this->start;
+		event.end = end;
+		event.name = this->name;
+		event.depth = this->ring->depth;
+		this->ring->written.store(index + 1, std::memory_order_release);
+	}
+};
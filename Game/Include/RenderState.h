@@ -0,0 +1,69 @@
+/*
+File Name:		RenderState.h
+Description:	This file holds a small cache of the pipeline state bound on the device context. Binds go through it, and a bind of
+				what is already bound is skipped instead of reaching the driver. Anything that binds state behind its back, like
+				the DirectXTK sprite batch, makes it forget what it knows.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include "Platform.h"
+
+//Slots the cache tracks for constant buffers, shader resources and vertex buffers
+#define RENDER_STATE_SLOTS 4
+
+//Single pieces of state the cache tracks, as bits of RenderStateCache::known
+enum RenderStateBit
+{
+	StateVertexShader = 1 << 0,
+	StatePixelShader = 1 << 1,
+	StateInputLayout = 1 << 2,
+	StateTopology = 1 << 3,
+	StateRasterizer = 1 << 4,
+	StateBlend = 1 << 5,
+	StateIndexBuffer = 1 << 6
+};
+
+class RenderStateCache
+{
+public:
+	ID3D11DeviceContext* deviceContext;
+
+	//What is bound. Only the state whose bit is set in the known masks is trusted, the rest is bound on its next set.
+	unsigned int known;
+	unsigned int knownConstantBuffers;
+	unsigned int knownResources;
+	unsigned int knownVertexBuffers;
+
+	ID3D11VertexShader* vertexShader;
+	ID3D11PixelShader* pixelShader;
+	ID3D11InputLayout* layout;
+	D3D11_PRIMITIVE_TOPOLOGY topology;
+	ID3D11RasterizerState* rasterState;
+	ID3D11BlendState* blendState;
+	ID3D11Buffer* indexBuffer;
+	ID3D11Buffer* constantBuffers[RENDER_STATE_SLOTS];
+	ID3D11ShaderResourceView* resources[RENDER_STATE_SLOTS];
+	ID3D11Buffer* vertexBuffers[RENDER_STATE_SLOTS];
+	UINT vertexStrides[RENDER_STATE_SLOTS];
+
+	//Binds sent to the device context and binds skipped because the state was already bound, counted per frame
+	int bindsIssued;
+	int bindsSkipped;
+
+	void BeginFrame(ID3D11DeviceContext* deviceContext);
+	void Invalidate();
+
+	void SetVertexShader(ID3D11VertexShader* shader);
+	void SetPixelShader(ID3D11PixelShader* shader);
+	void SetInputLayout(ID3D11InputLayout* inputLayout);
+	void SetTopology(D3D11_PRIMITIVE_TOPOLOGY primitiveTopology);
+	void SetRasterizerState(ID3D11RasterizerState* state);
+	void SetBlendState(ID3D11BlendState* state);
+	void SetIndexBuffer(ID3D11Buffer* buffer);
+	void SetVSConstantBuffer(int slot, ID3D11Buffer* buffer);
+	void SetPSResource(int slot, ID3D11ShaderResourceView* resource);
+	void SetVertexBuffers(int count, ID3D11Buffer* const* buffers, const UINT* strides);
+};
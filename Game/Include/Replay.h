@@ -0,0 +1,83 @@
+/*
+File Name:		Replay.h
+Description:	This file holds input recording and replay. A recording is the SimulationRandom seed, the screen size and step
+				size, and then the input of every simulation step along with a hash of the game state after it. Fed back into the
+				simulation with the same seed the steps give the same states, so a recording is a repeatable workload, and the
+				hashes show the first step where a replay went a different way.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#include "Simulation.h"
+
+//"RPLY" read as a little endian integer
+#define REPLAY_MAGIC 0x594C5052
+#define REPLAY_VERSION 1
+
+//Bits of ReplayStep::buttons
+enum ReplayButton
+{
+	ReplayMouseDownL = 1 << 0,
+	ReplayMouseDownR = 1 << 1,
+	ReplayMouseClickedL = 1 << 2,
+	ReplayMouseClickedR = 1 << 3,
+	ReplayKey1 = 1 << 4,
+	ReplayKey2 = 1 << 5,
+	ReplayKey3 = 1 << 6,
+	ReplayKey4 = 1 << 7,
+	ReplayKeyE = 1 << 8,
+	ReplayEnter = 1 << 9
+};
+
+//The start of a recording. The steps follow it until the end of the file.
+struct ReplayHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t seed;
+	int32_t screenWidth;
+	int32_t screenHeight;
+	float dt;
+};
+
+//The input of one step and the hash of the state it left, 10 bytes in the file
+#pragma pack(push, 1)
+struct ReplayStep
+{
+	uint16_t buttons;
+	int16_t mouseX;
+	int16_t mouseY;
+	uint32_t stateHash;
+};
+#pragma pack(pop)
+
+//A recording read back in full
+struct Replay
+{
+	ReplayHeader header;
+	std::vector<ReplayStep> steps;
+};
+
+//Appends steps to a recording as the game runs
+class InputRecorder
+{
+public:
+	FILE* file;
+	uint32_t stepCount;
+
+	bool Begin(const char* fileName, uint32_t seed, int screenWidth, int screenHeight, float dt);
+	void Record(const Input& input, uint32_t stateHash);
+	void End();
+};
+
+//Replay related prototypes
+ReplayStep PackInput(const Input& input);
+Input UnpackInput(const ReplayStep& step);
+bool LoadReplay(const char* fileName, Replay* replay);
+uint32_t HashGameState(const GameState& gameState);
@@ -1,29 +1,133 @@
 /*
 File Name:		Rocket.h
-Description:	This file holds the definition for a rocket and the methods to move the rocket
+Description:	This file holds the definition for the rocket pool and the methods to fire, move and remove rockets. Rockets are
+				stored as a structure of arrays with a fixed capacity, so firing and removing them never touches the heap.
+				The capacity is a template parameter so the rocket benchmark can build pools far bigger than the game's, the
+				methods live here with the class for the same reason.
 Programmer:		Kyle Jensen
 Date:			March 24, 2016
 */
 
-#include "platform.h"
-#include "Texture.h"
+#pragma once
+
+#include "Commands.h"
 #include "Vector.h"
+#include "Clock.h"
+
+//The most rockets that can be alive at once in the game. Rockets fired while the pool is full are dropped.
+#define MAX_ROCKETS 2048
 
-class Rocket
+template <int Capacity>
+class FixedRocketPool
 {
 public:
-	float speed;
-	int damage;
-	Vector2 position;
-	Vector2 size;
-	Vector2 direction;
-	float angle;
-	TextureHandle texture;
-
-	bool exploded;
-	time_t explosionTime;
-	int shooter;
-
-	Rocket(Vector2 position, Vector2 size, Vector2 direction, TextureHandle texture, float speed, int damage);
+	//Rockets [0, count) are alive, the slots after them are free
+	int count;
+
+	Vector2 position[Capacity];
+	Vector2 previousPosition[Capacity];
+	Vector2 direction[Capacity];
+	float speed[Capacity];
+	int damage[Capacity];
+	int shooter[Capacity];
+	GameTime explosionTime[Capacity];
+	bool exploded[Capacity];
+
+	Vector2 size[Capacity];
+	float angle[Capacity];
+	SpriteId texture[Capacity];
+
+	int Fire(Vector2 position, Vector2 size, Vector2 direction, SpriteId texture, float speed, int damage, int shooter = 0);
+	void Remove(int index);
+	void Clear();
 	void MoveInDirection(float timeElapsed);
-};
\ No newline at end of file
+};
+
+//The pool the game state holds
+typedef FixedRocketPool<MAX_ROCKETS> RocketPool;
+
+
+//Function: Fire(Vector2 position, Vector2 size, Vector2 direction, SpriteId texture, float speed, int damage, int shooter)
+//Description: This method takes the first free slot in the pool and initializes a rocket in it. The rocket is rotated in the
+//direction it is fired once here, since its direction never changes afterwards.
+//Returns: int = the index of the rocket, or -1 if the pool is full.
+template <int Capacity>
+int FixedRocketPool<Capacity>::Fire(Vector2 position, Vector2 size, Vector2 direction, SpriteId texture, float speed, int damage, int shooter)
+{
+	if (this->count == Capacity)
+		return -1;
+
+	int index = this->count++;
+	this->position[index] = position;
+	this->previousPosition[index] = position;
+	this->size[index] = size;
+	this->direction[index] = direction;
+	this->texture[index] = texture;
+	this->speed[index] = speed;
+	this->damage[index] = damage;
+	this->shooter[index] = shooter;
+	this->exploded[index] = false;
+	this->explosionTime[index] = 0;
+
+	// Dot product is always the smallest angle between 2 vectors, so when we want a value greater than PI
+	// we must subtract the smaller angle from 2*PI to get it's reflection
+	this->angle[index] = acos(DotProduct(Vector2{ 1.0f, 0.0f }, direction));
+	if (direction.y < 0)
+	{
+		this->angle[index] = 2 * VECTOR_PI - this->angle[index];
+	}
+
+	return index;
+}
+
+
+//Function: Remove(int index)
+//Description: This method removes a rocket by moving the last rocket in the pool into its slot.
+//Callers iterating the pool must revisit index after removing it.
+//Returns: void.
+template <int Capacity>
+void FixedRocketPool<Capacity>::Remove(int index)
+{
+	int last = --this->count;
+	if (index == last)
+		return;
+
+	this->position[index] = this->position[last];
+	this->previousPosition[index] = this->previousPosition[last];
+	this->size[index] = this->size[last];
+	this->direction[index] = this->direction[last];
+	this->texture[index] = this->texture[last];
+	this->speed[index] = this->speed[last];
+	this->damage[index] = this->damage[last];
+	this->shooter[index] = this->shooter[last];
+	this->exploded[index] = this->exploded[last];
+	this->explosionTime[index] = this->explosionTime[last];
+	this->angle[index] = this->angle[last];
+}
+
+
+//Function: Clear()
+//Description: This method removes every rocket from the pool.
+//Returns: void.
+template <int Capacity>
+void FixedRocketPool<Capacity>::Clear()
+{
+	this->count = 0;
+}
+
+
+//Function: MoveInDirection(float timeElapsed)
+//Description: This method moves every rocket that hasnt exploded in the direction it was fired, remembering where it started
+//so the renderer can interpolate between steps.
+//Returns: void.
+template <int Capacity>
+void FixedRocketPool<Capacity>::MoveInDirection(float timeElapsed)
+{
+	for (int i = 0; i < this->count; i++)
+	{
+		this->previousPosition[i] = this->position[i];
+		float distance = this->exploded[i] ? 0.0f : this->speed[i] * timeElapsed;
+		this->position[i].x += this->direction[i].x * distance;
+		this->position[i].y += this->direction[i].y * distance;
+	}
+}
@@ -9,11 +9,10 @@ Date:			April 14, 2017
 #pragma once
 #pragma warning(disable:4244)
 
-#include "Texture.h"
+#include "Commands.h"
 #include "Vector.h"
 #include "Ability.h"
-#include <time.h>
-#include <DirectXMath.h>
+#include "Clock.h"
 
 #define SHIP_NEAR_THRESHOLD 2.0f
 #define SHIP_PLAYER_SPEED 100.0f
@@ -21,15 +20,14 @@ Date:			April 14, 2017
 #define SHIP_ENEMY_SPEEDBOOST 1.65f;
 #define NUM_ABILITIES 3
 
-using namespace DirectX;
-
 class Ship
 {
 public:
 	Vector2 position;
+	Vector2 previousPosition;
 	Vector2 size;
 	Vector2 destination;
-	TextureHandle texture;
+	SpriteId texture;
 	float speed;
 	float maxspeed;
 	float angle;
@@ -39,13 +37,20 @@ public:
 	int science;
 
 	Ability abilities[NUM_ABILITIES];
-	time_t abilityShotTime[NUM_ABILITIES];
+	GameTime abilityShotTime[NUM_ABILITIES];
 	bool boss;
 	bool spawnedMinions;
 	int cooldown;
-	time_t cooldown_time;
-	time_t last_heal;
+	GameTime cooldown_time;
+	GameTime last_heal;
+
+	//Range of broadphase grid tiles the ship is stored in
+	bool inGrid;
+	int gridMinX;
+	int gridMinY;
+	int gridMaxX;
+	int gridMaxY;
 
-	Ship(float speed, Vector2 startPosition, Vector2 size, TextureHandle texture, int energy, Ability abilities[NUM_ABILITIES]);
+	Ship(float speed, Vector2 startPosition, Vector2 size, SpriteId texture, int energy, Ability abilities[NUM_ABILITIES], GameTime now);
 	void MoveTowardDestination(float timeElapsed);
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+/*
+File Name:		Simulation.h
+Description:	This header file contains the renderer-free side of the game. The game state, the input it is driven by and
+				the simulation step that advances it live here. A step never touches D3D11 or DirectSound, it only emits render
+				and audio commands, so it can be run headless as fast as the CPU allows.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+
+#include "Commands.h"
+#include "Vector.h"
+#include "Ability.h"
+#include "Ship.h"
+#include "Planet.h"
+#include "Rocket.h"
+#include "Grid.h"
+#include "Collision.h"
+#include "Clock.h"
+
+#define TILE_SIZE 10
+#define MAX_PLANETS 10
+
+struct MouseInput
+{
+	bool downL;
+	bool downR;
+	bool clickedL;
+	bool clickedR;
+	int x;
+	int y;
+};
+
+struct Input
+{
+	MouseInput mouse;
+
+	bool key1;
+	bool key2;
+	bool key3;
+	bool key4;
+	bool keyE;
+	bool enter;
+};
+
+enum LevelState
+{
+	Start,
+	Exploration,
+	Discovery,
+	GameOver
+};
+
+
+struct GameState
+{
+	LevelState levelState;
+
+	//Simulation time, every cooldown and timer is measured against it
+	GameClock clock;
+
+	std::string planetNames[NUM_PLANET_TYPES] = { "Flarvis 5OW", "Sporia QR5", "Anides", "Saturn", "Earth", "Zumia", "Neptune", "Pluto", "Kestoia", "Xaglara" };
+	size_t backgroundIndex;
+
+	std::vector<Planet*> planets;
+	RocketPool rockets;
+
+	int scienceGathered;
+
+	Ship* player;
+	std::vector<Ship*> enemies;
+
+	//Broadphase for player rockets against enemies, laid out on the tile grid
+	ShipGrid enemyGrid;
+
+	//Packed boxes for the batched collision tests
+	BoxArray planetBoxes;
+	BoxArray nearbyEnemyBoxes;
+
+	Vector2 enemySpawnpoints[3];
+
+	//Planet info
+	Planet* currentPlanet;
+	Vector3 currentPlanetLastPos;
+	bool nearPlanet;
+	bool visitingPlanet;
+	int currentSector;
+
+	//Whether we tried to leave the sector with enemies still alive this step
+	bool displayLevelNotClear;
+
+	int screenWidth;
+	int screenHeight;
+	int tileWidth;
+	int tileHeight;
+
+	//Commands emitted by the last step, consumed by the platform layer
+	std::vector<RenderCommand> renderCommands;
+	std::vector<AudioCommand> audioCommands;
+
+	//Whether this game state has been initialized
+	bool started;
+	bool initialized;
+
+	//State of the level generator's random numbers, seeded once per run like rand was
+	uint32_t randomState;
+};
+
+//Simulation prototypes
+void SimulationStep(GameState& gameState, const Input& input, float dt);
+void InitializeGame(GameState* gameState);
+void ReleaseGame(GameState* gameState);
+void SeedSimulationRandom(GameState* gameState, uint32_t seed);
+int SimulationRandom(GameState* gameState);
+
+//Scene related prototypes
+void RunStartGame(Input input, GameState* gameState);
+void RunExplorationScene(Input input, GameState* gameState, float timeElapsed);
+void RunRockets(GameState* gameState, float timeElapsed);
+void RunDiscoveryScene(Input input, GameState* gameState, float timeElapsed);
+void RunGameOverScene(Input input, GameState* gameState);
+bool CheckCollision(float x1, float y1, float width1, float height1, float x2, float y2, float width2, float height2);
+
+//Level related prototypes
+void InitializeSectorBattle(GameState* gameState);
+void ClearPlanets(GameState* gameState);
+void GenerateLevel(GameState* gameState);
+
+//Command related prototypes
+void PushSprite(GameState* gameState, SpriteId sprite, float x, float y, float width, float height, int zOrder, float angle = 0.0f);
+void PushMovingSprite(GameState* gameState, SpriteId sprite, Vector2 previousCenter, Vector2 center, Vector2 size, int zOrder, float angle);
+void PushPlanet(GameState* gameState, Planet* planet);
+void PushAudio(GameState* gameState, AudioCommandType type, SoundId sound, long volume = 0);
+void PushAudioAt(GameState* gameState, AudioCommandType type, SoundId sound, long volume, Vector2 position);
@@ -0,0 +1,119 @@
+/*
+File Name:		SoftwareRenderer.h
+Description:	This file holds the software renderer, a CPU version of the texture.vs/texture.ps pipeline for machines with no GPU.
+				Triangles go through the same transforms as the shaders, then the screen is split into tiles and every tile is
+				rasterized on a worker thread. Coverage is tested 4 pixels at a time with exact integer edge functions, textures are
+				sampled bilinearly with clamping and every pixel is alpha blended. Frames can be written out as TGA files, so they
+				can be compared against golden images. Nothing in here depends on D3D11 or DirectXMath.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "Mesh.h"
+
+//Screen tiles are this many pixels on a side, each tile is one job
+#define SOFTWARE_TILE_SIZE 64
+
+//Vertex positions are snapped to 1/16 of a pixel, like the hardware does
+#define SOFTWARE_SUBPIXEL_BITS 4
+
+//Triangles reaching further than this many pixels off screen are dropped rather than clipped
+#define SOFTWARE_GUARD_BAND 8192.0f
+
+//A 4x4 matrix used with row vectors, laid out like XMMATRIX so the same products give the same transforms as the D3D11 path
+struct SoftwareMatrix
+{
+	float m[4][4];
+};
+
+//An RGBA texture stored top to bottom. The pixels are not owned, they usually point into the asset archive.
+struct SoftwareTexture
+{
+	int width;
+	int height;
+	const unsigned char* pixels;
+};
+
+//A vertex after the vertex shader: its clip space position and its texture coordinates
+struct ClipVertex
+{
+	float x;
+	float y;
+	float z;
+	float w;
+	float u;
+	float v;
+};
+
+//An attribute that varies linearly in screen space, value = c + dx * x + dy * y at a pixel center
+struct SoftwarePlane
+{
+	float c;
+	float dx;
+	float dy;
+};
+
+//A triangle set up for rasterizing. Positions are in subpixels with y going down, the attributes are divided by w so
+//they interpolate linearly in screen space.
+struct SoftwareTriangle
+{
+	int32_t x[3];
+	int32_t y[3];
+
+	//Pixels the triangle can touch, clamped to the screen
+	int minX;
+	int minY;
+	int maxX;
+	int maxY;
+
+	SoftwarePlane invW;
+	SoftwarePlane uOverW;
+	SoftwarePlane vOverW;
+
+	const SoftwareTexture* texture;
+};
+
+//Matrix prototypes, they match the DirectXMath functions of the same name
+SoftwareMatrix MatrixIdentity();
+SoftwareMatrix MatrixMultiply(const SoftwareMatrix& a, const SoftwareMatrix& b);
+SoftwareMatrix MatrixScaling(float x, float y, float z);
+SoftwareMatrix MatrixTranslation(float x, float y, float z);
+SoftwareMatrix MatrixRotationX(float angle);
+SoftwareMatrix MatrixRotationAxis(float x, float y, float z, float angle);
+SoftwareMatrix MatrixPerspectiveFovLH(float fieldOfView, float aspect, float nearZ, float farZ);
+SoftwareMatrix MatrixOrthographicLH(float width, float height, float nearZ, float farZ);
+
+class SoftwareRenderer
+{
+public:
+	int width;
+	int height;
+	int tilesX;
+	int tilesY;
+
+	//RGBA pixels stored top to bottom
+	std::vector<unsigned char> colorBuffer;
+
+	//Triangles queued since the last flush, and the ones that touch each tile in the order they were queued
+	std::vector<SoftwareTriangle> triangles;
+	std::vector<std::vector<int>> tileBins;
+
+	//Scratch space for transformed vertices
+	std::vector<ClipVertex> clipVertices;
+
+	void Initialize(int screenWidth, int screenHeight);
+	void Clear(float red, float green, float blue);
+	void DrawSprite(const MeshData& quad, const SoftwareMatrix& viewProjection, const SoftwareTexture* texture, const float uvRect[4], float x, float y, float spriteWidth, float spriteHeight, int zOrder, float angle);
+	void DrawMesh(const MeshData& mesh, const SoftwareMatrix& worldViewProjection, const SoftwareTexture* texture);
+	void Flush();
+	bool WriteFrame(const char* fileName);
+
+	void SubmitTriangles(const MeshData& mesh, const SoftwareTexture* texture);
+	void AddTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c, const SoftwareTexture* texture);
+	void RasterizeTile(int tile);
+};
@@ -1,30 +1,52 @@
 /*
 File Name:		Sound.h
-Description:	This file holds the definition of the wave file header type and the methods for loading a wave file and playng a wave file
+Description:	This file holds the wave file reader. It walks the RIFF chunks of a file for its format and samples, whatever
+				other chunks come between them, and converts 8, 16, 24 or 32 bit PCM or 32 or 64 bit float at any rate and
+				channel count into the mix format of the engine, 44.1kHz 16bit stereo.
 Programmer:		Kyle Jensen
 Date:			April 14, 2017
 */
 
-#include "platform.h"
+#pragma once
 
-struct WaveHeaderType
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+#include "MappedFile.h"
+
+//The format tags of the fmt chunk we read. Extensible files keep the real one in the first two bytes of their sub format.
+#define WAVE_TAG_PCM 0x0001
+#define WAVE_TAG_FLOAT 0x0003
+#define WAVE_TAG_EXTENSIBLE 0xFFFE
+
+//A chunk of a RIFF file, its data points into the mapped file
+struct RiffChunk
+{
+	char id[4];
+	uint32_t size;
+	const unsigned char* data;
+};
+
+//What a wave file holds, as its fmt chunk describes it
+struct WaveFormat
 {
-	char chunkId[4];
-	unsigned long chunkSize;
-	char format[4];
-	char subChunkId[4];
-	unsigned long subChunkSize;
-	unsigned short audioFormat;
-	unsigned short numChannels;
-	unsigned long sampleRate;
-	unsigned long bytesPerSecond;
-	unsigned short blockAlign;
-	unsigned short bitsPerSample;
-	char dataChunkId[4];
-	unsigned long dataSize;
+	uint16_t formatTag;
+	uint16_t channels;
+	uint32_t sampleRate;
+	uint16_t blockAlign;
+	uint16_t bitsPerSample;
+	uint32_t channelMask;
 };
 
-typedef IDirectSoundBuffer8* SoundHandle;
+//A wave file read and converted to 44.1kHz 16bit stereo
+struct WaveFile
+{
+	WaveFormat source;
+	std::vector<int16_t> samples;
+	uint32_t frameCount;
+};
 
-bool LoadWaveFile(char* fileName, IDirectSound8* directSound, SoundHandle* secondaryBuffer);
-bool PlayWaveFile(SoundHandle secondaryBuffer, long volume, bool looping = false);
\ No newline at end of file
+bool NextRiffChunk(const unsigned char** cursor, const unsigned char* end, RiffChunk* chunk);
+bool ReadWaveFormat(const RiffChunk& chunk, WaveFormat* format);
+bool ReadWaveFile(const char* fileName, WaveFile* wave);
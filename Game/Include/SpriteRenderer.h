@@ -0,0 +1,56 @@
+/*
+File Name:		SpriteRenderer.h
+Description:	This file holds the batched 2D sprite renderer. Sprites pushed during the frame are collected into one dynamic
+				instance buffer and drawn with one DrawInstanced per texture, the quad transform is built in the vertex shader.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include "Platform.h"
+#include "Texture.h"
+#include "RenderState.h"
+
+//The most sprites the instance buffer holds. Bigger batches are drawn in several passes.
+#define MAX_SPRITE_INSTANCES 4096
+
+//Per-instance data for texture.vs, matches the TEXCOORD1 to TEXCOORD3 elements of the sprite input layout
+struct SpriteInstance
+{
+	XMFLOAT4 rect;			//x, y, width, height in screen space
+	XMFLOAT2 depthAngle;	//zOrder, rotation around the sprite center
+	XMFLOAT4 uvRect;		//u, v, width, height of the region the sprite is drawn from
+};
+
+//Draw and buffer map calls issued by the renderer, and the binds the render state cache issued and skipped, counted per frame
+struct RenderStats
+{
+	int drawCalls;
+	int mapCalls;
+	int bindsIssued;
+	int bindsSkipped;
+};
+
+class SpriteRenderer
+{
+public:
+	ID3D11Buffer* instanceBuffer;
+	ID3D11VertexShader* vertexShader;
+	ID3D11InputLayout* layout;
+
+	//Instances written to the buffer since it was last discarded
+	int bufferUsed;
+
+	//Sprites pushed since the last flush, in the order they were pushed
+	std::vector<SpriteInstance> instances;
+	std::vector<TextureHandle> textures;
+
+	//Scratch space for sorting a flush
+	std::vector<int> order;
+	std::vector<SpriteInstance> sorted;
+
+	bool Initialize(ID3D11Device* device);
+	void Push(const SpriteRegion& region, float x, float y, float width, float height, int zOrder, float angle);
+	void Flush(RenderStateCache* renderState, DXBuffer* quadVertexBuffer, RenderStats* stats);
+};
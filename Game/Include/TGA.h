@@ -0,0 +1,63 @@
+/*
+File Name:		TGA.h
+Description:	This file holds the standalone TGA decoder. It handles uncompressed and RLE images (types 1, 2, 3, 9, 10 and 11)
+				with 8, 24 and 32 bit pixels, and both origin flags. Images are decoded in a single pass into a buffer the caller
+				provides, as RGBA rows stored top to bottom. Images can also be written back out uncompressed, for the frames the
+				software renderer produces. Nothing in here depends on D3D11.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+#define TGA_HEADER_SIZE 18
+
+//Image types from the TGA specification
+enum TGAImageType
+{
+	TGAColorMapped = 1,
+	TGATrueColor = 2,
+	TGAGrayscale = 3,
+	TGAColorMappedRLE = 9,
+	TGATrueColorRLE = 10,
+	TGAGrayscaleRLE = 11
+};
+
+//What the header says about an image, filled in by ReadTGAInfo
+struct TGAInfo
+{
+	int imageType;
+	int width;
+	int height;
+	int bytesPerPixel;
+
+	//Where the pixels start, past the image id and the color map
+	size_t pixelOffset;
+
+	//Color map entries, only used by color mapped images
+	size_t colorMapOffset;
+	int colorMapFirst;
+	int colorMapLength;
+	int colorMapBytes;
+
+	//Whether the first row in the file is the top row, and whether rows are stored right to left
+	bool topOrigin;
+	bool rightOrigin;
+};
+
+//The pixel converters DecodeTGA can use, picked at runtime like the collision kernels
+enum TGAConverter
+{
+	TGAConverterScalar,
+	TGAConverterSSSE3
+};
+
+bool ReadTGAInfo(const unsigned char* data, size_t size, TGAInfo* info);
+bool DecodeTGA(const unsigned char* data, size_t size, const TGAInfo& info, unsigned char* pixels);
+bool ReadTGA(const char* fileName, std::vector<unsigned char>* pixels, int* width, int* height);
+bool WriteTGA(const char* fileName, const unsigned char* pixels, int width, int height);
+TGAConverter SelectTGAConverter();
+void SetTGAConverter(TGAConverter converter);
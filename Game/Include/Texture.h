@@ -1,6 +1,6 @@
 /*
 File Name:		Texture.h
-Description:	This file handles all the loading of textures from TGA files. REFERENCES: http://www.rastertek.com/dx11tut05.html
+Description:	This file handles all the loading of textures from TGA files, the decoding itself lives in TGA.h. REFERENCES: http://www.rastertek.com/dx11tut05.html
 Programmer:		Kyle Jensen
 Date:			March 24, 2016
 */
@@ -10,18 +10,24 @@ Date:			March 24, 2016
 
 #include <d3d11.h>
 #include <stdio.h>
+#include <vector>
+
+#include "TGA.h"
 
 //Typedef this as a TextureHandle because who wants to type this garbage 100x
 typedef ID3D11ShaderResourceView* TextureHandle;
 
-//Defined header for a tga file
-struct TGAHeader
+//The part of a texture a sprite is drawn from, in UV space. Sprites packed into an atlas share its texture.
+struct SpriteRegion
 {
-	unsigned char data1[12];
-	unsigned short width;
-	unsigned short height;
-	unsigned char bpp;
-	unsigned char data2;
+	TextureHandle texture;
+	float u;
+	float v;
+	float width;
+	float height;
 };
 
-TextureHandle LoadTextureFromTGA(ID3D11Device* device, ID3D11DeviceContext* deviceContext, char* fileName);
\ No newline at end of file
+TextureHandle LoadTextureFromTGA(ID3D11Device* device, ID3D11DeviceContext* deviceContext, char* fileName);
+TextureHandle CreateTextureFromPixels(ID3D11Device* device, ID3D11DeviceContext* deviceContext, const unsigned char* pixels, int width, int height, int mipLevels = 0);
+TextureHandle CreateTextureArrayFromPixels(ID3D11Device* device, ID3D11DeviceContext* deviceContext, const unsigned char* const* slices, int sliceCount, int width, int height);
+SpriteRegion FullTextureRegion(TextureHandle texture);
\ No newline at end of file
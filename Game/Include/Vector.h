@@ -10,29 +10,39 @@ Date:			March 24, 2017
 
 #include <math.h>
 
+//Pi as a float, so simulation code does not need DirectXMath for XM_PI
+#define VECTOR_PI 3.141592654f
+
 struct Vector2
 {
 	float x;
 	float y;
 
-	Vector2 operator+(Vector2& b)
+	Vector2 operator+(const Vector2& b) const
 	{
 		return Vector2{ x + b.x, y + b.y };
 	}
-	Vector2 operator-(Vector2& b)
+	Vector2 operator-(const Vector2& b) const
 	{
 		return Vector2{ x - b.x, y - b.y };
 	}
-	Vector2 operator*(float s)
+	Vector2 operator*(float s) const
 	{
 		return Vector2{ x * s, y * s };
 	}
-	Vector2 operator/(float s)
+	Vector2 operator/(float s) const
 	{
 		return Vector2{ x / s, y / s };
 	}
 };
 
-float DotProduct(Vector2& a, Vector2& b);
-float Magnitude(Vector2& a);
-Vector2 Normalize(Vector2& a);
\ No newline at end of file
+struct Vector3
+{
+	float x;
+	float y;
+	float z;
+};
+
+float DotProduct(const Vector2& a, const Vector2& b);
+float Magnitude(const Vector2& a);
+Vector2 Normalize(const Vector2& a);
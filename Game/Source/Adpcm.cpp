@@ -0,0 +1,222 @@
+/*
+File Name:		Adpcm.cpp
+Description:	This file holds the IMA ADPCM encoder used by the asset packer and the block decoder used by the mixer.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Adpcm.h"
+
+//Runs of samples per channel in a block, and the samples in each
+#define ADPCM_BLOCK_RUNS 127
+#define ADPCM_RUN_SAMPLES 8
+
+static const int16_t stepTable[89] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+	157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411,
+	1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493,
+	10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t indexTable[16] =
+{
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+//The state of one channel, the sample the decoder has arrived at and the size of its next step
+struct AdpcmChannel
+{
+	int predictor;
+	int stepIndex;
+};
+
+//Every step index and nibble worked out ahead, the signed change to the sample and the step index that follows
+struct AdpcmTables
+{
+	int32_t delta[89 * 16];
+	uint8_t nextIndex[89 * 16];
+
+	//Function: AdpcmTables()
+	//Description: This method fills the tables from the IMA step and index tables.
+	//Returns: n/a.
+	AdpcmTables()
+	{
+		for (int stepIndex = 0; stepIndex < 89; stepIndex++)
+		{
+			for (int nibble = 0; nibble < 16; nibble++)
+			{
+				int step = stepTable[stepIndex];
+				int magnitude = step >> 3;
+				if (nibble & 4)
+					magnitude += step;
+				if (nibble & 2)
+					magnitude += step >> 1;
+				if (nibble & 1)
+					magnitude += step >> 2;
+
+				int next = stepIndex + indexTable[nibble];
+				this->delta[stepIndex * 16 + nibble] = (nibble & 8) ? -magnitude : magnitude;
+				this->nextIndex[stepIndex * 16 + nibble] = (uint8_t)((next < 0) ? 0 : (next > 88) ? 88 : next);
+			}
+		}
+	}
+};
+static const AdpcmTables tables;
+
+
+//Function: DecodeNibble(AdpcmChannel* channel, int nibble)
+//Description: This method moves a channel one step, the way both the encoder and decoder do.
+//Returns: int16_t = the decoded sample.
+static inline int16_t DecodeNibble(AdpcmChannel* channel, int nibble)
+{
+	int entry = channel->stepIndex * 16 + nibble;
+	int predictor = channel->predictor + tables.delta[entry];
+	if (predictor < -32768)
+		predictor = -32768;
+	if (predictor > 32767)
+		predictor = 32767;
+	channel->predictor = predictor;
+	channel->stepIndex = tables.nextIndex[entry];
+
+	return (int16_t)predictor;
+}
+
+
+//Function: EncodeSample(AdpcmChannel* channel, int sample)
+//Description: This method picks the step that lands a channel closest to a sample and takes it.
+//Returns: int = the 4 bit step.
+static int EncodeSample(AdpcmChannel* channel, int sample)
+{
+	int step = stepTable[channel->stepIndex];
+	int difference = sample - channel->predictor;
+	int nibble = 0;
+	if (difference < 0)
+	{
+		nibble = 8;
+		difference = -difference;
+	}
+
+	if (difference >= step)
+	{
+		nibble |= 4;
+		difference -= step;
+	}
+	if (difference >= (step >> 1))
+	{
+		nibble |= 2;
+		difference -= step >> 1;
+	}
+	if (difference >= (step >> 2))
+	{
+		nibble |= 1;
+	}
+
+	DecodeNibble(channel, nibble);
+	return nibble;
+}
+
+
+//Function: AdpcmSize(uint32_t frameCount)
+//Description: This method works out the size of a sound once encoded, the last block is padded to a whole one.
+//Returns: size_t = the size in bytes.
+size_t AdpcmSize(uint32_t frameCount)
+{
+	return ((size_t)(frameCount + ADPCM_BLOCK_FRAMES - 1) / ADPCM_BLOCK_FRAMES) * ADPCM_BLOCK_BYTES;
+}
+
+
+//Function: AdpcmEncode(const int16_t* samples, uint32_t frameCount, std::vector<unsigned char>* encoded)
+//Description: This method encodes 16 bit stereo samples into blocks. The step index carries on from one block to the next,
+//the header sample is the exact first sample of the block.
+//Returns: void.
+void AdpcmEncode(const int16_t* samples, uint32_t frameCount, std::vector<unsigned char>* encoded)
+{
+	encoded->assign(AdpcmSize(frameCount), 0);
+
+	AdpcmChannel channels[ADPCM_CHANNELS] = {};
+	unsigned char* block = encoded->data();
+	for (uint32_t blockStart = 0; blockStart < frameCount; blockStart += ADPCM_BLOCK_FRAMES, block += ADPCM_BLOCK_BYTES)
+	{
+		//Frames past the end of the sound repeat its last one
+		auto sampleAt = [&](uint32_t frame, int channel)
+		{
+			uint32_t clamped = (frame < frameCount) ? frame : frameCount - 1;
+			return (int)samples[clamped * ADPCM_CHANNELS + channel];
+		};
+
+		for (int channel = 0; channel < ADPCM_CHANNELS; channel++)
+		{
+			int first = sampleAt(blockStart, channel);
+			channels[channel].predictor = first;
+
+			unsigned char* header = block + channel * 4;
+			header[0] = (unsigned char)(first & 0xFF);
+			header[1] = (unsigned char)((first >> 8) & 0xFF);
+			header[2] = (unsigned char)channels[channel].stepIndex;
+			header[3] = 0;
+		}
+
+		unsigned char* data = block + ADPCM_CHANNELS * 4;
+		for (int run = 0; run < ADPCM_BLOCK_RUNS; run++)
+		{
+			uint32_t runStart = blockStart + 1 + run * ADPCM_RUN_SAMPLES;
+			for (int channel = 0; channel < ADPCM_CHANNELS; channel++)
+			{
+				//Two samples to a byte, the earlier one in the low nibble
+				for (int i = 0; i < ADPCM_RUN_SAMPLES; i += 2)
+				{
+					int low = EncodeSample(&channels[channel], sampleAt(runStart + i, channel));
+					int high = EncodeSample(&channels[channel], sampleAt(runStart + i + 1, channel));
+					*data++ = (unsigned char)(low | (high << 4));
+				}
+			}
+		}
+	}
+}
+
+
+//Function: AdpcmDecodeBlock(const unsigned char* block, int16_t* output)
+//Description: This method decodes a whole block into ADPCM_BLOCK_FRAMES interleaved stereo frames.
+//Returns: void.
+void AdpcmDecodeBlock(const unsigned char* block, int16_t* output)
+{
+	AdpcmChannel channels[ADPCM_CHANNELS];
+	for (int channel = 0; channel < ADPCM_CHANNELS; channel++)
+	{
+		const unsigned char* header = block + channel * 4;
+		channels[channel].predictor = (int16_t)(header[0] | (header[1] << 8));
+		channels[channel].stepIndex = (header[2] <= 88) ? header[2] : 88;
+		output[channel] = (int16_t)channels[channel].predictor;
+	}
+
+	//Each sample depends on the one before it, so the two channels are decoded side by side to overlap their chains
+	const unsigned char* data = block + ADPCM_CHANNELS * 4;
+	for (int run = 0; run < ADPCM_BLOCK_RUNS; run++, data += ADPCM_RUN_SAMPLES)
+	{
+		int16_t* runOutput = output + (1 + run * ADPCM_RUN_SAMPLES) * ADPCM_CHANNELS;
+		for (int i = 0; i < ADPCM_RUN_SAMPLES; i += 2)
+		{
+			unsigned char left = data[i / 2];
+			unsigned char right = data[ADPCM_RUN_SAMPLES / 2 + i / 2];
+			runOutput[i * ADPCM_CHANNELS + 0] = DecodeNibble(&channels[0], left & 0x0F);
+			runOutput[i * ADPCM_CHANNELS + 1] = DecodeNibble(&channels[1], right & 0x0F);
+			runOutput[(i + 1) * ADPCM_CHANNELS + 0] = DecodeNibble(&channels[0], left >> 4);
+			runOutput[(i + 1) * ADPCM_CHANNELS + 1] = DecodeNibble(&channels[1], right >> 4);
+		}
+	}
+}
+
+
+//Function: AdpcmFirstFrame(const unsigned char* block, int16_t* output)
+//Description: This method reads the first frame of a block from its headers, without decoding the rest.
+//Returns: void.
+void AdpcmFirstFrame(const unsigned char* block, int16_t* output)
+{
+	for (int channel = 0; channel < ADPCM_CHANNELS; channel++)
+	{
+		const unsigned char* header = block + channel * 4;
+		output[channel] = (int16_t)(header[0] | (header[1] << 8));
+	}
+}
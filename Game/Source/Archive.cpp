@@ -0,0 +1,126 @@
+/*
+File Name:		Archive.cpp
+Description:	This file holds the methods to open a packed asset archive and look assets up in it.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Archive.h"
+#include <string.h>
+
+
+//Function: ArchiveHash(const char* name)
+//Description: This method hashes an asset name with 64 bit FNV-1a. 0 is kept for empty slots, so it is never returned.
+//Returns: uint64_t = the hash of the name.
+uint64_t ArchiveHash(const char* name)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (const unsigned char* c = (const unsigned char*)name; *c; c++)
+	{
+		hash ^= *c;
+		hash *= 1099511628211ull;
+	}
+
+	return hash ? hash : 1;
+}
+
+
+//Function: Open(const char* fileName)
+//Description: This method maps the archive and checks that the table and every entry in it lie inside the file, so lookups
+//and reads never have to check again.
+//Returns: bool = whether the archive was opened.
+bool AssetArchive::Open(const char* fileName)
+{
+	this->header = 0;
+	this->slots = 0;
+	this->names = 0;
+
+	if (!this->file.Open(fileName))
+		return false;
+
+	const unsigned char* data = this->file.data;
+	size_t size = this->file.size;
+	if (size < sizeof(ArchiveHeader))
+		return false;
+
+	const ArchiveHeader* header = (const ArchiveHeader*)data;
+	if (header->magic != ARCHIVE_MAGIC || header->version != ARCHIVE_VERSION)
+		return false;
+
+	//The table needs an empty slot to stop lookups of names that are not in it
+	uint32_t slotCount = header->slotCount;
+	if (slotCount == 0 || (slotCount & (slotCount - 1)) != 0 || header->entryCount >= slotCount)
+		return false;
+	if ((size - sizeof(ArchiveHeader)) / sizeof(ArchiveEntry) < slotCount)
+		return false;
+
+	if (header->namesOffset > size || header->namesSize > size - header->namesOffset)
+		return false;
+	if (header->namesSize == 0 || data[header->namesOffset + header->namesSize - 1] != 0)
+		return false;
+
+	const ArchiveEntry* slots = (const ArchiveEntry*)(data + sizeof(ArchiveHeader));
+	for (uint32_t i = 0; i < slotCount; i++)
+	{
+		const ArchiveEntry& entry = slots[i];
+		if (entry.hash == 0)
+			continue;
+
+		if (entry.offset > size || entry.size > size - entry.offset || entry.nameOffset >= header->namesSize)
+			return false;
+	}
+
+	this->header = header;
+	this->slots = slots;
+	this->names = (const char*)(data + header->namesOffset);
+	return true;
+}
+
+
+//Function: Find(const char* name)
+//Description: This method looks an asset up by the name it was packed under, for example "Textures/ship.tga".
+//Returns: const ArchiveEntry* = the entry of the asset, 0 if the archive does not have it.
+const ArchiveEntry* AssetArchive::Find(const char* name) const
+{
+	if (!this->header)
+		return 0;
+
+	uint64_t hash = ArchiveHash(name);
+	uint32_t mask = this->header->slotCount - 1;
+
+	for (uint32_t slot = (uint32_t)hash & mask; this->slots[slot].hash != 0; slot = (slot + 1) & mask)
+	{
+		const ArchiveEntry* entry = &this->slots[slot];
+		if (entry->hash == hash && strcmp(this->names + entry->nameOffset, name) == 0)
+			return entry;
+	}
+
+	return 0;
+}
+
+
+//Function: Data(const ArchiveEntry* entry)
+//Description: This method gets the bytes of an asset inside the mapping.
+//Returns: const unsigned char* = the first byte of the asset.
+const unsigned char* AssetArchive::Data(const ArchiveEntry* entry) const
+{
+	return this->file.data + entry->offset;
+}
+
+
+//Function: Name(const ArchiveEntry* entry)
+//Description: This method gets the name an asset was packed under.
+//Returns: const char* = the name of the asset.
+const char* AssetArchive::Name(const ArchiveEntry* entry) const
+{
+	return this->names + entry->nameOffset;
+}
+
+
+//Function: Touch(const ArchiveEntry* entry)
+//Description: This method pages an asset in, so the thread that copies it to the GPU or the sound buffer does not wait on the disk.
+//Returns: void.
+void AssetArchive::Touch(const ArchiveEntry* entry) const
+{
+	this->file.Touch((size_t)entry->offset, (size_t)entry->size);
+}
@@ -0,0 +1,466 @@
+/*
+File Name:		AssetPacker.cpp
+Description:	This file is the asset packer, a command line tool run by the build. It reads the asset manifest, converts every
+				asset listed in it into the form the game uploads and writes them all into one archive. It fails without
+				writing anything if an asset is missing or cannot be read, and lists every one of them. Sprites are packed
+				onto atlas pages here too, so the game never builds an atlas itself.
+				Usage: AssetPacker <manifest> <asset directory> <archive>
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "../Include/Archive.h"
+#include "../Include/Atlas.h"
+#include "../Include/MappedFile.h"
+#include "../Include/ObjLoader.h"
+#include "../Include/Sound.h"
+#include "../Include/TGA.h"
+#include "../Include/Adpcm.h"
+
+//An asset read from disk and ready to be written into the archive
+struct PackedAsset
+{
+	std::string name;
+	std::string source;
+	ArchiveEntry entry;
+	std::vector<unsigned char> bytes;
+
+	//Index of an earlier asset packed from the same file, whose bytes this one shares. -1 if it has its own.
+	int sharedWith;
+
+	//Size a texture is resampled to, 0 to keep the size of the file
+	int width;
+	int height;
+
+	//Whether a sound is compressed to ADPCM
+	bool adpcm;
+
+	//Whether a texture is packed into the atlas, it is stored as a sprite of one of the pages
+	bool atlas;
+};
+
+
+//Function: EndsWith(const std::string& text, const char* suffix)
+//Description: This method checks the extension of an asset name.
+//Returns: bool = whether text ends with suffix.
+static bool EndsWith(const std::string& text, const char* suffix)
+{
+	size_t length = strlen(suffix);
+	return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+
+//Function: ReadManifest(const char* fileName, std::vector<PackedAsset>* assets)
+//Description: This method reads the manifest. Every line names an asset, optionally followed by the file to pack under that
+//name when it is not the file of the same name, for textures the size to resample it to, such as 1024x512, or atlas to pack
+//it into the atlas, and for sounds adpcm to compress them.
+//Blank lines and lines starting with # are skipped.
+//Returns: bool = whether the manifest could be opened.
+static bool ReadManifest(const char* fileName, std::vector<PackedAsset>* assets)
+{
+	FILE* file = fopen(fileName, "r");
+	if (!file)
+		return false;
+
+	char line[512];
+	while (fgets(line, sizeof(line), file))
+	{
+		char fields[3][256];
+		int fieldCount = sscanf(line, " %255s %255s %255s", fields[0], fields[1], fields[2]);
+		if (fieldCount < 1 || fields[0][0] == '#')
+			continue;
+
+		PackedAsset asset;
+		asset.name = fields[0];
+		asset.source = fields[0];
+		asset.entry = {};
+		asset.sharedWith = -1;
+		asset.width = 0;
+		asset.height = 0;
+		asset.adpcm = false;
+		asset.atlas = false;
+
+		for (int i = 1; i < fieldCount; i++)
+		{
+			int width;
+			int height;
+			char end;
+			if (sscanf(fields[i], "%dx%d%c", &width, &height, &end) == 2 && width > 0 && height > 0)
+			{
+				asset.width = width;
+				asset.height = height;
+			}
+			else if (!strcmp(fields[i], "adpcm"))
+			{
+				asset.adpcm = true;
+			}
+			else if (!strcmp(fields[i], "atlas"))
+			{
+				asset.atlas = true;
+			}
+			else
+			{
+				asset.source = fields[i];
+			}
+		}
+
+		assets->push_back(asset);
+	}
+
+	fclose(file);
+	return true;
+}
+
+
+//Function: ResizeImage(const std::vector<unsigned char>& pixels, int width, int height, int newWidth, int newHeight, std::vector<unsigned char>* resized)
+//Description: This method resamples an RGBA image with bilinear filtering, so textures of different sizes can share a texture array.
+//Returns: void.
+static void ResizeImage(const std::vector<unsigned char>& pixels, int width, int height, int newWidth, int newHeight, std::vector<unsigned char>* resized)
+{
+	resized->resize((size_t)newWidth * newHeight * 4);
+
+	for (int y = 0; y < newHeight; y++)
+	{
+		//Sample at pixel centers, clamped to the edge pixels
+		float sourceY = ((y + 0.5f) * height) / newHeight - 0.5f;
+		if (sourceY < 0.0f)
+			sourceY = 0.0f;
+		int y0 = (int)sourceY;
+		int y1 = (y0 + 1 < height) ? y0 + 1 : y0;
+		float fy = sourceY - y0;
+
+		for (int x = 0; x < newWidth; x++)
+		{
+			float sourceX = ((x + 0.5f) * width) / newWidth - 0.5f;
+			if (sourceX < 0.0f)
+				sourceX = 0.0f;
+			int x0 = (int)sourceX;
+			int x1 = (x0 + 1 < width) ? x0 + 1 : x0;
+			float fx = sourceX - x0;
+
+			const unsigned char* p00 = &pixels[((size_t)y0 * width + x0) * 4];
+			const unsigned char* p01 = &pixels[((size_t)y0 * width + x1) * 4];
+			const unsigned char* p10 = &pixels[((size_t)y1 * width + x0) * 4];
+			const unsigned char* p11 = &pixels[((size_t)y1 * width + x1) * 4];
+			unsigned char* destination = &(*resized)[((size_t)y * newWidth + x) * 4];
+
+			for (int c = 0; c < 4; c++)
+			{
+				float top = p00[c] + (p01[c] - p00[c]) * fx;
+				float bottom = p10[c] + (p11[c] - p10[c]) * fx;
+				destination[c] = (unsigned char)(top + (bottom - top) * fy + 0.5f);
+			}
+		}
+	}
+}
+
+
+//Function: ReadAsset(const std::string& assetDirectory, PackedAsset* asset)
+//Description: This method reads an asset from disk by its extension. TGAs are decoded into RGBA rows stored top to bottom,
+//WAVs are converted to 44.1kHz 16bit stereo samples, which are encoded to ADPCM if asked, meshes are converted from obj
+//files, welded and ordered for the vertex cache, and anything else is packed as it is.
+//Returns: bool = whether the asset was read.
+static bool ReadAsset(const std::string& assetDirectory, PackedAsset* asset)
+{
+	std::string path = assetDirectory + "/" + asset->source;
+	ArchiveEntry& entry = asset->entry;
+
+	if (EndsWith(asset->name, ".tga"))
+	{
+		int width = 0;
+		int height = 0;
+		if (!ReadTGA(path.c_str(), &asset->bytes, &width, &height))
+			return false;
+
+		if (asset->width && (asset->width != width || asset->height != height))
+		{
+			std::vector<unsigned char> resized;
+			ResizeImage(asset->bytes, width, height, asset->width, asset->height, &resized);
+			asset->bytes.swap(resized);
+			width = asset->width;
+			height = asset->height;
+		}
+
+		entry.type = AssetTexture;
+		entry.texture.width = width;
+		entry.texture.height = height;
+	}
+	else if (EndsWith(asset->name, ".wav"))
+	{
+		WaveFile wave;
+		if (!ReadWaveFile(path.c_str(), &wave))
+			return false;
+
+		if (asset->adpcm)
+		{
+			AdpcmEncode(wave.samples.data(), wave.frameCount, &asset->bytes);
+		}
+		else
+		{
+			const unsigned char* samples = (const unsigned char*)wave.samples.data();
+			asset->bytes.assign(samples, samples + wave.samples.size() * sizeof(int16_t));
+		}
+
+		entry.type = AssetSound;
+		entry.sound.sampleRate = 44100;
+		entry.sound.channels = 2;
+		entry.sound.bitsPerSample = asset->adpcm ? 4 : 16;
+		entry.sound.frameCount = wave.frameCount;
+	}
+	else if (EndsWith(asset->name, ".mesh"))
+	{
+		std::vector<MeshVertex> triangles;
+		if (!ObjLoader::VerticesFromObj(path.c_str(), &triangles))
+			return false;
+
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		WeldMesh(triangles, &vertices, &indices);
+		OptimizeVertexCache(&indices, (uint32_t)vertices.size(), MESH_CACHE_SIZE);
+		OptimizeVertexFetch(&vertices, &indices);
+
+		WriteMesh(vertices, indices, &asset->bytes);
+		entry.type = AssetMesh;
+	}
+	else
+	{
+		MappedFile file;
+		if (!file.Open(path.c_str()))
+			return false;
+
+		asset->bytes.assign(file.data, file.data + file.size);
+		entry.type = AssetRaw;
+	}
+
+	entry.size = asset->bytes.size();
+	return true;
+}
+
+
+//Function: PackAtlas(std::vector<PackedAsset>* assets)
+//Description: This method packs the textures marked for the atlas onto pages. Each of them becomes a sprite entry with no
+//bytes that gives its rectangle, and every page is added as a texture named after ATLAS_PAGE_NAME.
+//Returns: void.
+static void PackAtlas(std::vector<PackedAsset>* assets)
+{
+	std::vector<AtlasImage> images;
+	std::vector<size_t> imageAssets;
+	for (size_t i = 0; i < assets->size(); i++)
+	{
+		PackedAsset& asset = (*assets)[i];
+		if (!asset.atlas || asset.sharedWith >= 0 || asset.entry.type != AssetTexture)
+			continue;
+
+		AtlasImage image;
+		image.width = (int)asset.entry.texture.width;
+		image.height = (int)asset.entry.texture.height;
+		image.pixels.swap(asset.bytes);
+		images.push_back(image);
+		imageAssets.push_back(i);
+	}
+
+	if (images.empty())
+		return;
+
+	TextureAtlas atlas;
+	atlas.Pack(images);
+
+	for (size_t i = 0; i < imageAssets.size(); i++)
+	{
+		const AtlasRect& rect = atlas.rects[i];
+		ArchiveEntry& entry = (*assets)[imageAssets[i]].entry;
+		entry.type = AssetSprite;
+		entry.size = 0;
+		entry.sprite.page = (uint32_t)rect.page;
+		entry.sprite.x = (uint32_t)rect.x;
+		entry.sprite.y = (uint32_t)rect.y;
+		entry.sprite.width = (uint32_t)rect.width;
+		entry.sprite.height = (uint32_t)rect.height;
+	}
+
+	for (size_t i = 0; i < atlas.pages.size(); i++)
+	{
+		char name[64];
+		snprintf(name, sizeof(name), ATLAS_PAGE_NAME, (int)i);
+
+		PackedAsset page;
+		page.name = name;
+		page.source = name;
+		page.entry = {};
+		page.entry.type = AssetTexture;
+		page.entry.texture.width = (uint32_t)atlas.pages[i].width;
+		page.entry.texture.height = (uint32_t)atlas.pages[i].height;
+		page.entry.size = atlas.pages[i].pixels.size();
+		page.bytes.swap(atlas.pages[i].pixels);
+		page.sharedWith = -1;
+		page.width = 0;
+		page.height = 0;
+		page.adpcm = false;
+		page.atlas = false;
+		assets->push_back(page);
+	}
+}
+
+
+//Function: AlignOffset(uint64_t offset)
+//Description: This method rounds an offset up to where the next asset may start.
+//Returns: uint64_t = the aligned offset.
+static uint64_t AlignOffset(uint64_t offset)
+{
+	return (offset + ARCHIVE_ALIGNMENT - 1) & ~(uint64_t)(ARCHIVE_ALIGNMENT - 1);
+}
+
+
+//Function: main()
+//Description: This is the main method of the packer.
+//Returns: int = 0 if the archive was written, 1 if not.
+int main(int argc, char** argv)
+{
+	if (argc != 4)
+	{
+		printf("Usage: AssetPacker <manifest> <asset directory> <archive>\n");
+		return 1;
+	}
+
+	std::vector<PackedAsset> assets;
+	if (!ReadManifest(argv[1], &assets))
+	{
+		printf("AssetPacker: could not open manifest %s\n", argv[1]);
+		return 1;
+	}
+
+	//Read everything before failing, so one run lists every asset that has to be fixed
+	int failures = 0;
+	for (size_t i = 0; i < assets.size(); i++)
+	{
+		//Placeholders packed from the same file at the same size share its bytes
+		for (size_t j = 0; j < i && assets[i].sharedWith < 0; j++)
+		{
+			const PackedAsset& other = assets[j];
+			if (other.source == assets[i].source && other.width == assets[i].width && other.height == assets[i].height && other.adpcm == assets[i].adpcm && other.atlas == assets[i].atlas && other.sharedWith < 0)
+				assets[i].sharedWith = (int)j;
+		}
+
+		if (assets[i].sharedWith >= 0)
+			continue;
+
+		if (!ReadAsset(argv[2], &assets[i]))
+		{
+			printf("AssetPacker: %s: missing or unreadable %s/%s\n", assets[i].name.c_str(), argv[2], assets[i].source.c_str());
+			failures++;
+		}
+	}
+
+	if (failures)
+	{
+		printf("AssetPacker: %d of %d assets failed, %s was not written\n", failures, (int)assets.size(), argv[3]);
+		return 1;
+	}
+
+	PackAtlas(&assets);
+
+	//Size the table to at most half full so probe runs stay short
+	uint32_t slotCount = 1;
+	while (slotCount < assets.size() * 2)
+	{
+		slotCount *= 2;
+	}
+
+	std::vector<ArchiveEntry> slots(slotCount);
+	memset(slots.data(), 0, slots.size() * sizeof(ArchiveEntry));
+
+	std::vector<char> names;
+	for (size_t i = 0; i < assets.size(); i++)
+	{
+		ArchiveEntry& entry = assets[i].entry;
+		entry.hash = ArchiveHash(assets[i].name.c_str());
+		entry.nameOffset = (uint32_t)names.size();
+		names.insert(names.end(), assets[i].name.begin(), assets[i].name.end());
+		names.push_back(0);
+	}
+
+	ArchiveHeader header = {};
+	header.magic = ARCHIVE_MAGIC;
+	header.version = ARCHIVE_VERSION;
+	header.entryCount = (uint32_t)assets.size();
+	header.slotCount = slotCount;
+	header.namesOffset = sizeof(ArchiveHeader) + slotCount * sizeof(ArchiveEntry);
+	header.namesSize = names.size();
+
+	//Lay the assets out after the names and place each entry in the table
+	uint64_t offset = header.namesOffset + header.namesSize;
+	for (size_t i = 0; i < assets.size(); i++)
+	{
+		ArchiveEntry& entry = assets[i].entry;
+		if (assets[i].sharedWith >= 0)
+		{
+			//Take everything but the name from the asset it shares
+			uint64_t hash = entry.hash;
+			uint32_t nameOffset = entry.nameOffset;
+			entry = assets[assets[i].sharedWith].entry;
+			entry.hash = hash;
+			entry.nameOffset = nameOffset;
+		}
+		else
+		{
+			offset = AlignOffset(offset);
+			entry.offset = offset;
+			offset += entry.size;
+		}
+
+		uint32_t slot = (uint32_t)entry.hash & (slotCount - 1);
+		while (slots[slot].hash != 0)
+		{
+			if (slots[slot].hash == entry.hash)
+			{
+				printf("AssetPacker: %s and %s have the same name hash\n", assets[i].name.c_str(), &names[slots[slot].nameOffset]);
+				return 1;
+			}
+
+			slot = (slot + 1) & (slotCount - 1);
+		}
+
+		slots[slot] = entry;
+	}
+
+	FILE* file = fopen(argv[3], "wb");
+	if (!file)
+	{
+		printf("AssetPacker: could not create %s\n", argv[3]);
+		return 1;
+	}
+
+	fwrite(&header, sizeof(header), 1, file);
+	fwrite(slots.data(), sizeof(ArchiveEntry), slots.size(), file);
+	fwrite(names.data(), 1, names.size(), file);
+
+	static const unsigned char padding[ARCHIVE_ALIGNMENT] = {};
+	uint64_t written = header.namesOffset + header.namesSize;
+	for (size_t i = 0; i < assets.size(); i++)
+	{
+		const PackedAsset& asset = assets[i];
+		if (asset.sharedWith >= 0)
+			continue;
+
+		fwrite(padding, 1, (size_t)(asset.entry.offset - written), file);
+		fwrite(asset.bytes.data(), 1, asset.bytes.size(), file);
+		written = asset.entry.offset + asset.entry.size;
+	}
+
+	bool failed = ferror(file) != 0;
+	fclose(file);
+	if (failed)
+	{
+		printf("AssetPacker: could not write %s\n", argv[3]);
+		remove(argv[3]);
+		return 1;
+	}
+
+	printf("AssetPacker: packed %d assets into %s (%llu bytes)\n", (int)assets.size(), argv[3], (unsigned long long)written);
+	return 0;
+}
@@ -0,0 +1,113 @@
+/*
+File Name:		Atlas.cpp
+Description:	This file holds the definition of the texture atlas packer.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Atlas.h"
+#include <algorithm>
+#include <string.h>
+
+
+//Function: PaddedSize(int size)
+//Description: This method works out the size of the cell an image takes on a page: the image, the padding before it, and
+//at least the padding after it, rounded up so the next cell starts on a multiple of the padding.
+//Returns: int = the size of the cell.
+static int PaddedSize(int size)
+{
+	return (size + ATLAS_PADDING * 2 + ATLAS_PADDING - 1) / ATLAS_PADDING * ATLAS_PADDING;
+}
+
+
+//Function: CopyPadded(AtlasPage* page, const AtlasImage& image, int x, int y)
+//Description: This method copies an image onto a page, then repeats its outer rows and columns into the rest of its cell.
+//Returns: void.
+static void CopyPadded(AtlasPage* page, const AtlasImage& image, int x, int y)
+{
+	int pagePitch = page->width * 4;
+	int imagePitch = image.width * 4;
+	int after = PaddedSize(image.width) - ATLAS_PADDING - image.width;
+
+	for (int row = -ATLAS_PADDING; row < PaddedSize(image.height) - ATLAS_PADDING; row++)
+	{
+		int sourceRow = std::min(std::max(row, 0), image.height - 1);
+		const unsigned char* source = &image.pixels[sourceRow * imagePitch];
+		unsigned char* destination = &page->pixels[(y + row) * pagePitch + x * 4];
+
+		memcpy(destination, source, imagePitch);
+		for (int column = 1; column <= ATLAS_PADDING; column++)
+		{
+			memcpy(destination - column * 4, source, 4);
+		}
+		for (int column = 0; column < after; column++)
+		{
+			memcpy(destination + imagePitch + column * 4, source + imagePitch - 4, 4);
+		}
+	}
+}
+
+
+//Function: Pack(const std::vector<AtlasImage>& images)
+//Description: This method packs the images onto pages. The images are placed tallest first in rows (shelves) from the
+//top left of a page, a new shelf is started when one is full and a new page when the page is full. An image too big for
+//a page gets a page of its own size.
+//Returns: void.
+void TextureAtlas::Pack(const std::vector<AtlasImage>& images)
+{
+	this->pages.clear();
+	this->rects.assign(images.size(), AtlasRect{});
+
+	std::vector<int> order(images.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = (int)i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return images[a].height > images[b].height; });
+
+	int shelfX = 0;
+	int shelfY = 0;
+	int shelfHeight = 0;
+	int page = -1;
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const AtlasImage& image = images[order[i]];
+		int paddedWidth = PaddedSize(image.width);
+		int paddedHeight = PaddedSize(image.height);
+
+		//Start a new shelf when the image does not fit on the current one, and a new page when the shelf does not fit
+		if (page >= 0 && shelfX + paddedWidth > this->pages[page].width)
+		{
+			shelfX = 0;
+			shelfY += shelfHeight;
+			shelfHeight = 0;
+		}
+
+		if (page < 0 || shelfX + paddedWidth > this->pages[page].width || shelfY + paddedHeight > this->pages[page].height)
+		{
+			AtlasPage newPage;
+			newPage.width = std::max(ATLAS_PAGE_SIZE, paddedWidth);
+			newPage.height = std::max(ATLAS_PAGE_SIZE, paddedHeight);
+			newPage.pixels.assign(newPage.width * newPage.height * 4, 0);
+			this->pages.push_back(newPage);
+
+			page = (int)this->pages.size() - 1;
+			shelfX = 0;
+			shelfY = 0;
+			shelfHeight = 0;
+		}
+
+		AtlasRect& rect = this->rects[order[i]];
+		rect.page = page;
+		rect.x = shelfX + ATLAS_PADDING;
+		rect.y = shelfY + ATLAS_PADDING;
+		rect.width = image.width;
+		rect.height = image.height;
+
+		CopyPadded(&this->pages[page], image, rect.x, rect.y);
+
+		shelfX += paddedWidth;
+		shelfHeight = std::max(shelfHeight, paddedHeight);
+	}
+}
@@ -0,0 +1,388 @@
+/*
+File Name:		AudioBench.cpp
+Description:	This file is the audio benchmark. It reads every sound the asset manifest packs, converted to the mix format the
+				way the asset packer does, and encodes each to IMA ADPCM. It reports what that saves on disk and in memory, how
+				long encoding takes, how long decoding takes per second of audio, what it costs a voice to decode its blocks as
+				it mixes compared with mixing 16 bit samples, and how far the decoded sound is from the original. Every sound is
+				also mixed at several pitches, looping and not, from its ADPCM blocks and from the same blocks decoded up front,
+				and the two must come out the same. Last it times converting tones in other formats to the mix format the way
+				the asset packer does, and checks a 1kHz tone keeps its level and one above the new Nyquist frequency is gone.
+				Usage: AudioBench <manifest> <asset directory> [repeats]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../Include/Sound.h"
+#include "../Include/AudioConvert.h"
+#include "../Include/Adpcm.h"
+#include "../Include/Mixer.h"
+
+//Frames of each sound mixed for the pitch comparison, in passes of an odd size so they end partway into blocks
+#define COMPARE_FRAMES 100000
+#define COMPARE_PASS 333
+
+//Seconds of each made up tone converted to the mix format
+#define CONVERT_SECONDS 10
+
+//How far a converted 1kHz tone may be from its level, in dB, and how loud a tone the resampler must remove may still be
+#define CONVERT_LEVEL_TOLERANCE 0.05
+#define CONVERT_ALIAS_LIMIT -60.0
+
+//The speakers of a 5.1 file
+#define SPEAKERS_5_1 (SpeakerFrontLeft | SpeakerFrontRight | SpeakerFrontCenter | SpeakerLowFrequency | SpeakerBackLeft | SpeakerBackRight)
+
+//A half scale tone in a format other than the mix format, on some of the channels of a layout, and the level in dB it must
+//come out at on both sides, unless it is above the new Nyquist frequency and must be removed
+struct ConvertCase
+{
+	uint32_t sampleRate;
+	int channels;
+	uint32_t channelMask;
+	uint32_t toneChannels;
+	double frequency;
+	double level;
+	bool removed;
+};
+
+static const ConvertCase convertCases[] =
+{
+	{ 8000, 1, 0, 0x1, 1000.0, -6.02, false },
+	{ 22050, 1, 0, 0x1, 1000.0, -6.02, false },
+	{ 44100, 6, SPEAKERS_5_1, 0x3, 1000.0, -6.02, false },
+	{ 48000, 2, 0, 0x3, 1000.0, -6.02, false },
+	{ 96000, 6, SPEAKERS_5_1, 0x4, 1000.0, -9.03, false },
+	{ 96000, 2, 0, 0x3, 30000.0, 0.0, true },
+};
+
+//A sound of the manifest, its samples in the mix format and encoded
+struct BenchSound
+{
+	std::string name;
+	std::vector<int16_t> samples;
+	std::vector<unsigned char> encoded;
+	std::vector<int16_t> decoded;
+	uint32_t frameCount;
+};
+
+
+//Function: ReadManifestSounds(const char* manifestName, const char* assetDirectory, std::vector<std::string>* fileNames)
+//Description: This method finds every wav file the manifest reads. A line packs its second column instead of its first when
+//that is a file, every file is listed once.
+//Returns: bool = whether the manifest could be read.
+static bool ReadManifestSounds(const char* manifestName, const char* assetDirectory, std::vector<std::string>* fileNames)
+{
+	FILE* manifest = fopen(manifestName, "r");
+	if (!manifest)
+		return false;
+
+	std::set<std::string> seen;
+	char line[1024];
+	while (fgets(line, sizeof(line), manifest))
+	{
+		char first[512];
+		char second[512];
+		int columns = sscanf(line, "%511s %511s", first, second);
+		if (columns < 1 || first[0] == '#')
+			continue;
+
+		std::string source = (columns == 2 && strstr(second, ".wav")) ? second : first;
+		if (source.size() < 4 || source.compare(source.size() - 4, 4, ".wav") != 0 || !seen.insert(source).second)
+			continue;
+
+		fileNames->push_back(std::string(assetDirectory) + "/" + source);
+	}
+
+	fclose(manifest);
+	return true;
+}
+
+
+//Function: DecodeAll(const BenchSound& sound, int16_t* output)
+//Description: This method decodes every block of a sound, the output holds whole blocks.
+//Returns: void.
+static void DecodeAll(const BenchSound& sound, int16_t* output)
+{
+	size_t blocks = sound.encoded.size() / ADPCM_BLOCK_BYTES;
+	for (size_t b = 0; b < blocks; b++)
+	{
+		AdpcmDecodeBlock(&sound.encoded[b * ADPCM_BLOCK_BYTES], output + b * ADPCM_BLOCK_FRAMES * MIXER_CHANNELS);
+	}
+}
+
+
+//Function: MixSound(AudioMixer* mixer, const MixerSound& sound, float pitch, bool looping, int16_t* output)
+//Description: This method plays a sound alone and mixes COMPARE_FRAMES frames of it.
+//Returns: void.
+static void MixSound(AudioMixer* mixer, const MixerSound& sound, float pitch, bool looping, int16_t* output)
+{
+	mixer->Initialize();
+	mixer->Play(sound, 0.8f, 0.6f, pitch, looping, 0);
+	for (int frame = 0; frame < COMPARE_FRAMES; frame += COMPARE_PASS)
+	{
+		int count = (COMPARE_FRAMES - frame < COMPARE_PASS) ? COMPARE_FRAMES - frame : COMPARE_PASS;
+		mixer->Mix(output + frame * MIXER_CHANNELS, count);
+	}
+}
+
+
+//Function: TimeMixing(AudioMixer* mixer, const MixerSound& sound, uint32_t frameCount, int repeats)
+//Description: This method times mixing the whole of a sound on one voice, repeats times, in blocks the size the mixer mixes.
+//Returns: double = the seconds it took.
+static double TimeMixing(AudioMixer* mixer, const MixerSound& sound, uint32_t frameCount, int repeats)
+{
+	static int16_t output[MIXER_BLOCK_FRAMES * MIXER_CHANNELS];
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		mixer->Initialize();
+		mixer->Play(sound, 1.0f, 1.0f, 1.0f, false, 0);
+		for (uint32_t frame = 0; frame < frameCount; frame += MIXER_BLOCK_FRAMES)
+		{
+			mixer->Mix(output, MIXER_BLOCK_FRAMES);
+		}
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+//Function: ToneLevel(const std::vector<int16_t>& samples, int channel)
+//Description: This method measures the RMS level of one side of converted samples against a full scale sine, leaving out the
+//first and last tenth of a second where the resampler reaches past the ends.
+//Returns: double = the level in dB.
+static double ToneLevel(const std::vector<int16_t>& samples, int channel)
+{
+	size_t frameCount = samples.size() / 2;
+	size_t edge = MIXER_SAMPLE_RATE / 10;
+	double sum = 0.0;
+	for (size_t frame = edge; frame + edge < frameCount; frame++)
+	{
+		double sample = samples[frame * 2 + channel] / 32768.0;
+		sum += sample * sample;
+	}
+
+	double rms = sqrt(sum / (frameCount - edge * 2));
+	return (rms > 0.0) ? 20.0 * log10(rms * sqrt(2.0)) : -INFINITY;
+}
+
+
+//Function: CheckConversion(const ConvertCase& convertCase, int repeats)
+//Description: This method makes a half scale tone in a format, converts it to the mix format with the steps ReadWaveFile takes
+//once a file is decoded, and prints how long that took per second of audio. A tone the resampler keeps must come out at the
+//level of the case on both sides, one it removes must be gone.
+//Returns: bool = whether the tone came out at the right level.
+static bool CheckConversion(const ConvertCase& convertCase, int repeats)
+{
+	size_t frameCount = (size_t)convertCase.sampleRate * CONVERT_SECONDS;
+	std::vector<float> interleaved(frameCount * convertCase.channels, 0.0f);
+	for (size_t frame = 0; frame < frameCount; frame++)
+	{
+		for (int channel = 0; channel < convertCase.channels; channel++)
+		{
+			if (convertCase.toneChannels & (1u << channel))
+			{
+				interleaved[frame * convertCase.channels + channel] =
+					(float)(0.5 * sin(2.0 * 3.14159265358979323846 * convertCase.frequency * frame / convertCase.sampleRate + channel));
+			}
+		}
+	}
+
+	std::vector<int16_t> samples;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		std::vector<float> left;
+		std::vector<float> right;
+		MixToStereo(interleaved, convertCase.channels, convertCase.channelMask, &left, &right);
+
+		if (convertCase.sampleRate != MIXER_SAMPLE_RATE)
+		{
+			std::vector<float> resampled;
+			Resample(left, convertCase.sampleRate, MIXER_SAMPLE_RATE, &resampled);
+			left.swap(resampled);
+			Resample(right, convertCase.sampleRate, MIXER_SAMPLE_RATE, &resampled);
+			right.swap(resampled);
+		}
+
+		QuantizeStereo(left, right, &samples);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+
+	double leftLevel = ToneLevel(samples, 0);
+	double rightLevel = ToneLevel(samples, 1);
+	printf("AudioBench: %5u Hz %d channels to the mix format takes %6.2f ms per second of audio, a %5.0f Hz tone comes out at %6.1f %6.1f dB\n",
+		convertCase.sampleRate, convertCase.channels, seconds * 1000.0 / CONVERT_SECONDS, convertCase.frequency, leftLevel, rightLevel);
+
+	size_t expectedFrames = ((uint64_t)frameCount * MIXER_SAMPLE_RATE + convertCase.sampleRate - 1) / convertCase.sampleRate;
+	if (samples.size() != expectedFrames * 2)
+	{
+		printf("AudioBench: %u Hz came out as %d frames, expected %d\n", convertCase.sampleRate, (int)(samples.size() / 2), (int)expectedFrames);
+		return false;
+	}
+
+	if (convertCase.removed)
+	{
+		if (leftLevel > CONVERT_ALIAS_LIMIT || rightLevel > CONVERT_ALIAS_LIMIT)
+		{
+			printf("AudioBench: a %.0f Hz tone at %u Hz was not removed\n", convertCase.frequency, convertCase.sampleRate);
+			return false;
+		}
+	}
+	else
+	{
+		if (fabs(leftLevel - convertCase.level) > CONVERT_LEVEL_TOLERANCE || fabs(rightLevel - convertCase.level) > CONVERT_LEVEL_TOLERANCE)
+		{
+			printf("AudioBench: a %.0f Hz tone at %u Hz did not come out at %.1f dB\n", convertCase.frequency, convertCase.sampleRate, convertCase.level);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//Function: main()
+//Description: This is the main method of the audio benchmark.
+//Returns: int = 0 if every sound mixed the same from its blocks as decoded up front and every tone converted right, 1 otherwise.
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printf("Usage: AudioBench <manifest> <asset directory> [repeats]\n");
+		return 1;
+	}
+
+	int repeats = (argc > 3) ? atoi(argv[3]) : 10;
+	if (repeats <= 0)
+		repeats = 1;
+
+	std::vector<std::string> fileNames;
+	if (!ReadManifestSounds(argv[1], argv[2], &fileNames))
+	{
+		printf("AudioBench: could not read %s\n", argv[1]);
+		return 1;
+	}
+
+	std::vector<BenchSound> sounds;
+	double totalFrames = 0.0;
+	size_t pcmBytes = 0;
+	size_t adpcmBytes = 0;
+	double encodeSeconds = 0.0;
+	for (size_t i = 0; i < fileNames.size(); i++)
+	{
+		WaveFile wave;
+		if (!ReadWaveFile(fileNames[i].c_str(), &wave) || !wave.frameCount)
+		{
+			printf("AudioBench: could not read %s\n", fileNames[i].c_str());
+			return 1;
+		}
+
+		BenchSound sound;
+		sound.name = fileNames[i];
+		sound.samples.swap(wave.samples);
+		sound.frameCount = wave.frameCount;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		AdpcmEncode(sound.samples.data(), sound.frameCount, &sound.encoded);
+		encodeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		sound.decoded.resize(sound.encoded.size() / ADPCM_BLOCK_BYTES * ADPCM_BLOCK_FRAMES * MIXER_CHANNELS);
+		DecodeAll(sound, sound.decoded.data());
+
+		totalFrames += sound.frameCount;
+		pcmBytes += sound.samples.size() * sizeof(int16_t);
+		adpcmBytes += sound.encoded.size();
+		sounds.push_back(sound);
+	}
+
+	double audioSeconds = totalFrames / MIXER_SAMPLE_RATE;
+	printf("AudioBench: %d sounds, %.1f s of audio, %.2f MB as 16 bit samples, %.2f MB as ADPCM, %.1f%%\n", (int)sounds.size(), audioSeconds,
+		pcmBytes / (1024.0 * 1024.0), adpcmBytes / (1024.0 * 1024.0), pcmBytes ? 100.0 * adpcmBytes / pcmBytes : 0.0);
+
+	//How far the decoded sounds are from the originals, as a signal to noise ratio over all of them
+	double signal = 0.0;
+	double noise = 0.0;
+	for (size_t i = 0; i < sounds.size(); i++)
+	{
+		for (size_t s = 0; s < sounds[i].samples.size(); s++)
+		{
+			double original = sounds[i].samples[s];
+			double error = original - sounds[i].decoded[s];
+			signal += original * original;
+			noise += error * error;
+		}
+	}
+	printf("AudioBench: encoding took %.1f ms, %.2f ms per second of audio, SNR %.1f dB\n", encodeSeconds * 1000.0,
+		encodeSeconds * 1000.0 / audioSeconds, (noise > 0.0) ? 10.0 * log10(signal / noise) : INFINITY);
+
+	//Decoding on its own, into a buffer the size of the sound
+	std::vector<int16_t> scratch;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		for (size_t i = 0; i < sounds.size(); i++)
+		{
+			scratch.resize(sounds[i].decoded.size());
+			DecodeAll(sounds[i], scratch.data());
+		}
+	}
+	double decodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+	printf("AudioBench: decoding takes %.1f us per second of audio, %.2f ns per sample\n", decodeSeconds * 1e6 / audioSeconds,
+		decodeSeconds * 1e9 / (totalFrames * MIXER_CHANNELS));
+
+	//Mixing a voice with and without decoding, the difference is what decoding as it plays costs
+	AudioMixer* mixer = new AudioMixer();
+	double pcmSeconds = 0.0;
+	double adpcmSeconds = 0.0;
+	for (size_t i = 0; i < sounds.size(); i++)
+	{
+		MixerSound pcm = { sounds[i].samples.data(), sounds[i].frameCount, MixerPCM16 };
+		MixerSound adpcm = { sounds[i].encoded.data(), sounds[i].frameCount, MixerADPCM };
+		pcmSeconds += TimeMixing(mixer, pcm, sounds[i].frameCount, repeats) / repeats;
+		adpcmSeconds += TimeMixing(mixer, adpcm, sounds[i].frameCount, repeats) / repeats;
+	}
+	printf("AudioBench: mixing a voice takes %.1f us per second of audio from 16 bit samples, %.1f us from ADPCM\n",
+		pcmSeconds * 1e6 / audioSeconds, adpcmSeconds * 1e6 / audioSeconds);
+
+	//Decoding as it plays must not change a sample, across block edges, loops and pitches
+	const float pitches[] = { 1.0f, 0.7f, 1.37f, 3.1f };
+	std::vector<int16_t> fromBlocks(COMPARE_FRAMES * MIXER_CHANNELS);
+	std::vector<int16_t> fromSamples(COMPARE_FRAMES * MIXER_CHANNELS);
+	for (size_t i = 0; i < sounds.size(); i++)
+	{
+		MixerSound decoded = { sounds[i].decoded.data(), sounds[i].frameCount, MixerPCM16 };
+		MixerSound adpcm = { sounds[i].encoded.data(), sounds[i].frameCount, MixerADPCM };
+		for (size_t p = 0; p < sizeof(pitches) / sizeof(pitches[0]); p++)
+		{
+			for (int looping = 0; looping < 2; looping++)
+			{
+				MixSound(mixer, adpcm, pitches[p], looping != 0, fromBlocks.data());
+				MixSound(mixer, decoded, pitches[p], looping != 0, fromSamples.data());
+				if (fromBlocks != fromSamples)
+				{
+					printf("AudioBench: %s mixes differently from its blocks at pitch %g%s\n", sounds[i].name.c_str(), pitches[p],
+						looping ? ", looping" : "");
+					return 1;
+				}
+			}
+		}
+	}
+	printf("AudioBench: every sound mixes the same from its blocks as decoded up front at %d pitches\n", (int)(sizeof(pitches) / sizeof(pitches[0])));
+
+	for (size_t i = 0; i < sizeof(convertCases) / sizeof(convertCases[0]); i++)
+	{
+		if (!CheckConversion(convertCases[i], repeats))
+			return 1;
+	}
+
+	return 0;
+}
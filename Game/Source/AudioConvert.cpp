@@ -0,0 +1,263 @@
+/*
+File Name:		AudioConvert.cpp
+Description:	This file holds the definition of the audio conversions: the stereo downmix, the polyphase windowed-sinc resampler
+				and the conversion back to 16 bit samples.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/AudioConvert.h"
+#include <math.h>
+#include <algorithm>
+
+//SSE2 is always there on x64, elsewhere the filter runs one tap at a time
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+	#define CONVERT_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define CONVERT_SSE2 0
+#endif
+
+#define CONVERT_PI 3.14159265358979323846
+
+
+//Function: DefaultChannelMask(int channels)
+//Description: This method picks the speaker layout files without a channel mask are assumed to have, the usual one for their
+//channel count.
+//Returns: uint32_t = the speaker bits.
+uint32_t DefaultChannelMask(int channels)
+{
+	const uint32_t front = SpeakerFrontLeft | SpeakerFrontRight;
+	const uint32_t back = SpeakerBackLeft | SpeakerBackRight;
+	switch (channels)
+	{
+	case 1:
+		return SpeakerFrontCenter;
+	case 2:
+		return front;
+	case 3:
+		return front | SpeakerFrontCenter;
+	case 4:
+		return front | back;
+	case 5:
+		return front | SpeakerFrontCenter | back;
+	case 6:
+		return front | SpeakerFrontCenter | SpeakerLowFrequency | back;
+	case 7:
+		return front | SpeakerFrontCenter | SpeakerLowFrequency | back | SpeakerBackCenter;
+	default:
+		return front | SpeakerFrontCenter | SpeakerLowFrequency | back | SpeakerSideLeft | SpeakerSideRight;
+	}
+}
+
+
+//Function: SpeakerGains(uint32_t speaker, float* left, float* right)
+//Description: This method finds how much of a speaker goes to each side of the downmix. Centre and surround speakers are folded
+//in 3dB down, the way ITU-R BS.775 does, and the low frequency channel is left out.
+//Returns: void.
+static void SpeakerGains(uint32_t speaker, float* left, float* right)
+{
+	const float folded = 0.70710678f;
+	*left = 0.0f;
+	*right = 0.0f;
+
+	switch (speaker)
+	{
+	case SpeakerFrontLeft:
+	case SpeakerFrontLeftOfCenter:
+		*left = 1.0f;
+		break;
+	case SpeakerFrontRight:
+	case SpeakerFrontRightOfCenter:
+		*right = 1.0f;
+		break;
+	case SpeakerFrontCenter:
+	case SpeakerBackCenter:
+		*left = folded;
+		*right = folded;
+		break;
+	case SpeakerBackLeft:
+	case SpeakerSideLeft:
+		*left = folded;
+		break;
+	case SpeakerBackRight:
+	case SpeakerSideRight:
+		*right = folded;
+		break;
+	case SpeakerLowFrequency:
+		break;
+	default:
+		//Top and other speakers are split evenly
+		*left = 0.5f;
+		*right = 0.5f;
+		break;
+	}
+}
+
+
+//Function: MixToStereo(const std::vector<float>& interleaved, int channels, uint32_t channelMask, std::vector<float>* left, std::vector<float>* right)
+//Description: This method mixes interleaved frames of any number of channels down to separate left and right channels. Mono
+//goes to both sides at full level. The channels of a file are its mask's speakers in order, channels past those are dropped.
+//Returns: void.
+void MixToStereo(const std::vector<float>& interleaved, int channels, uint32_t channelMask, std::vector<float>* left, std::vector<float>* right)
+{
+	size_t frameCount = interleaved.size() / channels;
+	left->assign(frameCount, 0.0f);
+	right->assign(frameCount, 0.0f);
+
+	if (!channelMask)
+	{
+		channelMask = DefaultChannelMask(channels);
+	}
+
+	float leftGains[32] = {};
+	float rightGains[32] = {};
+	uint32_t remaining = channelMask;
+	for (int channel = 0; channel < channels && channel < 32 && remaining; channel++)
+	{
+		uint32_t speaker = remaining & (~remaining + 1);
+		remaining &= ~speaker;
+		SpeakerGains(speaker, &leftGains[channel], &rightGains[channel]);
+	}
+
+	if (channels == 1)
+	{
+		leftGains[0] = 1.0f;
+		rightGains[0] = 1.0f;
+	}
+
+	for (size_t frame = 0; frame < frameCount; frame++)
+	{
+		const float* samples = &interleaved[frame * channels];
+		float leftSum = 0.0f;
+		float rightSum = 0.0f;
+		for (int channel = 0; channel < channels && channel < 32; channel++)
+		{
+			leftSum += samples[channel] * leftGains[channel];
+			rightSum += samples[channel] * rightGains[channel];
+		}
+
+		(*left)[frame] = leftSum;
+		(*right)[frame] = rightSum;
+	}
+}
+
+
+//Function: DotProduct(const float* a, const float* b, int count)
+//Description: This method multiplies two runs of floats and sums the products. The count is a multiple of 4.
+//Returns: float = the sum.
+static float DotProduct(const float* a, const float* b, int count)
+{
+#if CONVERT_SSE2
+	__m128 sum = _mm_setzero_ps();
+	for (int i = 0; i < count; i += 4)
+	{
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	}
+
+	//Add the four lanes together
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+	return _mm_cvtss_f32(sum);
+#else
+	float sum = 0.0f;
+	for (int i = 0; i < count; i++)
+	{
+		sum += a[i] * b[i];
+	}
+	return sum;
+#endif
+}
+
+
+//Function: Resample(const std::vector<float>& input, uint32_t inputRate, uint32_t outputRate, std::vector<float>* output)
+//Description: This method resamples one channel with a Blackman windowed-sinc filter. The filter is tabulated at
+//RESAMPLE_PHASES + 1 points between two input samples. Every output sample is blended between the two rows either side of
+//where it falls, and each row is a run of taps the SIMD dot product takes in one go.
+//Returns: void.
+void Resample(const std::vector<float>& input, uint32_t inputRate, uint32_t outputRate, std::vector<float>* output)
+{
+	if (inputRate == outputRate || input.empty())
+	{
+		*output = input;
+		return;
+	}
+
+	//Going down, the cutoff drops to the new Nyquist frequency and the filter widens to match. A little is kept back for the
+	//transition band, so it is all below Nyquist.
+	double ratio = (double)outputRate / inputRate;
+	double cutoff = ((ratio < 1.0) ? ratio : 1.0) * 0.92;
+	int halfTaps = (int)ceil(RESAMPLE_HALF_TAPS / ((ratio < 1.0) ? ratio : 1.0));
+	int taps = (halfTaps * 2 + 3) & ~3;
+
+	//Row p holds the taps for an output sample p / RESAMPLE_PHASES of the way past input sample i, tap k weighs input
+	//sample i - halfTaps + 1 + k. Each row is scaled to sum to one, so a constant signal keeps its level.
+	std::vector<float> filter((size_t)(RESAMPLE_PHASES + 1) * taps, 0.0f);
+	for (int phase = 0; phase <= RESAMPLE_PHASES; phase++)
+	{
+		float* row = &filter[(size_t)phase * taps];
+		double offset = (double)phase / RESAMPLE_PHASES;
+		double sum = 0.0;
+		for (int k = 0; k < halfTaps * 2; k++)
+		{
+			double x = (double)(k - halfTaps + 1) - offset;
+			if (fabs(x) >= halfTaps)
+				continue;
+
+			double sinc = (x == 0.0) ? 1.0 : sin(CONVERT_PI * cutoff * x) / (CONVERT_PI * cutoff * x);
+			double window = 0.42 + 0.5 * cos(CONVERT_PI * x / halfTaps) + 0.08 * cos(2.0 * CONVERT_PI * x / halfTaps);
+			row[k] = (float)(sinc * window);
+			sum += row[k];
+		}
+
+		for (int k = 0; k < taps; k++)
+		{
+			row[k] = (float)(row[k] / sum);
+		}
+	}
+
+	//Silence either side of the input, so the filter can reach past both ends
+	std::vector<float> padded(input.size() + (size_t)taps * 2, 0.0f);
+	std::copy(input.begin(), input.end(), padded.begin() + taps);
+
+	size_t outputCount = (size_t)(((uint64_t)input.size() * outputRate + inputRate - 1) / inputRate);
+	output->resize(outputCount);
+	for (size_t i = 0; i < outputCount; i++)
+	{
+		//Where the output sample falls in the input, worked out exactly, so long sounds do not drift
+		uint64_t scaled = (uint64_t)i * inputRate;
+		uint64_t index = scaled / outputRate;
+		double fraction = (double)(scaled % outputRate) / outputRate * RESAMPLE_PHASES;
+		int phase = (int)fraction;
+		float blend = (float)(fraction - phase);
+
+		const float* samples = &padded[(size_t)index + taps - halfTaps + 1];
+		float a = DotProduct(&filter[(size_t)phase * taps], samples, taps);
+		float b = DotProduct(&filter[(size_t)(phase + 1) * taps], samples, taps);
+		(*output)[i] = a + (b - a) * blend;
+	}
+}
+
+
+//Function: QuantizeStereo(const std::vector<float>& left, const std::vector<float>& right, std::vector<int16_t>* interleaved)
+//Description: This method turns left and right channels in the range -1 to 1 back into interleaved 16 bit samples, clipping
+//anything past full scale. 16 bit input comes back exactly as it was.
+//Returns: void.
+void QuantizeStereo(const std::vector<float>& left, const std::vector<float>& right, std::vector<int16_t>* interleaved)
+{
+	size_t frameCount = (left.size() < right.size()) ? left.size() : right.size();
+	interleaved->resize(frameCount * 2);
+
+	for (size_t frame = 0; frame < frameCount; frame++)
+	{
+		for (int channel = 0; channel < 2; channel++)
+		{
+			float sample = ((channel == 0) ? left[frame] : right[frame]) * 32768.0f;
+			if (sample < -32768.0f)
+				sample = -32768.0f;
+			if (sample > 32767.0f)
+				sample = 32767.0f;
+			(*interleaved)[frame * 2 + channel] = (int16_t)lrintf(sample);
+		}
+	}
+}
@@ -0,0 +1,216 @@
+/*
+File Name:		BroadphaseBench.cpp
+Description:	This file is the broadphase benchmark. It builds a battle far bigger than any sector, 500 enemies wandering
+				a 1920x1080 screen and 5000 player rockets flying across it, and every step collides the rockets with the
+				enemies twice: once through the enemy grid and CollideBoxes the way RunRockets does, and once with the loop
+				the game had before the grid, every rocket against every enemy with CheckCollision. Rockets are not exploded
+				by their hits so both sides see the same battle. The hits of both sides must agree on every step.
+				Usage: BroadphaseBench [steps]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+#include "../Include/Simulation.h"
+#include "../Include/Grid.h"
+#include "../Include/Collision.h"
+#include "../Include/Rocket.h"
+
+#define BENCH_DT (1.0f / 60.0f)
+#define BENCH_WIDTH 1920
+#define BENCH_HEIGHT 1080
+#define BENCH_ENEMIES 500
+#define BENCH_ROCKETS 5000
+
+//Enemies are smaller than the tile sized ships of a sector, so the crowd still leaves room to fly through
+#define BENCH_SHIP_SIZE 40.0f
+
+
+//Function: RandomPosition()
+//Description: This method picks a random point on the screen.
+//Returns: Vector2 = the point.
+static Vector2 RandomPosition()
+{
+	return Vector2{ (float)(rand() % BENCH_WIDTH), (float)(rand() % BENCH_HEIGHT) };
+}
+
+
+//Function: FireRocket(FixedRocketPool<Capacity>* rockets)
+//Description: This method fires a player rocket from a random point in a random direction, with the first player ability.
+//Returns: void.
+template <int Capacity>
+static void FireRocket(FixedRocketPool<Capacity>* rockets)
+{
+	float angle = (float)(rand() % 3600) * (VECTOR_PI / 1800.0f);
+	rockets->Fire(RandomPosition(), playerRocket1.rocketSize, Vector2{ cosf(angle), sinf(angle) }, SpritePlayerRocket, (float)playerRocket1.speed, playerRocket1.damage);
+}
+
+
+//Function: CollideGrid(FixedRocketPool<BENCH_ROCKETS>* rockets, ShipGrid* grid, BoxArray* enemyBoxes, int* rocketHits)
+//Description: This method collides every rocket with the enemies near it, the way RunRockets does, and stores how many enemies
+//each rocket hit.
+//Returns: int = the number of rocket and enemy pairs that overlap.
+static int CollideGrid(FixedRocketPool<BENCH_ROCKETS>* rockets, ShipGrid* grid, BoxArray* enemyBoxes, int* rocketHits)
+{
+	int hits = 0;
+	for (int r = 0; r < rockets->count; r++)
+	{
+		Vector2 rocketPosition = rockets->position[r];
+		Vector2 rocketSize = rockets->size[r];
+		std::vector<Ship*>& nearbyEnemies = grid->Query(rocketPosition.x - (rocketSize.x / 2), rocketPosition.y - (rocketSize.y / 2), rocketSize.x, rocketSize.y);
+
+		enemyBoxes->Clear();
+		for (size_t i = 0, size = nearbyEnemies.size(); i != size; i++)
+		{
+			Ship* enemy = nearbyEnemies[i];
+			enemyBoxes->Add(enemy->position.x - (enemy->size.x / 2), enemy->position.y - (enemy->size.y / 2), enemy->size.x, enemy->size.y);
+		}
+		rocketHits[r] = CollideBoxes(rocketPosition.x - (rocketSize.x / 2), rocketPosition.y - (rocketSize.y / 2), rocketSize.x, rocketSize.y, enemyBoxes);
+		hits += rocketHits[r];
+	}
+
+	return hits;
+}
+
+
+//Function: CollideAll(FixedRocketPool<BENCH_ROCKETS>* rockets, std::vector<Ship*>& enemies, int* rocketHits)
+//Description: This method collides every rocket with every enemy, the way the game did before the grid, and stores how many
+//enemies each rocket hit.
+//Returns: int = the number of rocket and enemy pairs that overlap.
+static int CollideAll(FixedRocketPool<BENCH_ROCKETS>* rockets, std::vector<Ship*>& enemies, int* rocketHits)
+{
+	int hits = 0;
+	for (int r = 0; r < rockets->count; r++)
+	{
+		rocketHits[r] = 0;
+		Vector2 rocketPosition = rockets->position[r];
+		Vector2 rocketSize = rockets->size[r];
+		for (size_t i = 0, size = enemies.size(); i != size; i++)
+		{
+			Ship* enemy = enemies[i];
+			if (CheckCollision(rocketPosition.x - (rocketSize.x / 2), rocketPosition.y - (rocketSize.y / 2), rocketSize.x, rocketSize.y,
+				enemy->position.x - (enemy->size.x / 2), enemy->position.y - (enemy->size.y / 2), enemy->size.x, enemy->size.y))
+			{
+				rocketHits[r]++;
+				hits++;
+			}
+		}
+	}
+
+	return hits;
+}
+
+
+//Function: main()
+//Description: This is the main method of the broadphase benchmark.
+//Returns: int = 0 if the grid found the same hits as the full loop on every step, 1 otherwise.
+int main(int argc, char** argv)
+{
+	int steps = (argc > 1) ? atoi(argv[1]) : 300;
+	if (steps <= 0)
+	{
+		printf("Usage: BroadphaseBench [steps]\n");
+		return 1;
+	}
+
+	srand(1);
+
+	//Laid out like the grid of a sector, TILE_SIZE tiles across the screen
+	ShipGrid grid;
+	grid.Initialize(TILE_SIZE, TILE_SIZE, (float)(BENCH_WIDTH / TILE_SIZE), (float)(BENCH_HEIGHT / TILE_SIZE));
+
+	Ability abilities[NUM_ABILITIES] = { enemy1Rocket1, enemy1Rocket2, enemy1Rocket3 };
+	std::vector<Ship*> enemies;
+	for (int i = 0; i < BENCH_ENEMIES; i++)
+	{
+		Ship* enemy = new Ship(SHIP_ENEMY_SPEED, RandomPosition(), Vector2{ BENCH_SHIP_SIZE, BENCH_SHIP_SIZE }, (SpriteId)(SpriteEnemy + 1), 100, abilities, 0);
+		enemy->destination = RandomPosition();
+		enemies.push_back(enemy);
+	}
+
+	FixedRocketPool<BENCH_ROCKETS>* rockets = new FixedRocketPool<BENCH_ROCKETS>();
+	rockets->Clear();
+	while (rockets->count < BENCH_ROCKETS)
+	{
+		FireRocket(rockets);
+	}
+
+	BoxArray enemyBoxes;
+	enemyBoxes.Clear();
+	std::vector<int> gridRocketHits(BENCH_ROCKETS);
+	std::vector<int> allRocketHits(BENCH_ROCKETS);
+
+	double gridSeconds = 0.0;
+	double allSeconds = 0.0;
+	long long totalHits = 0;
+	for (int step = 0; step < steps; step++)
+	{
+		//Wander the enemies and keep the grid up to date, like RunEnemies does
+		for (size_t i = 0; i < enemies.size(); i++)
+		{
+			Ship* enemy = enemies[i];
+			if (Magnitude(enemy->destination - enemy->position) <= SHIP_NEAR_THRESHOLD)
+			{
+				enemy->destination = RandomPosition();
+			}
+			enemy->MoveTowardDestination(BENCH_DT);
+		}
+
+		//Rockets that leave the screen are fired again somewhere else, so the count stays up
+		rockets->MoveInDirection(BENCH_DT);
+		int rocketIndex = 0;
+		while (rocketIndex < rockets->count)
+		{
+			Vector2 position = rockets->position[rocketIndex];
+			if (position.x < 0.0f || position.x > BENCH_WIDTH || position.y < 0.0f || position.y > BENCH_HEIGHT)
+			{
+				rockets->Remove(rocketIndex);
+				continue;
+			}
+			rocketIndex++;
+		}
+		while (rockets->count < BENCH_ROCKETS)
+		{
+			FireRocket(rockets);
+		}
+
+		//Updating the grid is part of what the broadphase costs
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < enemies.size(); i++)
+		{
+			grid.Update(enemies[i]);
+		}
+		int gridHits = CollideGrid(rockets, &grid, &enemyBoxes, &gridRocketHits[0]);
+		std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+		int allHits = CollideAll(rockets, enemies, &allRocketHits[0]);
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		gridSeconds += std::chrono::duration<double>(middle - start).count();
+		allSeconds += std::chrono::duration<double>(end - middle).count();
+		totalHits += allHits;
+
+		if (gridHits != allHits)
+		{
+			printf("BroadphaseBench: step %d: the grid found %d hits, the full loop %d\n", step, gridHits, allHits);
+			return 1;
+		}
+		for (int r = 0; r < rockets->count; r++)
+		{
+			if (gridRocketHits[r] != allRocketHits[r])
+			{
+				printf("BroadphaseBench: step %d: rocket %d hit %d enemies through the grid, %d in the full loop\n", step, r, gridRocketHits[r], allRocketHits[r]);
+				return 1;
+			}
+		}
+	}
+
+	printf("BroadphaseBench: %d enemies, %d rockets, %d steps, %lld hits found by both\n", BENCH_ENEMIES, BENCH_ROCKETS, steps, totalHits);
+	printf("BroadphaseBench: every rocket against every enemy %8.3f ms per step\n", allSeconds * 1000.0 / steps);
+	printf("BroadphaseBench: grid and CollideBoxes           %8.3f ms per step, %.1fx\n", gridSeconds * 1000.0 / steps,
+		(gridSeconds > 0.0) ? allSeconds / gridSeconds : 0.0);
+	return 0;
+}
@@ -0,0 +1,30 @@
+/*
+File Name:		Clock.cpp
+Description:	This file holds the definition of the simulation clock and the methods to advance and query it.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Clock.h"
+
+
+//Function: Advance(float dt)
+//Description: This method moves the clock forward by dt seconds, keeping the part that does not make a whole millisecond.
+//Returns: void.
+void GameClock::Advance(float dt)
+{
+	this->carry += dt * 1000.0f;
+
+	GameTime milliseconds = (GameTime)this->carry;
+	this->now += milliseconds;
+	this->carry -= (float)milliseconds;
+}
+
+
+//Function: Since(GameTime time)
+//Description: This method gets how long ago a time was.
+//Returns: GameTime = the milliseconds between time and now.
+GameTime GameClock::Since(GameTime time) const
+{
+	return this->now - time;
+}
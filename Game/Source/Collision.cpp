@@ -0,0 +1,225 @@
+/*
+File Name:		Collision.cpp
+Description:	This file holds the batched collision kernels and the runtime selection between them. The SIMD kernels do the same
+				compares as CheckCollision, in the same order and on the same float values, so they never disagree with it.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Collision.h"
+#include <math.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define COLLISION_X86 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define COLLISION_TARGET_AVX
+	#else
+		#define COLLISION_TARGET_AVX __attribute__((target("avx")))
+	#endif
+#else
+	#define COLLISION_X86 0
+#endif
+
+typedef void CollideFunction(float x1, float y1, float maxX1, float maxY1, BoxArray* boxes);
+
+static CollideFunction* collideKernel = 0;
+
+
+//Function: Clear()
+//Description: This method removes every box from the array. The memory is kept so refilling it does not allocate.
+//Returns: void.
+void BoxArray::Clear()
+{
+	this->count = 0;
+	this->minX.clear();
+	this->minY.clear();
+	this->maxX.clear();
+	this->maxY.clear();
+}
+
+
+//Function: Add(float x, float y, float width, float height)
+//Description: This method appends a box. When a new block is started it is filled with boxes that cannot overlap anything,
+//which the box then overwrites one at a time.
+//Returns: void.
+void BoxArray::Add(float x, float y, float width, float height)
+{
+	if (this->count % BOX_BLOCK_SIZE == 0)
+	{
+		this->minX.insert(this->minX.end(), BOX_BLOCK_SIZE, INFINITY);
+		this->minY.insert(this->minY.end(), BOX_BLOCK_SIZE, INFINITY);
+		this->maxX.insert(this->maxX.end(), BOX_BLOCK_SIZE, -INFINITY);
+		this->maxY.insert(this->maxY.end(), BOX_BLOCK_SIZE, -INFINITY);
+	}
+
+	int index = this->count++;
+	this->minX[index] = x;
+	this->minY[index] = y;
+	this->maxX[index] = x + width;
+	this->maxY[index] = y + height;
+}
+
+
+//Function: Hit(int index)
+//Description: This method checks the bit CollideBoxes set for a box.
+//Returns: bool = whether the box was hit by the last test.
+bool BoxArray::Hit(int index) const
+{
+	return (this->hitMask[index / 32] >> (index % 32)) & 1;
+}
+
+
+//Function: CollideBoxesScalar()
+//Description: This method tests the boxes one at a time, exactly like CheckCollision does.
+//Returns: void.
+static void CollideBoxesScalar(float x1, float y1, float maxX1, float maxY1, BoxArray* boxes)
+{
+	for (int i = 0; i < boxes->count; i++)
+	{
+		if (maxX1 < boxes->minX[i] || x1 > boxes->maxX[i])
+			continue;
+		if (maxY1 < boxes->minY[i] || y1 > boxes->maxY[i])
+			continue;
+
+		boxes->hitMask[i / 32] |= 1u << (i % 32);
+	}
+}
+
+
+#if COLLISION_X86
+
+//Function: CollideBoxesSSE2()
+//Description: This method tests 4 boxes at a time. A box is missed if any of the 4 edge compares of CheckCollision is true.
+//Returns: void.
+static void CollideBoxesSSE2(float x1, float y1, float maxX1, float maxY1, BoxArray* boxes)
+{
+	__m128 x = _mm_set1_ps(x1);
+	__m128 y = _mm_set1_ps(y1);
+	__m128 maxX = _mm_set1_ps(maxX1);
+	__m128 maxY = _mm_set1_ps(maxY1);
+
+	for (int i = 0; i < boxes->count; i += 4)
+	{
+		__m128 miss = _mm_or_ps(_mm_cmplt_ps(maxX, _mm_loadu_ps(&boxes->minX[i])), _mm_cmpgt_ps(x, _mm_loadu_ps(&boxes->maxX[i])));
+		miss = _mm_or_ps(miss, _mm_cmplt_ps(maxY, _mm_loadu_ps(&boxes->minY[i])));
+		miss = _mm_or_ps(miss, _mm_cmpgt_ps(y, _mm_loadu_ps(&boxes->maxY[i])));
+
+		uint32_t hits = ~_mm_movemask_ps(miss) & 0xF;
+		boxes->hitMask[i / 32] |= hits << (i % 32);
+	}
+}
+
+
+//Function: CollideBoxesAVX()
+//Description: This method tests 8 boxes at a time, the same way as the SSE2 kernel. The compares are ordered so NaNs behave like
+//the scalar compares.
+//Returns: void.
+COLLISION_TARGET_AVX static void CollideBoxesAVX(float x1, float y1, float maxX1, float maxY1, BoxArray* boxes)
+{
+	__m256 x = _mm256_set1_ps(x1);
+	__m256 y = _mm256_set1_ps(y1);
+	__m256 maxX = _mm256_set1_ps(maxX1);
+	__m256 maxY = _mm256_set1_ps(maxY1);
+
+	for (int i = 0; i < boxes->count; i += 8)
+	{
+		__m256 miss = _mm256_or_ps(_mm256_cmp_ps(maxX, _mm256_loadu_ps(&boxes->minX[i]), _CMP_LT_OQ), _mm256_cmp_ps(x, _mm256_loadu_ps(&boxes->maxX[i]), _CMP_GT_OQ));
+		miss = _mm256_or_ps(miss, _mm256_cmp_ps(maxY, _mm256_loadu_ps(&boxes->minY[i]), _CMP_LT_OQ));
+		miss = _mm256_or_ps(miss, _mm256_cmp_ps(y, _mm256_loadu_ps(&boxes->maxY[i]), _CMP_GT_OQ));
+
+		uint32_t hits = ~_mm256_movemask_ps(miss) & 0xFF;
+		boxes->hitMask[i / 32] |= hits << (i % 32);
+	}
+}
+
+#endif
+
+
+//Function: SelectCollisionKernel()
+//Description: This method picks the widest kernel the CPU and the OS support.
+//Returns: CollisionKernel = the kernel that will be used.
+CollisionKernel SelectCollisionKernel()
+{
+	CollisionKernel kernel = CollisionScalar;
+
+#if COLLISION_X86
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		bool sse2 = (info[3] & (1 << 26)) != 0;
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		bool avx = (info[2] & (1 << 28)) != 0;
+
+		//The OS has to save the YMM registers on context switches for AVX to be usable
+		if (osxsave && avx && (_xgetbv(0) & 6) == 6)
+			kernel = CollisionAVX;
+		else if (sse2)
+			kernel = CollisionSSE2;
+	#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx"))
+			kernel = CollisionAVX;
+		else if (__builtin_cpu_supports("sse2"))
+			kernel = CollisionSSE2;
+	#endif
+#endif
+
+	SetCollisionKernel(kernel);
+	return kernel;
+}
+
+
+//Function: SetCollisionKernel(CollisionKernel kernel)
+//Description: This method forces a kernel, mostly to compare them. Kernels that were not compiled in fall back to the scalar one.
+//Returns: void.
+void SetCollisionKernel(CollisionKernel kernel)
+{
+	collideKernel = CollideBoxesScalar;
+
+#if COLLISION_X86
+	if (kernel == CollisionSSE2)
+		collideKernel = CollideBoxesSSE2;
+	else if (kernel == CollisionAVX)
+		collideKernel = CollideBoxesAVX;
+#endif
+}
+
+
+//Function: CollideBoxes(float x, float y, float width, float height, BoxArray* boxes)
+//Description: This method tests one box against every box in the array and sets the hit bit of every box it overlaps.
+//Returns: int = the number of boxes hit.
+int CollideBoxes(float x, float y, float width, float height, BoxArray* boxes)
+{
+	if (!collideKernel)
+	{
+		SelectCollisionKernel();
+	}
+
+	int words = (boxes->count + 31) / 32;
+	boxes->hitMask.assign(words, 0);
+	if (words == 0)
+		return 0;
+
+	collideKernel(x, y, x + width, y + height, boxes);
+
+	//The padding boxes never overlap a real box, but a NaN box would hit them, so only keep the bits of real boxes
+	if (boxes->count % 32 != 0)
+	{
+		boxes->hitMask[words - 1] &= (1u << (boxes->count % 32)) - 1;
+	}
+
+	int hits = 0;
+	for (int i = 0; i < words; i++)
+	{
+		uint32_t mask = boxes->hitMask[i];
+		while (mask)
+		{
+			mask &= mask - 1;
+			hits++;
+		}
+	}
+
+	return hits;
+}
@@ -0,0 +1,175 @@
+/*
+File Name:		CollisionCheck.cpp
+Description:	This file is the collision kernel check. It tests random boxes and edge cases with every kernel the CPU can run
+				and compares each hit bit, and the hit count, with CheckCollision on the same two boxes. The random boxes sit on
+				a small integer grid so edges often touch exactly, the edge cases add zero and negative sizes, infinite and
+				huge edges, and NaNs. Every count from 0 to 70 is tested, so most arrays end partway into a block and the
+				infinite padding boxes after them go through the kernels too.
+				Usage: CollisionCheck [rounds]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+
+#include "../Include/Simulation.h"
+#include "../Include/Collision.h"
+
+#define CHECK_MAX_COUNT 70
+
+//A box as x, y, width and height, the way CollideBoxes and CheckCollision take them
+struct CheckBox
+{
+	float x;
+	float y;
+	float width;
+	float height;
+};
+
+static const char* kernelNames[] = { "scalar", "SSE2", "AVX" };
+
+
+//Function: RandomValue(bool edgeCases)
+//Description: This method picks a coordinate on a small integer grid, or with edge cases on, sometimes one of the values the
+//kernels could get wrong.
+//Returns: float = the value.
+static float RandomValue(bool edgeCases)
+{
+	static const float special[] = { 0.0f, -0.0f, INFINITY, -INFINITY, FLT_MAX, -FLT_MAX, FLT_MIN, 1e-45f, 0.5f, -0.5f };
+
+	if (edgeCases && rand() % 4 == 0)
+	{
+		return special[rand() % (sizeof(special) / sizeof(special[0]))];
+	}
+
+	return (float)(rand() % 24 - 4);
+}
+
+
+//Function: RandomBox(bool edgeCases, bool nans)
+//Description: This method makes a random box. Sizes can be zero or negative, and with nans on a value is sometimes NaN.
+//Returns: CheckBox = the box.
+static CheckBox RandomBox(bool edgeCases, bool nans)
+{
+	CheckBox box;
+	box.x = RandomValue(edgeCases);
+	box.y = RandomValue(edgeCases);
+	box.width = RandomValue(edgeCases) / 2.0f;
+	box.height = RandomValue(edgeCases) / 2.0f;
+
+	if (nans && rand() % 8 == 0)
+	{
+		float* values = &box.x;
+		values[rand() % 4] = NAN;
+	}
+
+	return box;
+}
+
+
+//Function: CheckBoxes(CollisionKernel kernel, CheckBox test, const CheckBox* boxes, int count, BoxArray* array)
+//Description: This method tests one box against the boxes with a kernel and compares the result with CheckCollision.
+//Returns: bool = whether the kernel agreed with CheckCollision on every box and on the count, and the padding was missed.
+static bool CheckBoxes(CollisionKernel kernel, CheckBox test, const CheckBox* boxes, int count, BoxArray* array)
+{
+	array->Clear();
+	for (int i = 0; i < count; i++)
+	{
+		array->Add(boxes[i].x, boxes[i].y, boxes[i].width, boxes[i].height);
+	}
+
+	SetCollisionKernel(kernel);
+	int hits = CollideBoxes(test.x, test.y, test.width, test.height, array);
+
+	int expectedHits = 0;
+	for (int i = 0; i < count; i++)
+	{
+		bool expected = CheckCollision(test.x, test.y, test.width, test.height, boxes[i].x, boxes[i].y, boxes[i].width, boxes[i].height);
+		expectedHits += expected ? 1 : 0;
+
+		if (array->Hit(i) != expected)
+		{
+			printf("CollisionCheck: %s kernel, box %d of %d: (%g %g %g %g) against (%g %g %g %g) gave %d, CheckCollision %d\n",
+				kernelNames[kernel], i, count, test.x, test.y, test.width, test.height, boxes[i].x, boxes[i].y, boxes[i].width,
+				boxes[i].height, array->Hit(i), expected);
+			return false;
+		}
+	}
+
+	//The padding boxes are what keeps the kernels from hitting past the count, so a test box without NaNs must miss every one
+	bool testNaN = isnan(test.x) || isnan(test.y) || isnan(test.width) || isnan(test.height);
+	for (int i = count; !testNaN && i < (int)array->minX.size(); i++)
+	{
+		if (!(test.x + test.width < array->minX[i] || test.x > array->maxX[i] || test.y + test.height < array->minY[i] || test.y > array->maxY[i]))
+		{
+			printf("CollisionCheck: (%g %g %g %g) overlaps padding box %d of %d boxes\n", test.x, test.y, test.width, test.height, i, count);
+			return false;
+		}
+	}
+
+	if (hits != expectedHits)
+	{
+		printf("CollisionCheck: %s kernel, %d boxes: counted %d hits, CheckCollision %d\n", kernelNames[kernel], count, hits, expectedHits);
+		return false;
+	}
+
+	return true;
+}
+
+
+//Function: main()
+//Description: This is the main method of the collision kernel check.
+//Returns: int = 0 if every kernel agreed with CheckCollision, 1 otherwise.
+int main(int argc, char** argv)
+{
+	int rounds = (argc > 1) ? atoi(argv[1]) : 200;
+	if (rounds <= 0)
+	{
+		printf("Usage: CollisionCheck [rounds]\n");
+		return 1;
+	}
+
+	//Only the kernels up to the widest one the CPU supports can run
+	CollisionKernel widest = SelectCollisionKernel();
+
+	//Boxes that cover the whole plane without being NaN, they overlap every finite box and still miss the padding
+	CheckBox everything = { -FLT_MAX, -FLT_MAX, INFINITY, INFINITY };
+	CheckBox infiniteEdges = { -INFINITY, -INFINITY, FLT_MAX, FLT_MAX };
+
+	srand(1);
+	BoxArray array;
+	CheckBox boxes[CHECK_MAX_COUNT];
+	int tests = 0;
+	for (int round = 0; round < rounds; round++)
+	{
+		//A third of the rounds are plain boxes, a third add the edge values, and a third add NaNs on top
+		bool edgeCases = (round % 3) != 0;
+		bool nans = (round % 3) == 2;
+
+		for (int count = 0; count <= CHECK_MAX_COUNT; count++)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				boxes[i] = RandomBox(edgeCases, nans);
+			}
+
+			CheckBox cases[] = { RandomBox(edgeCases, nans), RandomBox(edgeCases, false), everything, infiniteEdges };
+			for (int t = 0; t < (int)(sizeof(cases) / sizeof(cases[0])); t++)
+			{
+				for (int kernel = CollisionScalar; kernel <= widest; kernel++)
+				{
+					if (!CheckBoxes((CollisionKernel)kernel, cases[t], boxes, count, &array))
+						return 1;
+
+					tests++;
+				}
+			}
+		}
+	}
+
+	printf("CollisionCheck: %d tests of the scalar to %s kernels agree with CheckCollision\n", tests, kernelNames[widest]);
+	return 0;
+}
@@ -0,0 +1,153 @@
+/*
+File Name:		DirectSoundBackend.cpp
+Description:	This file holds the methods of the DirectSound backend: creating its looping sound buffer and feeder thread, and
+				mixing into the chunks ahead of the play cursor.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/DirectSoundBackend.h"
+#include <string.h>
+#include <chrono>
+
+
+//Function: DirectSoundBackend(IDirectSound8* directSound)
+//Description: This method sets up the backend to play through a DirectSound device.
+//Returns: n/a.
+DirectSoundBackend::DirectSoundBackend(IDirectSound8* directSound)
+{
+	this->directSound = directSound;
+	this->buffer = 0;
+	this->mixer = 0;
+	this->running = false;
+	this->nextChunk = 0;
+}
+
+
+//Function: Start(AudioMixer* mixer)
+//Description: This method creates the looping sound buffer for 44.1kHz 16bit 2channel samples, mixes the first chunks and
+//starts playing and feeding it. It has to be called from the platform layer, so the feeder never runs code that gets unloaded.
+//Returns: bool = whether the sound buffer was created and started.
+bool DirectSoundBackend::Start(AudioMixer* mixer)
+{
+	this->mixer = mixer;
+
+	WAVEFORMATEX waveFormat = {};
+	waveFormat.wFormatTag = WAVE_FORMAT_PCM;
+	waveFormat.nSamplesPerSec = MIXER_SAMPLE_RATE;
+	waveFormat.wBitsPerSample = 16;
+	waveFormat.nChannels = MIXER_CHANNELS;
+	waveFormat.nBlockAlign = (waveFormat.wBitsPerSample / 8) * waveFormat.nChannels;
+	waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign;
+
+	//The feeder needs an accurate play cursor to know how far ahead it is
+	DSBUFFERDESC bufferDesc = {};
+	bufferDesc.dwSize = sizeof(DSBUFFERDESC);
+	bufferDesc.dwFlags = DSBCAPS_GETCURRENTPOSITION2;
+	bufferDesc.dwBufferBytes = DSOUND_CHUNK_BYTES * DSOUND_CHUNK_COUNT;
+	bufferDesc.lpwfxFormat = &waveFormat;
+	bufferDesc.guid3DAlgorithm = GUID_NULL;
+
+	IDirectSoundBuffer* tempBuffer;
+	if (FAILED(this->directSound->CreateSoundBuffer(&bufferDesc, &tempBuffer, NULL)))
+		return false;
+
+	HRESULT result = tempBuffer->QueryInterface(IID_IDirectSoundBuffer8, (void**)&this->buffer);
+	tempBuffer->Release();
+	if (FAILED(result))
+	{
+		this->buffer = 0;
+		return false;
+	}
+
+	//The chunk that plays first and the lead after it are mixed now, the rest starts out as silence
+	for (int chunk = 0; chunk < DSOUND_CHUNK_COUNT; chunk++)
+	{
+		this->FillChunk(chunk, chunk > DSOUND_LEAD_CHUNKS);
+	}
+	this->nextChunk = DSOUND_LEAD_CHUNKS + 1;
+
+	if (FAILED(this->buffer->Play(0, 0, DSBPLAY_LOOPING)))
+		return false;
+
+	this->running = true;
+	this->feeder = std::thread([this]()
+	{
+		while (this->running)
+		{
+			this->Feed();
+			std::this_thread::sleep_for(std::chrono::milliseconds(DSOUND_FEED_INTERVAL_MS));
+		}
+	});
+
+	return true;
+}
+
+
+//Function: Stop()
+//Description: This method stops the feeder thread and releases the sound buffer.
+//Returns: void.
+void DirectSoundBackend::Stop()
+{
+	this->running = false;
+	if (this->feeder.joinable())
+	{
+		this->feeder.join();
+	}
+
+	if (this->buffer)
+	{
+		this->buffer->Stop();
+		this->buffer->Release();
+		this->buffer = 0;
+	}
+}
+
+
+//Function: Feed()
+//Description: This method mixes chunks until the lead past the chunk playing is full again. If the play cursor has caught up
+//with the chunks mixed, the feeder was held up for longer than the lead, and it starts over from the chunk after the cursor.
+//Returns: void.
+void DirectSoundBackend::Feed()
+{
+	DWORD playCursor = 0;
+	if (FAILED(this->buffer->GetCurrentPosition(&playCursor, NULL)))
+		return;
+
+	int playChunk = (int)(playCursor / DSOUND_CHUNK_BYTES);
+	int ahead = (this->nextChunk - playChunk + DSOUND_CHUNK_COUNT) % DSOUND_CHUNK_COUNT;
+	if (ahead == 0 || ahead > DSOUND_LEAD_CHUNKS + 1)
+	{
+		this->nextChunk = (playChunk + 1) % DSOUND_CHUNK_COUNT;
+		ahead = 1;
+	}
+
+	for (; ahead <= DSOUND_LEAD_CHUNKS; ahead++)
+	{
+		this->FillChunk(this->nextChunk, false);
+		this->nextChunk = (this->nextChunk + 1) % DSOUND_CHUNK_COUNT;
+	}
+}
+
+
+//Function: FillChunk(int chunk, bool silent)
+//Description: This method mixes the next frames into a chunk of the sound buffer, or fills it with silence.
+//Returns: void.
+void DirectSoundBackend::FillChunk(int chunk, bool silent)
+{
+	void* region;
+	DWORD regionSize;
+	if (FAILED(this->buffer->Lock(chunk * DSOUND_CHUNK_BYTES, DSOUND_CHUNK_BYTES, &region, &regionSize, NULL, NULL, 0)))
+		return;
+
+	if (silent)
+	{
+		memset(region, 0, regionSize);
+	}
+	else
+	{
+		this->mixer->Mix((int16_t*)region, (int)(regionSize / (MIXER_CHANNELS * sizeof(int16_t))));
+	}
+
+	this->buffer->Unlock(region, regionSize, NULL, 0);
+}
@@ -1,215 +1,185 @@
 /*
 File Name:		Game.cpp
-Description:	This file manages the game portion of the application. The player is spawned in with 100 health in the first sector.
-				The goal of the game is to fly to planets and collect energy and science while fighting off the enemies. The game
-				includes rockets shooting from players and enemies, along with boss fights every 10 rounds.
+Description:	This file manages the platform portion of the game. It loads the assets, steps the simulation, and then consumes
+				the render and audio commands the simulation emitted to draw the scene, the HUD and play the sound effects.
 Programmer:		Kyle Jensen
 Date:			April 14, 2017
 */
 
 #include "../Include/Game.h"
+#include "../Include/JobQueue.h"
 
 
-#define TimeElapsed 0.016667f
-
-
-//HUD texture globals
-TextureHandle energyIcon;
-TextureHandle scienceIcon;
-TextureHandle abilityIcons[4];
-TextureHandle introBackground;
-TextureHandle introLogo;
-
-bool displayLevelNotClear = false;
-
 //Function: GAME_UPDATE_AND_RENDER(GameUpdateAndRender)
 //Description: This method gets dynamically compiled into the main.cpp file and can be swapped for real-time debugging performance gains.
 //It runs the main game loop and all the game functionality for this application.
 //Returns: void.
 GAME_UPDATE_AND_RENDER(GameUpdateAndRender)
 {
-	//If the game has not been initialized yet, do so
-	if (!gameState->initialized)
+	GameState* gameState = &gameMemory->state;
+
+#if PROFILER_ENABLED
+	if (!gameMemory->profiler)
+	{
+		gameMemory->profiler = new Profiler();
+		gameMemory->profiler->Initialize();
+	}
+	globalProfiler = gameMemory->profiler;
+	globalProfiler->Frame();
+
+	if (gameMemory->traceRequested)
 	{
-		srand(time(0));
+		globalProfiler->WriteTrace("trace.json");
+		gameMemory->traceRequested = false;
+	}
+#endif
+	PROFILE_SCOPE("GameUpdateAndRender");
 
-		//Set screen and tile sizes
+	//If the game has not been initialized yet, load the assets. The simulation initializes itself on its next step.
+	if (!gameState->initialized)
+	{
+		//Set screen sizes, the simulation builds its tile grid from these
 		gameState->screenWidth = bufferWidth;
 		gameState->screenHeight = bufferHeight;
-		gameState->tileWidth = gameState->screenWidth / TILE_SIZE;
-		gameState->tileHeight = gameState->screenHeight / TILE_SIZE;
+
+		//Seed the level generator once per run, a restart carries on from where it left off. The seed and the input of every
+		//step then reproduce the whole run.
+		if (!gameMemory->assetsLoaded)
+		{
+			gameMemory->seed = (uint32_t)time(0);
+			SeedSimulationRandom(gameState, gameMemory->seed);
+
+			if (gameMemory->recordFileName)
+			{
+				gameMemory->recorder.Begin(gameMemory->recordFileName, gameMemory->seed, gameState->screenWidth, gameState->screenHeight, SIMULATION_DT);
+			}
+		}
 
 		//Setup the projection matrix
 		float fieldOfView = (float)XM_PI / 2.0f;
 		float screenAspect = (float)gameState->screenWidth / (float)gameState->screenHeight;
 
 		//Initialize perspective matrices
-		MatrixBufferType* perspectiveMatrices = &gameState->perspectiveMatrices;
+		CameraBufferType* perspectiveMatrices = &gameMemory->perspectiveMatrices;
 		perspectiveMatrices->view = XMMatrixIdentity();
 		perspectiveMatrices->projection = XMMatrixPerspectiveFovLH(fieldOfView, screenAspect, 0.1f, 100.f);
-		perspectiveMatrices->world = XMMatrixIdentity();
-
-		//TODO: May not need this here as it is called before drawing
-		OverwriteGPUShaderMatrices(deviceContext, gameState->matrixBuffer, perspectiveMatrices);
+		OverwriteGPUShaderMatrices(deviceContext, gameMemory->perspectiveBuffer, perspectiveMatrices->array, ArrayCount(perspectiveMatrices->array));
 
 		//Initialize orthographic matrices
-		MatrixBufferType* orthoMatrices = &gameState->orthoMatrices;
+		CameraBufferType* orthoMatrices = &gameMemory->orthoMatrices;
 		orthoMatrices->view = XMMatrixIdentity();
 		orthoMatrices->projection = XMMatrixMultiply(XMMatrixOrthographicLH(gameState->screenWidth, gameState->screenHeight, 0.1f, 100.f), XMMatrixTranslation(-1, -1, 0));
-		orthoMatrices->world = XMMatrixIdentity();
-
-		//Set the constant buffer in the vertex shader with the updated values
-		deviceContext->VSSetConstantBuffers(0, 1, &gameState->matrixBuffer);
-
-		//Set the vertex buffers to the loaded obj models
-		gameState->sphereVertexBuffer = ObjLoader::VertexBufferFromObj(device, "Assets//Models//sphere.obj");
-		gameState->quadVertexBuffer = ObjLoader::VertexBufferFromObj(device, "Assets//Models//quad.obj");
-
-		//Initialize planet textures
-		TextureHandle* planetTextures = gameState->planetTextures;
-		planetTextures[0] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet1.tga");
-		planetTextures[1] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet2.tga");
-		planetTextures[2] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet3.tga");
-		planetTextures[3] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet4.tga");
-		planetTextures[4] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet5.tga");
-		planetTextures[5] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet6.tga");
-		planetTextures[6] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet7.tga");
-		planetTextures[7] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet8.tga");
-		planetTextures[8] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet9.tga");
-		planetTextures[9] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//planet10.tga");
-		planetTextures[10] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//blackhole.tga");
-
-		//Initialize background textures
-		TextureHandle* backgrounds = gameState->backgrounds;
-		backgrounds[0] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//universe1.tga");
-		backgrounds[1] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//universe2.tga");
-		backgrounds[2] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//universe3.tga");
-		backgrounds[3] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//universe4.tga");
-		backgrounds[4] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//universe5.tga");
-		backgrounds[5] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//universe6.tga");
-
-		introBackground = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//introbackground.tga");
-		introLogo = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//logo.tga");
-
-		energyIcon = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//energy.tga");
-		scienceIcon = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//science.tga");
-
-		abilityIcons[0] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//ability1icon.tga");
-		abilityIcons[1] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//ability2icon.tga");
-		abilityIcons[2] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//ability3icon.tga");
-		abilityIcons[3] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//ability4icon.tga");
-
-		gameState->playerRocketTextures[0] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//rocket1_y.tga");
-		gameState->playerRocketTextures[1] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//rocket2_y.tga");
-		gameState->playerRocketTextures[2] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//rocket3_y.tga");
-		gameState->enemyRocketTextures[0] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//rocket1_r.tga");
-		gameState->enemyRocketTextures[1] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//rocket2_r.tga");
-		gameState->enemyRocketTextures[2] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//rocket3_r.tga");
-		gameState->enemyRocketTextures[3] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//laser_beam.tga");
-
-		gameState->explosionTexture = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//explosion.tga");
-
-		gameState->playerTexture = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//ship.tga");
-		gameState->enemyTextures[0] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//enemy1.tga");
-		gameState->enemyTextures[1] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//enemy2.tga");
-		gameState->bossTextures[0] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//enemyboss1.tga");
-		gameState->bossTextures[1] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//enemyboss2.tga");
-		gameState->bossTextures[2] = LoadTextureFromTGA(device, deviceContext, "Assets//Textures//enemyboss3.tga");
-
-		//Sound	
-		LoadWaveFile("Assets//Audio//spaceship_move.wav", gameState->directSound, &gameState->spaceShipMoveSound);
-		LoadWaveFile("Assets//Audio//missile_fire.wav", gameState->directSound, &gameState->missileFireSound);
-		LoadWaveFile("Assets//Audio//missile_hit.wav", gameState->directSound, &gameState->missileHitSound);
-		LoadWaveFile("Assets//Audio//intro.wav", gameState->directSound, &gameState->introMusic);
-		LoadWaveFile("Assets//Audio//background01.wav", gameState->directSound, &gameState->backgroundMusic[0]);
-		LoadWaveFile("Assets//Audio//background02.wav", gameState->directSound, &gameState->backgroundMusic[1]);
-		LoadWaveFile("Assets//Audio//background03.wav", gameState->directSound, &gameState->backgroundMusic[2]);
-		gameState->backgroundMusic[3] = gameState->backgroundMusic[0];
-		gameState->backgroundMusic[4] = gameState->backgroundMusic[1];
-		gameState->backgroundMusic[5] = gameState->backgroundMusic[2];
-
-		//Initialize player ship
-		Vector2 playerStartPos = Vector2{ (float)gameState->tileWidth, (float)gameState->screenHeight / 2.0f };
-		Vector2 playerSize = Vector2{ (float)gameState->tileWidth, (float)gameState->tileHeight };
-		Ability abilities[NUM_ABILITIES] = { playerRocket1, playerRocket2, playerRocket3 };
-		gameState->player = new Ship(SHIP_PLAYER_SPEED, playerStartPos, playerSize, gameState->playerTexture, 2000, abilities);
-		gameState->player->energy = 100;
-
-		//Initialize enemy spawn points
-		gameState->enemySpawnpoints[0] = Vector2{ (float)gameState->screenWidth - (float)gameState->tileWidth, (float)gameState->screenHeight / 2.f };
-		gameState->enemySpawnpoints[1] = Vector2{ (float)gameState->screenWidth - (float)gameState->tileWidth, (float)gameState->screenHeight };
-		gameState->enemySpawnpoints[2] = Vector2{ (float)gameState->screenWidth - (float)gameState->tileWidth,  (float)gameState->tileHeight };
-		gameState->currentSector = 1;
-
-		//If the game has been started, generate the level
-		if (gameState->started)
+		OverwriteGPUShaderMatrices(deviceContext, gameMemory->orthoBuffer, orthoMatrices->array, ArrayCount(orthoMatrices->array));
+
+		//Assets survive a restart, they are only loaded the first time
+		if (!gameMemory->assetsLoaded)
 		{
-			GenerateLevel(gameState, deviceContext, device);
+			LoadAssets(device, deviceContext, gameMemory);
+			gameMemory->assetsLoaded = true;
 		}
-
-		gameState->scienceGathered = 0;
-		
-        gameState->initialized = true;
     }
 
-	//Prepare draw	
-	UINT stride = sizeof(VertexType);
-	UINT offset = 0;
-	UINT sampleMask = 0xffffffff;
+	//Prepare draw. The sprite batch at the end of the last frame bound its own state, so the cache starts the frame knowing nothing.
 	float clearColor[] = { 0.1f, 0.1f, 0.1f, 1.0f };
     deviceContext->ClearRenderTargetView(renderTargetView, clearColor);
     deviceContext->ClearDepthStencilView(depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
-	deviceContext->VSSetConstantBuffers(0, 1, &gameState->matrixBuffer);
-	deviceContext->VSSetShader(gameState->vertexShader, 0, 0);
-	deviceContext->PSSetShader(gameState->pixelShader, 0, 0);
-	deviceContext->OMSetBlendState(gameState->blendState, 0, sampleMask);
-	deviceContext->IASetInputLayout(gameState->layout);
-	deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	deviceContext->RSSetState(gameState->rasterState);
+
+	RenderStateCache* renderState = &gameMemory->renderState;
+	renderState->BeginFrame(deviceContext);
+	renderState->SetVSConstantBuffer(0, gameMemory->orthoBuffer);
+	renderState->SetPixelShader(gameMemory->pixelShader);
+	renderState->SetBlendState(gameMemory->blendState);
+	renderState->SetTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	renderState->SetRasterizerState(gameMemory->rasterState);
+	gameMemory->renderStats = {};
 
 	//Get input mouse x and y relative to the screen width and height
 	input.mouse.x = (float)input.mouse.x / (float)bufferWidth * gameState->screenWidth;
 	input.mouse.y = (float)input.mouse.y / (float)bufferHeight * gameState->screenHeight;
 
+	//Run as many fixed steps as the frame time covers, playing the sounds each one asked for
+	gameMemory->accumulator += (frameTime < MAX_FRAME_TIME) ? frameTime : MAX_FRAME_TIME;
+	gameMemory->pendingClickL |= input.mouse.clickedL;
+	gameMemory->pendingClickR |= input.mouse.clickedR;
+
+	while (gameMemory->accumulator >= SIMULATION_DT)
+	{
+		//A click is only seen by one step, held buttons and keys are seen by all of them
+		Input stepInput = input;
+		stepInput.mouse.clickedL = gameMemory->pendingClickL;
+		stepInput.mouse.clickedR = gameMemory->pendingClickR;
+		gameMemory->pendingClickL = false;
+		gameMemory->pendingClickR = false;
+
+		SimulationStep(*gameState, stepInput, SIMULATION_DT);
+		ExecuteAudioCommands(gameMemory);
+
+		if (gameMemory->recorder.file)
+		{
+			gameMemory->recorder.Record(stepInput, HashGameState(*gameState));
+		}
+
+		gameMemory->accumulator -= SIMULATION_DT;
+	}
+
+	//How far we are between the last step and the next one, moving sprites are drawn that far along their last step
+	float alpha = gameMemory->accumulator / SIMULATION_DT;
+
 	//Draw the background universe object
-	TextureHandle background = (gameState->levelState == LevelState::Start) ? introBackground : gameState->backgrounds[gameState->backgroundIndex];
+	TextureHandle background = (gameState->levelState == LevelState::Start) ? gameMemory->introBackground : gameMemory->backgrounds[gameState->backgroundIndex];
 	if (gameState->levelState != LevelState::GameOver)
 	{
-		DrawTexture2D(deviceContext, gameState, background, 0, 0, gameState->screenWidth, gameState->screenHeight, 99, XM_PI);
+		DrawTexture2D(deviceContext, gameMemory, FullTextureRegion(background), 0, 0, gameState->screenWidth, gameState->screenHeight, 99, XM_PI);
 	}
-	
-	//Switch between level states
-	switch (gameState->levelState)
-	{
-	case LevelState::Start:
-		RunStartGame(input, gameState, deviceContext, device);
-		break;
-	case LevelState::Discovery:
-		RunDiscoveryScene(input, gameState, deviceContext);
-		break;
-	case LevelState::Exploration:
-		RunExplorationScene(input, gameState, deviceContext, device);
-		break;
-	case LevelState::GameOver:
-		RunGameOverScene(input, gameState);
-	}	
+
+	//Draw the scene the simulation emitted
+	ExecuteRenderCommands(deviceContext, gameMemory, alpha);
 
 	// HUD //
 	
 	//If we are in the playing states, draw icons for energy and abilities
 	if (gameState->levelState == LevelState::Discovery || gameState->levelState == LevelState::Exploration)
 	{
-		DrawTexture2D(deviceContext, gameState, energyIcon, 10, gameState->screenHeight - 50, 40, 40, 1);
-		DrawTexture2D(deviceContext, gameState, scienceIcon, 10, gameState->screenHeight - 100, 40, 40, 1, XM_PI);
-		DrawTexture2D(deviceContext, gameState, abilityIcons[0], 10, 10, 60, 60, 1, XM_PI);
-		DrawTexture2D(deviceContext, gameState, abilityIcons[1], 80, 10, 60, 60, 1, XM_PI);
-		DrawTexture2D(deviceContext, gameState, abilityIcons[2], 150, 10, 60, 60, 1, XM_PI);
-		DrawTexture2D(deviceContext, gameState, abilityIcons[3], 220, 10, 60, 60, 1, XM_PI);
+		DrawTexture2D(deviceContext, gameMemory, gameMemory->energyIcon, 10, gameState->screenHeight - 50, 40, 40, 1);
+		DrawTexture2D(deviceContext, gameMemory, gameMemory->scienceIcon, 10, gameState->screenHeight - 100, 40, 40, 1, XM_PI);
+		DrawTexture2D(deviceContext, gameMemory, gameMemory->abilityIcons[0], 10, 10, 60, 60, 1, XM_PI);
+		DrawTexture2D(deviceContext, gameMemory, gameMemory->abilityIcons[1], 80, 10, 60, 60, 1, XM_PI);
+		DrawTexture2D(deviceContext, gameMemory, gameMemory->abilityIcons[2], 150, 10, 60, 60, 1, XM_PI);
+		DrawTexture2D(deviceContext, gameMemory, gameMemory->abilityIcons[3], 220, 10, 60, 60, 1, XM_PI);
 	}
 	else if (gameState->levelState == LevelState::Start)
 	{
-		DrawTexture2D(deviceContext, gameState, introLogo, (gameState->screenWidth / 2) - 200, gameState->screenHeight - 150, 400, 100, 1, XM_PI);
+		DrawTexture2D(deviceContext, gameMemory, FullTextureRegion(gameMemory->introLogo), (gameState->screenWidth / 2) - 200, gameState->screenHeight - 150, 400, 100, 1, XM_PI);
+	}
+
+	//Draw the sprites still queued, the sprite batch below changes the pipeline state
+	FlushSprites(deviceContext, gameMemory);
+	gameMemory->renderStats.bindsIssued = renderState->bindsIssued;
+	gameMemory->renderStats.bindsSkipped = renderState->bindsSkipped;
+	gameMemory->lastFrameStats = gameMemory->renderStats;
+
+	//The player is made by the first step, a frame too short for one has no HUD to draw yet
+	if (gameState->player)
+	{
+		DrawHUDText(gameMemory);
+	}
+
+	{
+		PROFILE_SCOPE("Present");
+		gameMemory->swapChain->Present(1, 0);
 	}
+}
+
+
+//Function: DrawHUDText(GameMemory* gameMemory)
+//Description: This method draws the text of the HUD for the scene we are in with the sprite batch, along with the render
+//stats and the profiler breakdown when they are compiled in.
+//Returns: void.
+void DrawHUDText(GameMemory* gameMemory)
+{
+	PROFILE_SCOPE("DrawHUDText");
+
+	GameState* gameState = &gameMemory->state;
 
 	//Get counter information as WSTRING
 	wstring energy = to_wstring(gameState->player->energy);
@@ -218,7 +188,32 @@ GAME_UPDATE_AND_RENDER(GameUpdateAndRender)
 	wstring notClearMessage = L"You must clear all enemies to move on";
 
 	//Begin drawing with spritebatch
-	gameState->spriteBatch->Begin();
+	gameMemory->spriteBatch->Begin();
+
+#if PROFILER_ENABLED
+	//The breakdown of the last frame, one line per scope the main thread ran
+	Profiler* profiler = gameMemory->profiler;
+	wchar_t profileLine[64];
+	swprintf(profileLine, ArrayCount(profileLine), L"Frame %.2f ms", profiler->frameMilliseconds);
+	gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, profileLine, SimpleMath::Vector2(10.0f, 120.0f), Colors::White, 0.0f, SimpleMath::Vector2(0, 0), 0.5f);
+
+	float profileY = 136.0f;
+	for (int i = 0, count = profiler->nameCount.load(); i < count; i++)
+	{
+		if (!profiler->frameTotals[i].calls)
+			continue;
+
+		swprintf(profileLine, ArrayCount(profileLine), L"%hs %.2f ms (%d)", profiler->names[i], profiler->frameTotals[i].milliseconds, profiler->frameTotals[i].calls);
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, profileLine, SimpleMath::Vector2(10.0f, profileY), Colors::White, 0.0f, SimpleMath::Vector2(0, 0), 0.5f);
+		profileY += 16.0f;
+	}
+#endif
+
+#if SHOW_RENDER_STATS
+	wstring renderStatsLabel = L"Draws " + to_wstring(gameMemory->lastFrameStats.drawCalls) + L" Maps " + to_wstring(gameMemory->lastFrameStats.mapCalls) +
+		L" Binds " + to_wstring(gameMemory->lastFrameStats.bindsIssued) + L" Skipped " + to_wstring(gameMemory->lastFrameStats.bindsSkipped);
+	gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, renderStatsLabel.data(), SimpleMath::Vector2(gameState->screenWidth - (renderStatsLabel.length() * 16) - 25, gameState->screenHeight - 50.0f));
+#endif
 
 	//Draw the discovery scene HUD
 	if (gameState->levelState == LevelState::Discovery)
@@ -231,13 +226,13 @@ GAME_UPDATE_AND_RENDER(GameUpdateAndRender)
 		energyLabel.append(to_wstring(gameState->currentPlanet->energy)).append(L")");
 		scienceLabel.append(to_wstring(gameState->currentPlanet->science)).append(L")");	
 		
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, planetName.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((planetName.length() * 16) / 2), 50.0f));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, energyLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((energyLabel.length() * 16) / 2), gameState->screenHeight - 170.0f));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, scienceLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((scienceLabel.length() * 16) / 2), gameState->screenHeight - 120.0f));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, continueLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((continueLabel.length() * 16) / 2), gameState->screenHeight - 70.0f));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, planetName.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((planetName.length() * 16) / 2), 50.0f));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, energyLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((energyLabel.length() * 16) / 2), gameState->screenHeight - 170.0f));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, scienceLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((scienceLabel.length() * 16) / 2), gameState->screenHeight - 120.0f));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, continueLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((continueLabel.length() * 16) / 2), gameState->screenHeight - 70.0f));
 		
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, energy.data(), SimpleMath::Vector2(60, 20));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, science.data(), SimpleMath::Vector2(60, 70));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, energy.data(), SimpleMath::Vector2(60, 20));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, science.data(), SimpleMath::Vector2(60, 70));
 	}
 	else if (gameState->levelState == LevelState::Exploration)
 	{
@@ -245,21 +240,21 @@ GAME_UPDATE_AND_RENDER(GameUpdateAndRender)
 		if (gameState->nearPlanet)
 		{
 			wstring interactLabel = L"Press [E] to warp";
-			gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, interactLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((interactLabel.length() * 16) / 2), gameState->screenHeight - 120.0f));
+			gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, interactLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((interactLabel.length() * 16) / 2), gameState->screenHeight - 120.0f));
 		}
 
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, energy.data(), SimpleMath::Vector2(60, 20));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, science.data(), SimpleMath::Vector2(60, 70));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, sector.data(), SimpleMath::Vector2(gameState->screenWidth - (sector.length() * 24) - 25, 20));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, energy.data(), SimpleMath::Vector2(60, 20));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, science.data(), SimpleMath::Vector2(60, 70));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, sector.data(), SimpleMath::Vector2(gameState->screenWidth - (sector.length() * 24) - 25, 20));
 	
 		//If there are still enemies in the sector and we try to leave it, display message
-		if (displayLevelNotClear)
-			gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, notClearMessage.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((notClearMessage.length() * 16) / 2) , 100));
+		if (gameState->displayLevelNotClear)
+			gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, notClearMessage.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((notClearMessage.length() * 16) / 2) , 100));
 	}
 	else if (gameState->levelState == LevelState::Start)
 	{
 		wstring playLabel = L"Press Enter to Play";
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, playLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((playLabel.length() * 16) / 2), gameState->screenHeight - 70.0f));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, playLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((playLabel.length() * 16) / 2), gameState->screenHeight - 70.0f));
 	}
 	else if (gameState->levelState == LevelState::GameOver)
 	{
@@ -269,702 +264,452 @@ GAME_UPDATE_AND_RENDER(GameUpdateAndRender)
 		wstring menuLabel = L"Press Enter to return to menu";
 		sectorLabel.append(to_wstring(gameState->currentSector));
 		scienceLabel.append(to_wstring(gameState->scienceGathered));
-		gameState->spriteFontLucida56->DrawString(gameState->spriteBatch, gameOverLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((gameOverLabel.length() * 50) / 2), 100.0f));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, sectorLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((sectorLabel.length() * 16) / 2), gameState->screenHeight / 2));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, scienceLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((scienceLabel.length() * 16) / 2), (gameState->screenHeight / 2) + 70.0f));
-		gameState->spriteFontLucida24->DrawString(gameState->spriteBatch, menuLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((menuLabel.length() * 16) / 2), gameState->screenHeight - 70.0f));
+		gameMemory->spriteFontLucida56->DrawString(gameMemory->spriteBatch, gameOverLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((gameOverLabel.length() * 50) / 2), 100.0f));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, sectorLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((sectorLabel.length() * 16) / 2), gameState->screenHeight / 2));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, scienceLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((scienceLabel.length() * 16) / 2), (gameState->screenHeight / 2) + 70.0f));
+		gameMemory->spriteFontLucida24->DrawString(gameMemory->spriteBatch, menuLabel.data(), SimpleMath::Vector2((gameState->screenWidth / 2) - ((menuLabel.length() * 16) / 2), gameState->screenHeight - 70.0f));
 	}
 
-	gameState->spriteBatch->End();
-    gameState->swapChain->Present(1, 0);
+	gameMemory->spriteBatch->End();
 }
 
 
 
-//Function: RunStartGame
-//Description: This method runs the logic for the start screen. It starts and stops the intro music, and starts the game
-//when the user presses enter.
-//Returns: void.
-void RunStartGame(Input input, GameState* gameState, ID3D11DeviceContext* deviceContext, ID3D11Device* device)
-{
-	DWORD status;
-	gameState->introMusic->GetStatus(&status);
-	if (!(status & DSBSTATUS_PLAYING) && !(status & DSBSTATUS_LOOPING))
-	{
-		PlayWaveFile(gameState->introMusic, -1000, true);
-	}
+#pragma region Drawing
 
-	gameState->spaceShipMoveSound->Stop();
-	gameState->backgroundMusic[gameState->backgroundIndex]->Stop();
+// Function: OverwriteGPUShaderMatrices()
+// Description: This method overwrites the matrices of a constant buffer with the new mapped resource. It also transposes the
+// matrices to prepare them to be rendered. The camera buffers are only written when their matrices change, not every draw.
+// Returns: void.
+void OverwriteGPUShaderMatrices(ID3D11DeviceContext* deviceContext, ID3D11Buffer* constantBuffer, const XMMATRIX* matrices, int matrixCount)
+{
+	D3D11_MAPPED_SUBRESOURCE mappedResource = {};
+	if (FAILED(deviceContext->Map(constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource)))
+		return;
 
-	if (input.enter)
+	//Loop through the matrices and set their information from the mapped resource
+	XMMATRIX* shaderMatrices = (XMMATRIX*)mappedResource.pData;
+	for (int i = 0; i < matrixCount; i++)
 	{
-		gameState->initialized = false;
-		gameState->started = true;
-		gameState->introMusic->Stop();
+		shaderMatrices[i] = XMMatrixTranspose(matrices[i]);
 	}
-}
 
+	deviceContext->Unmap(constantBuffer, 0);
+}
 
-//Function: RunExplorationScene(Input input, GameState* gameState, ID3D11DeviceContext* deviceContext, ID3D11Device* device)
-//Description: This method runs the exploration scene. This is where the bulk of the action happens. From moving player and
-//enemy ships, to shooting different rockets and abilities to collision detection and sound effects.
+//Function: ExecuteAudioCommands(GameMemory* gameMemory)
+//Description: This method hands the sounds the last simulation step asked for to the mixer, in the order they were emitted.
 //Returns: void.
-void RunExplorationScene(Input input, GameState* gameState, ID3D11DeviceContext* deviceContext, ID3D11Device* device)
+void ExecuteAudioCommands(GameMemory* gameMemory)
 {
-	MatrixBufferType* perspectiveMatrices = &gameState->perspectiveMatrices;
-
-	Ship* player = gameState->player;
-	vector<Ship*>::iterator enemyIterator = gameState->enemies.begin();
+	PlayAudioCommands(gameMemory->mixer, gameMemory->sounds, gameMemory->state.audioCommands, gameMemory->state.screenWidth, gameMemory->state.screenHeight);
+}
 
-	//Get rid of ships that have been destroyed
-	while (enemyIterator != gameState->enemies.end())
+//Function: ExecuteRenderCommands(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, float alpha)
+//Description: This method draws the sprites and planets the last simulation step emitted, in the order they were emitted.
+//Planets emitted one after another are drawn together with one instanced draw, sprites are only flushed between them.
+//Sprites are placed alpha of the way from where they started the step to where they ended it.
+//Returns: void.
+void ExecuteRenderCommands(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, float alpha)
+{
+	std::vector<RenderCommand>& commands = gameMemory->state.renderCommands;
+	for (size_t i = 0, size = commands.size(); i != size; i++)
 	{
-		Ship* enemy = (*enemyIterator);
+		RenderCommand& command = commands[i];
 
-		if (enemy->energy <= 0)
+		if (command.type == RenderPlanet)
 		{
-			enemyIterator = gameState->enemies.erase(enemyIterator);
+			//Sprites queued before the planet have to be drawn first
+			FlushSprites(deviceContext, gameMemory);
+			gameMemory->planetRenderer.Push(PlanetWorldMatrix(command), command.sprite - SpritePlanet);
 		}
 		else
 		{
-			enemyIterator++;
+			//Likewise planets queued before the sprite
+			FlushPlanets(deviceContext, gameMemory);
+
+			float x = command.previousX + (command.x - command.previousX) * alpha;
+			float y = command.previousY + (command.y - command.previousY) * alpha;
+			DrawTexture2D(deviceContext, gameMemory, gameMemory->sprites[command.sprite], x, y, command.width, command.height, command.zOrder, command.angle);
 		}
 	}
-	enemyIterator = gameState->enemies.begin();
 
-	//If our energy reaches zero we lose.
-	if (player->energy <= 0)
-	{
-		gameState->levelState = LevelState::GameOver;
-		return;
-	}
+	FlushPlanets(deviceContext, gameMemory);
+}
 
-	//If it is a boss level, we want to check the boss' health and spawn minions every third of health.
-	if (gameState->currentSector % 10 == 0)
-	{
-		for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
-		{
-			Ship* enemy = gameState->enemies.at(i);
-			if (enemy->boss && enemy->energy < (enemy->maxEnergy / 3))
-			{
-				if (!enemy->spawnedMinions)
-				{
-					enemy->spawnedMinions = true;
-
-					//Ship information for a minion
-					Vector2 shipSize = Vector2{ (float)gameState->tileWidth, (float)gameState->tileHeight };
-					int minionEnergy = 100 + (100 * (gameState->currentSector / 10));
-					Ability minionAbilities[NUM_ABILITIES] = { enemy2Laser, enemy2Laser, enemy2Laser };
-
-					//Spawn minions
-					Ship* minion1 = new Ship(SHIP_ENEMY_SPEED, gameState->enemySpawnpoints[1], shipSize, gameState->enemyTextures[1], minionEnergy, minionAbilities);
-					Ship* minion2 = new Ship(SHIP_ENEMY_SPEED, gameState->enemySpawnpoints[2], shipSize, gameState->enemyTextures[1], minionEnergy, minionAbilities);
-
-					gameState->enemies.push_back(minion1);
-					gameState->enemies.push_back(minion2);
-				}
-			}
-		}
-	}
+//Function: DrawTexture2D(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, const SpriteRegion& region, float x, float y, float width, float height, int zOrder, float angle)
+//Description: This method queues a textured quad in screen space. It is drawn with the rest of the sprites on the next flush.
+//Returns: void.
+void DrawTexture2D(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, const SpriteRegion& region, float x, float y, float width, float height, int zOrder, float angle)
+{
+	gameMemory->spriteRenderer.Push(region, x, y, width, height, zOrder, angle);
+}
 
-	//If we click the left mouse button we set the players destination to the mouse click position
-	if (input.mouse.clickedL)
-	{
-		//If click is on the window, set the destination
-		if ((float)input.mouse.x >= 0 && (float)input.mouse.x <= gameState->screenWidth &&
-			(float)input.mouse.y >= 0 && (float)input.mouse.y <= gameState->screenHeight)
+
+//Function: LoadAssets(ID3D11Device* device, ID3D11DeviceContext* deviceContext, GameMemory* gameMemory)
+//Description: This method loads every texture, model and sound from the asset archive. Worker threads page the assets in,
+//then the D3D11 and DirectSound resources are created here, on the thread that owns the device.
+//If the archive is missing any asset the game needs, it lists them all and exits.
+//Returns: void.
+void LoadAssets(ID3D11Device* device, ID3D11DeviceContext* deviceContext, GameMemory* gameMemory)
+{
+	PROFILE_SCOPE("LoadAssets");
+
+	const AssetArchive* archive = gameMemory->archive;
+	SpriteRegion* sprites = gameMemory->sprites;
+	TextureHandle* backgrounds = gameMemory->backgrounds;
+
+	TextureLoad textures[] =
+	{
+		{ &backgrounds[0], "Textures/universe1.tga" },
+		{ &backgrounds[1], "Textures/universe2.tga" },
+		{ &backgrounds[2], "Textures/universe3.tga" },
+		{ &backgrounds[3], "Textures/universe4.tga" },
+		{ &backgrounds[4], "Textures/universe5.tga" },
+		{ &backgrounds[5], "Textures/universe6.tga" },
+		{ &gameMemory->introBackground, "Textures/introbackground.tga" },
+		{ &gameMemory->introLogo, "Textures/logo.tga" },
+	};
+
+	//Planets wrap their texture around a sphere, so rather than going into the atlas they are the slices of one texture
+	//array, indexed like the planet sprite identifiers. The packer resamples them all to one size.
+	char* planetNames[NUM_PLANET_TYPES] =
+	{
+		"Textures/planet1.tga",
+		"Textures/planet2.tga",
+		"Textures/planet3.tga",
+		"Textures/planet4.tga",
+		"Textures/planet5.tga",
+		"Textures/planet6.tga",
+		"Textures/planet7.tga",
+		"Textures/planet8.tga",
+		"Textures/planet9.tga",
+		"Textures/planet10.tga",
+		"Textures/blackhole.tga",
+	};
+	const ArchiveEntry* planets[NUM_PLANET_TYPES];
+
+	//The ships, rockets and HUD icons are packed onto atlas pages by the asset packer, so they are drawn in a few batches
+	AtlasEntry atlasEntries[] =
+	{
+		{ &gameMemory->energyIcon, "Textures/energy.tga" },
+		{ &gameMemory->scienceIcon, "Textures/science.tga" },
+		{ &gameMemory->abilityIcons[0], "Textures/ability1icon.tga" },
+		{ &gameMemory->abilityIcons[1], "Textures/ability2icon.tga" },
+		{ &gameMemory->abilityIcons[2], "Textures/ability3icon.tga" },
+		{ &gameMemory->abilityIcons[3], "Textures/ability4icon.tga" },
+		{ &sprites[SpritePlayerRocket + 0], "Textures/rocket1_y.tga" },
+		{ &sprites[SpritePlayerRocket + 1], "Textures/rocket2_y.tga" },
+		{ &sprites[SpritePlayerRocket + 2], "Textures/rocket3_y.tga" },
+		{ &sprites[SpriteEnemyRocket + 0], "Textures/rocket1_r.tga" },
+		{ &sprites[SpriteEnemyRocket + 1], "Textures/rocket2_r.tga" },
+		{ &sprites[SpriteEnemyRocket + 2], "Textures/rocket3_r.tga" },
+		{ &sprites[SpriteEnemyRocket + 3], "Textures/laser_beam.tga" },
+		{ &sprites[SpriteExplosion], "Textures/explosion.tga" },
+		{ &sprites[SpritePlayer], "Textures/ship.tga" },
+		{ &sprites[SpriteEnemy + 0], "Textures/enemy1.tga" },
+		{ &sprites[SpriteEnemy + 1], "Textures/enemy2.tga" },
+		{ &sprites[SpriteBoss + 0], "Textures/enemyboss1.tga" },
+		{ &sprites[SpriteBoss + 1], "Textures/enemyboss2.tga" },
+		{ &sprites[SpriteBoss + 2], "Textures/enemyboss3.tga" },
+	};
+
+	MixerSound* sounds = gameMemory->sounds;
+	SoundLoad soundLoads[] =
+	{
+		{ &sounds[SoundSpaceShipMove], "Audio/spaceship_move.wav" },
+		{ &sounds[SoundMissileFire], "Audio/missile_fire.wav" },
+		{ &sounds[SoundMissileHit], "Audio/missile_hit.wav" },
+	};
+
+	//Look every asset up first, so a broken archive reports everything it is missing at once
+	std::string missing;
+	for (int i = 0; i < ArrayCount(textures); i++)
+	{
+		textures[i].entry = FindAsset(archive, textures[i].name, AssetTexture, &missing);
+	}
+	uint32_t atlasPageCount = 0;
+	for (int i = 0; i < ArrayCount(atlasEntries); i++)
+	{
+		atlasEntries[i].entry = FindAsset(archive, atlasEntries[i].name, AssetSprite, &missing);
+		if (atlasEntries[i].entry && atlasEntries[i].entry->sprite.page >= atlasPageCount)
 		{
-			Vector2 newDestination = Vector2{ (float)input.mouse.x, (float)(gameState->screenHeight - input.mouse.y) };
-			player->destination = newDestination;
+			atlasPageCount = atlasEntries[i].entry->sprite.page + 1;
 		}
 	}
-
-	//If we press 4, we want to check the difference between the last heal and heal the player for 500 energy for a price of 500 science
-	if (input.key4)
+	std::vector<const ArchiveEntry*> atlasPages(atlasPageCount);
+	for (uint32_t i = 0; i < atlasPageCount; i++)
 	{
-		if (difftime(time(0), player->last_heal) > 1)
-		{
-			if (player->science >= 500 && player->energy < player->maxEnergy)
-			{
-				player->science -= 500;		
-				player->energy += 500;
-				if (player->energy > player->maxEnergy)
-					player->energy = player->maxEnergy;
-			}
-		}
+		char pageName[64];
+		snprintf(pageName, sizeof(pageName), ATLAS_PAGE_NAME, (int)i);
+		atlasPages[i] = FindAsset(archive, pageName, AssetTexture, &missing);
 	}
-
-	//Set the ability index to the key that is pressed and -1 if none is pressed.
-	int abilityIndex = (input.key1) ? 0 : (input.key2) ? 1 : (input.key3) ? 2 : -1;
-
-	//If we fired an ability, instantiate a rocket of the ability type and fire it
-	if (abilityIndex > -1 && abilityIndex < NUM_ABILITIES)
+	for (int i = 0; i < NUM_PLANET_TYPES; i++)
 	{
-		Ability ability = player->abilities[abilityIndex];
+		planets[i] = FindAsset(archive, planetNames[i], AssetTexture, &missing);
 
-		//If we have enough science, we can use the ability
-		if (player->science >= ability.scienceCost)
+		//Every slice of the array has the size of the first one
+		if (planets[i] && planets[0] && (planets[i]->texture.width != planets[0]->texture.width || planets[i]->texture.height != planets[0]->texture.height))
 		{
-			if (difftime(time(0), player->abilityShotTime[abilityIndex]) > ability.cooldown)
-			{
-				//Set the ability shot time
-				player->abilityShotTime[abilityIndex] = time(0);
-				
-				//Rotate the rocket and fire it out of the front of the player ship
-				XMFLOAT3 tempVec;
-				XMStoreFloat3(&tempVec, XMVector3Transform(XMVECTOR{ 1.0f, 0.0f, 0.0f }, XMMatrixRotationZ(player->angle)));
-				Vector2 direction = Vector2{ tempVec.x, tempVec.y };
-				direction = Normalize(direction);
-
-				//Create a rocket
-				Rocket* rocket = new Rocket(player->position, ability.rocketSize, direction, gameState->playerRocketTextures[ability.rocketIndex], ability.speed, ability.damage);
-
-				//Add rocket to list of instantiated rockets
-				gameState->instantiatedRockets.push_back(rocket);
-				player->science -= ability.scienceCost;
-
-				//Play rocket sound
-				PlayWaveFile(gameState->missileFireSound, -1500);
-			}
+			missing.append(planetNames[i]).append(" (not the size of the other planets)\n");
 		}
 	}
-		
-	//Enemy shooting at player
-	for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
+	for (int i = 0; i < ArrayCount(soundLoads); i++)
 	{
-		Ship* enemy = gameState->enemies.at(i);
-		
-		time_t now = time(0);
-
-		//Enemy needs to cooldown after shooting any rocket (stops from double shooting between rocket types)
-		if (difftime(now, enemy->cooldown_time) > enemy->cooldown)
-		{	
-			enemy->cooldown_time = now;
-
-			for (int i = (gameState->currentSector / 10); i >= 0; i--)
-			{
-				//If the time between the last shot and now is greater than the shoot rate, shoot again.
-				if (difftime(now, enemy->abilityShotTime[i]) > enemy->abilities[i].cooldown)
-				{
-					Ability ability = enemy->abilities[i];
-					enemy->abilityShotTime[i] = now;
-
-					//If the enemy is a boss, we shoot double rockets offset to appear. Otherwise shoot single bullets
-					if (enemy->boss)
-					{
-						Vector2 offset = { 0.0f, 30.0f };
-						Vector2 rocket1Direction = Normalize((player->position + offset) - (enemy->position + offset));
-						Vector2 rocket2Direction = Normalize((player->position - offset) - (enemy->position - offset));
-						Rocket* rocket1 = new Rocket(enemy->position + offset, ability.rocketSize, rocket1Direction, gameState->enemyRocketTextures[ability.rocketIndex], ability.speed, ability.damage);
-						Rocket* rocket2 = new Rocket(enemy->position - offset, ability.rocketSize, rocket2Direction, gameState->enemyRocketTextures[ability.rocketIndex], ability.speed, ability.damage);
-						rocket1->shooter = 1;
-						rocket2->shooter = 1;
-						gameState->instantiatedRockets.push_back(rocket1);
-						gameState->instantiatedRockets.push_back(rocket2);
-					}
-					else
-					{
-						Vector2 newDirection = Normalize(player->position - enemy->position);
-						Rocket* rocket = new Rocket(enemy->position, ability.rocketSize, newDirection, gameState->enemyRocketTextures[ability.rocketIndex], ability.speed, ability.damage);
-						rocket->shooter = 1;
-						gameState->instantiatedRockets.push_back(rocket);
-					}
-
-					//Play rocket sound
-					PlayWaveFile(gameState->missileFireSound, -1500);
-
-					break;
-				}
-			}
-		}
+		soundLoads[i].entry = FindAsset(archive, soundLoads[i].name, AssetSound, &missing);
 	}
 
-	//Get the distances between the player and enemy and player to target
-	float playerDistanceToTarget = Magnitude(player->destination - player->position);
-
-	//Move the player towards the target
-	gameState->player->MoveTowardDestination(TimeElapsed);
+	//Music is mixed straight from the archive as it plays, so it is only looked up here, not paged in
+	SoundLoad musicLoads[] =
+	{
+		{ &sounds[SoundIntro], "Audio/intro.wav" },
+		{ &sounds[SoundBackground + 0], "Audio/background01.wav" },
+		{ &sounds[SoundBackground + 1], "Audio/background02.wav" },
+		{ &sounds[SoundBackground + 2], "Audio/background03.wav" },
+	};
+	for (int i = 0; i < ArrayCount(musicLoads); i++)
+	{
+		musicLoads[i].entry = FindAsset(archive, musicLoads[i].name, AssetSound, &missing);
+	}
+	const ArchiveEntry* meshes[] =
+	{
+		FindAsset(archive, "Models/sphere.mesh", AssetMesh, &missing),
+		FindAsset(archive, "Models/quad.mesh", AssetMesh, &missing),
+	};
 
-	DWORD status;
-	gameState->spaceShipMoveSound->GetStatus(&status);
+	if (!missing.empty())
+	{
+		missing = "Assets.pak is missing these assets, rebuild it with the asset packer:\n" + missing;
+		MessageBoxA(0, missing.c_str(), "Missing assets", MB_OK | MB_ICONERROR);
+		ExitProcess(1);
+	}
 
-	//If the player is moving (not at their destination) the enemy will approach them
-	if (playerDistanceToTarget > SHIP_NEAR_THRESHOLD)
+	//Page the assets in on the workers, biggest first so the last job to start is a short one
+	JobQueue jobs(gameMemory->serialLoad ? 1 : 0);
+	for (int i = 0; i < ArrayCount(soundLoads); i++)
 	{
-		if (!(status & DSBSTATUS_PLAYING) && !(status & DSBSTATUS_LOOPING))
-		{
-			PlayWaveFile(gameState->spaceShipMoveSound, 0, true);
-		}
+		const ArchiveEntry* entry = soundLoads[i].entry;
+		jobs.Add([archive, entry]() { archive->Touch(entry); });
 	}
-	else if ((status & DSBSTATUS_PLAYING) || (status & DSBSTATUS_LOOPING))
+	for (int i = 0; i < ArrayCount(textures); i++)
 	{
-		gameState->spaceShipMoveSound->Stop();
+		const ArchiveEntry* entry = textures[i].entry;
+		jobs.Add([archive, entry]() { archive->Touch(entry); });
 	}
-
-	for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
+	for (int i = 0; i < NUM_PLANET_TYPES; i++)
 	{
-		Ship* enemy = gameState->enemies.at(i);
-
-		//Move the enemy towards the player
-		enemy->destination = player->position;
-		enemy->MoveTowardDestination(TimeElapsed);
-
-		float enemyDistFromPlayer = Magnitude(player->position - enemy->position);
-
-		//If the enemy ship gets close enough, TURBOFIRE ROCKETS!
-		if (enemyDistFromPlayer < 100)
-		{
-			enemy->speed = enemy->maxspeed * SHIP_ENEMY_SPEEDBOOST;
-		}
-		else
-		{
-			enemy->speed = enemy->maxspeed;
-		}
-
-		//If the enemy is close enough to the player, deduct 300 energy and generate a new level
-		if (enemyDistFromPlayer < 10)
-		{
-			player->energy -= 300;
-			if (player->energy < 0)
-				player->energy = 0;
-
-			GenerateLevel(gameState, deviceContext, device);
-		}
-
+		const ArchiveEntry* entry = planets[i];
+		jobs.Add([archive, entry]() { archive->Touch(entry); });
 	}
-
-	displayLevelNotClear = false;
-	//Generate a new level if we reach the end and continue
-	if (player->position.x >= gameState->screenWidth - (player->size.x / 2))
+	for (size_t i = 0; i < atlasPages.size(); i++)
 	{
-		if (gameState->enemies.size() > 0)
-		{
-			displayLevelNotClear = true;
-		}
-		else
-		{
-			gameState->currentSector++;
-			GenerateLevel(gameState, deviceContext, device);
-		}	
+		const ArchiveEntry* entry = atlasPages[i];
+		jobs.Add([archive, entry]() { archive->Touch(entry); });
 	}
-
-	//Set near planet to false before every time we check if we are near a planet
-	gameState->nearPlanet = false;
-
-	//Draw all planets generated by the level
-	for (int planetIndex = 0; planetIndex != gameState->planets.size(); planetIndex++)
+	for (int i = 0; i < ArrayCount(meshes); i++)
 	{
-		Planet* planet = gameState->planets[planetIndex];
-		if (!planet->visited)
-		{
-			//If player collides with a planet
-			if (CheckCollision(player->position.x - (player->size.x / 2), player->position.y - (player->size.y / 2), player->size.x, player->size.y,
-				planet->tileX, planet->tileY, gameState->tileWidth, gameState->tileHeight))
-			{
-				gameState->nearPlanet = true;
-				if (input.keyE)
-				{
-					//Load the discovery scene and set planet information for recovery
-					gameState->levelState = LevelState::Discovery;
-					gameState->currentPlanet = planet;
-					gameState->currentPlanetLastPos = planet->position;
-					gameState->currentPlanet->position.x = 0;
-					gameState->currentPlanet->position.y = 0.2f;
-					gameState->currentPlanet->position.z = 2;
-					player->destination = player->position;
-					gameState->spaceShipMoveSound->Stop();
-					return;
-				}
-			}
-		}
-
-		//Update and set position of planet
-		planet->SetPosition(perspectiveMatrices);
-		planet->Update(TimeElapsed);
-
-		//Draw planet
-		OverwriteGPUShaderMatrices(deviceContext, gameState->matrixBuffer, perspectiveMatrices);
-		DrawModel(deviceContext, &gameState->sphereVertexBuffer, planet->texture);
+		const ArchiveEntry* entry = meshes[i];
+		jobs.Add([archive, entry]() { archive->Touch(entry); });
 	}
+	jobs.Run();
 
-	//Iterate through all rockets. We use an iterator because we want to be able to delete rockets when they explode, and continue iterating.
-	vector<Rocket*>::iterator it = gameState->instantiatedRockets.begin();
-	while (it != gameState->instantiatedRockets.end())
+	//Create the resources straight from the archive, textures are already stored the way the GPU wants them
+	for (int i = 0; i < ArrayCount(textures); i++)
 	{
-		Rocket* rocket = *it;
-		
-		//If the rocket hasnt exploded, we can move it and check collisions with the appropriate targets
-		if (!rocket->exploded)
-		{
-			rocket->MoveInDirection(TimeElapsed);
-
-			//If the rocket comes from shooter 0 (player) then we check collisions with enemies, otherwise vice versa
-			if (rocket->shooter == 0)
-			{
-				for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
-				{
-					Ship* enemy = gameState->enemies.at(i);
-
-					//Check collisions with rockets, explode and deal damage if a collision is met
-					if (CheckCollision(rocket->position.x - (rocket->size.x / 2), rocket->position.y - (rocket->size.y / 2), rocket->size.x, rocket->size.y,
-						enemy->position.x - (enemy->size.x / 2), enemy->position.y - (enemy->size.y / 2), enemy->size.x, enemy->size.y))
-					{
-						rocket->exploded = true;
-						enemy->energy -= rocket->damage;
-
-						rocket->explosionTime = time(0);
-						rocket->texture = gameState->explosionTexture;
-						gameState->missileFireSound->Stop();
-						PlayWaveFile(gameState->missileHitSound, -1000);
-					}
-				}			
-			}
-			else
-			{
-				//Check collisions with rockets, explode and deal damage if a collision is met
-				if (CheckCollision(rocket->position.x - (rocket->size.x / 2), rocket->position.y - (rocket->size.y / 2), rocket->size.x, rocket->size.y,
-					player->position.x - (player->size.x / 2), player->position.y - (player->size.y / 2), player->size.x, player->size.y))
-				{
-					rocket->exploded = true;
-					player->energy -= rocket->damage;
-
-					rocket->explosionTime = time(0);
-					rocket->texture = gameState->explosionTexture;
-					gameState->missileFireSound->Stop();
-					PlayWaveFile(gameState->missileHitSound, -1000);
-				}
-			}			
-			
-			//If the rocket goes out of the map, we want to delete it as well
-			if (!(rocket->position.x >= 0 - rocket->size.x && rocket->position.x <= gameState->screenWidth + rocket->size.x &&
-				rocket->position.y >= 0 - rocket->size.y && rocket->position.y <= gameState->screenHeight + rocket->size.y))
-			{
-				rocket->exploded = true;
-				rocket->explosionTime = time(0);
-			}		
-		}
-		//Wait 1 second after exploded to delete the rocket from the iterator (shows explosion for 1sec)
-		else if (difftime(time(0), rocket->explosionTime) > 1)
-		{
-			it = gameState->instantiatedRockets.erase(it);
-			continue;
-		}
-
-		//Draw the rocket
-		DrawTexture2D(deviceContext, gameState, rocket->texture, rocket->position.x - (rocket->size.x / 2), rocket->position.y - (rocket->size.y / 2), rocket->size.x, rocket->size.y, 10, rocket->angle);
-		it++;
+		const ArchiveEntry* entry = textures[i].entry;
+		*textures[i].texture = CreateTextureFromPixels(device, deviceContext, archive->Data(entry), entry->texture.width, entry->texture.height);
 	}
 
-	//Iterate through enemies and draw them at their positions
-	for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
+	const unsigned char* planetSlices[NUM_PLANET_TYPES];
+	for (int i = 0; i < NUM_PLANET_TYPES; i++)
 	{
-		Ship* enemy = gameState->enemies.at(i);
-		DrawTexture2D(deviceContext, gameState, enemy->texture, enemy->position.x - (enemy->size.x / 2), enemy->position.y - (enemy->size.y / 2), enemy->size.x, enemy->size.y, 10, enemy->angle);
+		planetSlices[i] = archive->Data(planets[i]);
 	}
+	gameMemory->planetTextures = CreateTextureArrayFromPixels(device, deviceContext, planetSlices, NUM_PLANET_TYPES, planets[0]->texture.width, planets[0]->texture.height);
 
-	//Draw the player ship
-	DrawTexture2D(deviceContext, gameState, player->texture, player->position.x - (player->size.x / 2), player->position.y - (player->size.y / 2), player->size.x, player->size.y, 20, player->angle);
-}
-
-
-//Function: RunDiscoveryScene(Input input, GameState* gameState, ID3D11DeviceContext* deviceContext)
-//Description: This method runs the discovery scene which allows the player to view a spinning 3d representation of the model,
-//along with allowing them to gather a random amount of energy from the planet.
-//Returns: void.
-void RunDiscoveryScene(Input input, GameState* gameState, ID3D11DeviceContext* deviceContext)
-{
-	MatrixBufferType* perspectiveMatrices = &gameState->perspectiveMatrices;
-
-	Planet* planet = gameState->currentPlanet;
+	LoadAtlasSprites(device, deviceContext, gameMemory, atlasEntries, ArrayCount(atlasEntries), atlasPages);
 
-	//If we press 3 or enter we want to go back to the exploration scene,
-	//if the planet is out of resources it becomes a black hole and is no longer interactable
-	if (input.key3 || input.enter)
+	//The mixer plays sounds in place, from the mapping. Background tracks 4 to 6 reuse the first three.
+	for (int i = 0; i < ArrayCount(soundLoads); i++)
 	{
-		gameState->levelState = LevelState::Exploration;		
-		planet->position = gameState->currentPlanetLastPos;
-		if (planet->science == 0 && planet->energy == 0)
-		{
-			planet->visited = true;
-			planet->texture = gameState->planetTextures[BLACK_HOLE_INDEX];
-		}
-		return;
-	}
-	else if (input.key1)
-	{
-		int newEnergyCount = gameState->player->energy + planet->energy;
-		if (newEnergyCount > 2000)
-		{
-			newEnergyCount = 2000;
-		}
-		gameState->player->energy = newEnergyCount;
-		planet->energy = 0;
+		const ArchiveEntry* entry = soundLoads[i].entry;
+		*soundLoads[i].sound = MixerSoundFromAsset(archive, entry);
 	}
-	else if (input.key2)
+	for (int i = 0; i < ArrayCount(musicLoads); i++)
 	{
-		gameState->player->science += planet->science;
-		gameState->scienceGathered += planet->science;
-		planet->science = 0;
+		const ArchiveEntry* entry = musicLoads[i].entry;
+		*musicLoads[i].sound = MixerSoundFromAsset(archive, entry);
 	}
+	sounds[SoundBackground + 3] = sounds[SoundBackground + 0];
+	sounds[SoundBackground + 4] = sounds[SoundBackground + 1];
+	sounds[SoundBackground + 5] = sounds[SoundBackground + 2];
 
-	planet->Update(TimeElapsed);
-
-	//Position and draw the planet in the middle of the screen
-	planet->SetPosition(perspectiveMatrices);
-	OverwriteGPUShaderMatrices(deviceContext, gameState->matrixBuffer, perspectiveMatrices);
-	DrawModel(deviceContext, &gameState->sphereVertexBuffer, planet->texture);
-
-	//Draw the ship beside the planet
-	DrawTexture2D(deviceContext, gameState, gameState->player->texture, (gameState->screenWidth - gameState->tileWidth) / 4.0f, (gameState->screenHeight - gameState->tileHeight) / 2.0f, gameState->tileWidth * 2, gameState->tileHeight * 2, 20, 0);
-}
-
-
-//Function: RunGameOverScene(Input input, GameState* gameState)
-//Description: This method runs the game over scene which just checks for an enter and brings the player to the start screen.
-//Returns: void.
-void RunGameOverScene(Input input, GameState* gameState)
-{
-	if (input.enter)
+	//Meshes are read in place, the vertices go from the mapping straight into the buffers
+	MeshData sphere = {};
+	MeshData quad = {};
+	if (!ReadMesh(archive->Data(meshes[0]), (size_t)meshes[0]->size, &sphere) || !ReadMesh(archive->Data(meshes[1]), (size_t)meshes[1]->size, &quad))
 	{
-		gameState->levelState = LevelState::Start;
+		MessageBoxA(0, "Assets.pak has a broken mesh, rebuild it with the asset packer.", "Missing assets", MB_OK | MB_ICONERROR);
+		ExitProcess(1);
 	}
+	gameMemory->sphereVertexBuffer = CreateMeshBuffer(device, sphere);
+	gameMemory->quadVertexBuffer = CreateMeshBuffer(device, quad);
+	gameMemory->spriteRenderer.Initialize(device);
+	gameMemory->planetRenderer.Initialize(device);
 }
 
 
-//Function: CheckCollision(int x1, int y1, int width1, int height1, int x2, int y2, int width2, int height2)
-//Description: This method uses standard AABB collision detection in order to detect collisions using the position and size of the vectors
-//Returns: void.
-bool CheckCollision(int x1, int y1, int width1, int height1, int x2, int y2, int width2, int height2)
+//Function: CreateMeshBuffer(ID3D11Device* device, const MeshData& mesh)
+//Description: This method creates static vertex and index buffers holding a mesh. Meshes without indices get no index buffer.
+//Returns: DXBuffer = The vertex buffer.
+DXBuffer CreateMeshBuffer(ID3D11Device* device, const MeshData& mesh)
 {
-	if (x1 + width1 < x2 || x1 > x2 + width2)
-		return false;
-	if (y1 + height1 < y2 || y1 > y2 + height2)
-		return false;
-
-	return true;
-}
+	static_assert(sizeof(MeshVertex) == sizeof(VertexType), "Mesh vertices have to match the vertex shader input");
 
+	DXBuffer vertexBuffer;
+	D3D11_BUFFER_DESC vertexBufferDesc;
+	D3D11_SUBRESOURCE_DATA vertexData;
 
-#pragma region Level Generation
+	vertexBuffer.data = 0;
+	vertexBuffer.size = (int)mesh.vertexCount;
+	vertexBuffer.indices = 0;
+	vertexBuffer.indexCount = (int)mesh.indexCount;
+	if (mesh.vertexCount == 0)
+		return vertexBuffer;
 
+	// Set up the description of the static vertex buffer.
+	vertexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	vertexBufferDesc.ByteWidth = sizeof(VertexType) * mesh.vertexCount;
+	vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	vertexBufferDesc.CPUAccessFlags = 0;
+	vertexBufferDesc.MiscFlags = 0;
+	vertexBufferDesc.StructureByteStride = 0;
 
-//Function: InitializeSectorBattle(GameState* gameState)
-//Description: This method initializes the ships in the sector depending on what sector it is. It uses an algorithm to get the
-//number of enemies, their shooting rates, whether it is a boss level, and the rockets they use. This is my first shot at "Procedural" level design,
-//but works more like a pattern than anything :)
-//Returns: void.
-void InitializeSectorBattle(GameState* gameState)
-{
-	Vector2 shipSize = Vector2{ (float)gameState->tileWidth, (float)gameState->tileHeight };
-
-	int sector = gameState->currentSector;
-	int numberOfEnemies = 1 + (((sector % 10) - 1) / 3);
-
-	//Reposition player
-	Vector2 playerStartPos = Vector2{ (float)gameState->tileWidth, (float)gameState->screenHeight / 2.0f };
-	gameState->player->position = playerStartPos;
-	gameState->player->destination = playerStartPos;
-	gameState->player->speed = SHIP_PLAYER_SPEED;
+	// Give the subresource structure a pointer to the vertex data.
+	vertexData.pSysMem = mesh.vertices;
+	vertexData.SysMemPitch = 0;
+	vertexData.SysMemSlicePitch = 0;
 
-	gameState->enemies.clear();
+	// Now create the vertex buffer.
+	device->CreateBuffer(&vertexBufferDesc, &vertexData, &vertexBuffer.data);
 
-	//Every 10 levels there is a boss phase that gets increasingly harder
-	if (sector % 10 == 0)
+	//The indices are used as they are stored, 32 bits each
+	if (mesh.indexCount > 0)
 	{
-		//Boss index and energy
-		int bossIndex = (sector / 10 > 2) ? 2 : (sector / 10) - 1;
-		int bossEnergy = 2000 + (2000 * (sector / 10));
+		D3D11_BUFFER_DESC indexBufferDesc = vertexBufferDesc;
+		indexBufferDesc.ByteWidth = sizeof(uint32_t) * mesh.indexCount;
+		indexBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 
-		//Set the boss abilities to use the boss rockets
-		Ability bossAbilities[NUM_ABILITIES] = { bossRocket1, bossRocket2, bossRocket3 };
-		
-		//Initialize the boss
-		Ship* boss = new Ship(0.0f, gameState->enemySpawnpoints[0], shipSize * 2, gameState->bossTextures[bossIndex], bossEnergy, bossAbilities);
-		boss->cooldown = 1;
-		boss->boss = true;
+		D3D11_SUBRESOURCE_DATA indexData = {};
+		indexData.pSysMem = mesh.indices;
+		device->CreateBuffer(&indexBufferDesc, &indexData, &vertexBuffer.indices);
+	}
 
-		//Get minion ability and energy info
-		Ability minionAbilities[NUM_ABILITIES] = { enemy2Laser, enemy2Laser, enemy2Laser };
-		int minionEnergy = 100 + (100 * (sector / 10));
+	return vertexBuffer;
+}
 
-		//Initialize minions
-		Ship* minion1 = new Ship(SHIP_ENEMY_SPEED, gameState->enemySpawnpoints[1], shipSize, gameState->enemyTextures[1], minionEnergy, minionAbilities);
-		Ship* minion2 = new Ship(SHIP_ENEMY_SPEED, gameState->enemySpawnpoints[2], shipSize, gameState->enemyTextures[1], minionEnergy, minionAbilities);
 
-		//Add enemies to the list of enemies
-		gameState->enemies.push_back(boss);
-		gameState->enemies.push_back(minion1);
-		gameState->enemies.push_back(minion2);
-	}
-	else
+//Function: FindAsset(const AssetArchive* archive, char* name, AssetType type, std::string* missing)
+//Description: This method looks an asset up in the archive. Assets that are not there, or are not of the type the game
+//expects, are added to the missing list one per line.
+//Returns: const ArchiveEntry* = the entry of the asset, 0 if it is missing.
+const ArchiveEntry* FindAsset(const AssetArchive* archive, char* name, AssetType type, std::string* missing)
+{
+	const ArchiveEntry* entry = archive->Find(name);
+	if (!entry || entry->type != type)
 	{
-		//Loop through the number of enemies that we are spawning and get their information based on algorithms
-		for (int i = 0; i < numberOfEnemies; i++)
-		{
-			//Get the speed multiplier. Alternates every 3 for boost of 1, 1.25 and 1.5 then repeated. 
-			//Every 10th is disregarded and starts again at the 1
-			float speedMultiplier = 0.75f + ((float)((((sector % 10) - 1) % 3) + 1) / 4);
-			
-			//Get the starting information for the enemy
-			Vector2 enemyStartPos = gameState->enemySpawnpoints[i];
-			float enemySpeed = SHIP_ENEMY_SPEED * speedMultiplier;
-			TextureHandle texture = gameState->enemyTextures[0];
-			int energy = 100 + (sector * 25);
-			
-			//Get enemy abilities
-			Ability abilities[3] = { enemy1Rocket1, enemy1Rocket2, enemy1Rocket3 };
-			
-			//If there are 3 enemies, we want the middle one to be the second type of rocket, with some different traits.
-			if (numberOfEnemies == 3 && i == 0)
-			{
-				enemySpeed += 10;
-				texture = gameState->enemyTextures[1];
-				energy += 100;
-				abilities[0] = enemy2Laser;
-				abilities[1] = enemy2Laser;
-				abilities[2] = enemy2Laser;
-			}
-
-			//Initialize the enemy object and add it to enemies
-			Ship* enemy = new Ship(enemySpeed, enemyStartPos, shipSize, texture, energy, abilities);
-			gameState->enemies.push_back(enemy);
-		}
+		missing->append(name).append("\n");
+		return 0;
 	}
+
+	return entry;
 }
 
 
-//Function: GenerateLevel()
-//Description: This method generates a random level by choosing a random universe background, placing a random number of planets
-//and positioning them with randomized values.
+//Function: LoadAtlasSprites(ID3D11Device* device, ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, AtlasEntry* entries, int entryCount, const std::vector<const ArchiveEntry*>& pages)
+//Description: This method creates a texture per atlas page, with only the mips the padding between the sprites covers, and
+//gives every entry the region of its page the asset packer put it in.
 //Returns: void.
-void GenerateLevel(GameState* gameState, ID3D11DeviceContext* deviceContext, ID3D11Device* device)
+void LoadAtlasSprites(ID3D11Device* device, ID3D11DeviceContext* deviceContext, GameMemory* gameMemory, AtlasEntry* entries, int entryCount, const std::vector<const ArchiveEntry*>& pages)
 {
-	//The last background index to stop the previous music that was playing
-	int lastBackgroundIndex = gameState->backgroundIndex;
-	gameState->backgroundIndex = rand() % NUM_BACKGROUNDS;
-
-	//Clear planets
-	vector<Planet*>::iterator it1 = gameState->planets.begin();
-	while (it1 != gameState->planets.end())
+	//Release the pages of a previous load
+	for (size_t i = 0; i < gameMemory->atlasPages.size(); i++)
 	{
-		delete (*it1);
-		gameState->planets.erase(it1);
+		if (gameMemory->atlasPages[i])
+			gameMemory->atlasPages[i]->Release();
 	}
+	gameMemory->atlasPages.clear();
 
-	//Clear rockets
-	vector<Rocket*>::iterator it2 = gameState->instantiatedRockets.begin();
-	while (it2 != gameState->instantiatedRockets.end())
+	const AssetArchive* archive = gameMemory->archive;
+	for (size_t i = 0; i < pages.size(); i++)
 	{
-		delete (*it2);
-		gameState->instantiatedRockets.erase(it2);
+		const ArchiveEntry* page = pages[i];
+		gameMemory->atlasPages.push_back(CreateTextureFromPixels(device, deviceContext, archive->Data(page), page->texture.width, page->texture.height, ATLAS_MIP_LEVELS));
 	}
 
-	//Loop through all tiles and randomly assign planets to their positions
-	for (int tileY = 0; tileY != TILE_SIZE; tileY++)
+	for (int i = 0; i < entryCount; i++)
 	{
-		for (int tileX = 0; tileX != TILE_SIZE; tileX++)
-		{
-			if (rand() % 20 == 0)
-			{
-				if (gameState->planets.size() < MAX_PLANETS)
-				{
-					XMFLOAT3 newPosition = {};
-
-					//Set the planets position. I toyed around with a lot of these values to get the look and feel we want (THANK YOU REAL-TIME CODE RECOMPILATION)
-					newPosition.z = 9;
-					newPosition.x = (((float)tileX / (float)TILE_SIZE) * 23.0f) - 10.3f;
-					newPosition.y = (((float)tileY / (float)TILE_SIZE) * 17.5f) - 7.9f;
-
-					XMFLOAT3 newRotationAxis = XMFLOAT3{ (float)(rand() % 100), (float)(rand() % 100) , (float)(rand() % 100) };
-					float newRotationSpeed = ((float)(rand() % 100) / 100.f) * 0.5f + 0.5f;
-
-					int planetIndex = rand() % (NUM_PLANET_TYPES - 1);
-
-					//Set the texture to a new random planet texture and set its position (Our last planet type is the black hole, dont use it for normal planets (subtract 1))
-					TextureHandle newTexture = gameState->planetTextures[planetIndex];
-					string newName = gameState->planetNames[planetIndex];
-
-					int newTileX = tileX * gameState->tileWidth;
-					int newTileY = tileY * gameState->tileHeight;
-
-					//Initialize energy and science, science goes up per 10 sectors
-					int energy = (rand() % 180) + 20;
-					int science = (rand() % 350) + 100 + (100 * (gameState->currentSector / 10));
-
-					//Create new planet
-					Planet* newPlanet = new Planet(device, deviceContext, newRotationSpeed, newPosition, newTexture);
-					newPlanet->rotationAxis = newRotationAxis;
-					newPlanet->angle = 0.0f;
-					newPlanet->tileX = newTileX;
-					newPlanet->tileY = newTileY;
-					newPlanet->energy = energy;
-					newPlanet->science = science;
-					newPlanet->name = newName;
-
-					gameState->planets.push_back(newPlanet);
-				}
-			}
-		}
+		const ArchiveSpriteInfo& sprite = entries[i].entry->sprite;
+		const ArchiveTextureInfo& page = pages[sprite.page]->texture;
+
+		SpriteRegion* region = entries[i].region;
+		region->texture = gameMemory->atlasPages[sprite.page];
+		region->u = (float)sprite.x / page.width;
+		region->v = (float)sprite.y / page.height;
+		region->width = (float)sprite.width / page.width;
+		region->height = (float)sprite.height / page.height;
 	}
+}
 
-	//Initialize the sector
-	InitializeSectorBattle(gameState);
 
-	//Set start to exploration to start the exploration
-	gameState->levelState = LevelState::Exploration;
+//Function: FlushSprites(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory)
+//Description: This method binds the orthographic matrices and draws every queued sprite.
+//Returns: bool = whether any sprites were drawn, which leaves the sprite shader bound.
+bool FlushSprites(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory)
+{
+	PROFILE_SCOPE("DrawSprites");
 
-	//Switch music tracks to the appropriate background music
-	gameState->backgroundMusic[lastBackgroundIndex]->Stop();
-	PlayWaveFile(gameState->backgroundMusic[gameState->backgroundIndex], -1000, true);
-}
+	if (gameMemory->spriteRenderer.instances.empty())
+		return false;
 
-#pragma endregion
+	//The sprite transforms are built in the shader, so only the camera changes
+	gameMemory->renderState.SetVSConstantBuffer(0, gameMemory->orthoBuffer);
 
+	gameMemory->spriteRenderer.Flush(&gameMemory->renderState, &gameMemory->quadVertexBuffer, &gameMemory->renderStats);
+	return true;
+}
 
-#pragma region Drawing
 
-// Function: OverwriteGPUShaderMatrices()
-// Description: This method overwrites the shader matrices(world, view, projection) with the new mapped resource every time we wish to draw
-// a new texture. It also transposes the matrices to prepare them to be rendered.
-// Returns: void.
-void OverwriteGPUShaderMatrices(ID3D11DeviceContext* deviceContext, ID3D11Buffer* matrixBuffer, MatrixBufferType* matrices)
+//Function: FlushPlanets(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory)
+//Description: This method binds the perspective matrices and draws every queued planet with one instanced draw, then binds
+//the texture pixel shader the sprites use again.
+//Returns: bool = whether any planets were drawn.
+bool FlushPlanets(ID3D11DeviceContext* deviceContext, GameMemory* gameMemory)
 {
-	D3D11_MAPPED_SUBRESOURCE mappedResource = {};
-	deviceContext->Map(matrixBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
-
-	//Loop through the matrices and set their information from the mapped resource
-	MatrixBufferType* shaderMatrices = (MatrixBufferType*)mappedResource.pData;
-	for (int i = 0; i < ArrayCount(matrices->array); i++)
-	{
-		shaderMatrices->array[i] = XMMatrixTranspose(matrices->array[i]);
-	}
+	PROFILE_SCOPE("DrawPlanets");
 
-	deviceContext->Unmap(matrixBuffer, 0);
-}
+	if (gameMemory->planetRenderer.instances.empty())
+		return false;
 
-//Function: DrawTexture2D(ID3D11DeviceContext* deviceContext, GameState* gameState, TextureHandle texture, int x, int y, int width, int height, int zOrder, float angle)
-//Description: This method initializes the orthographic matrices for the positions of the objects and draws them to a quad.
-//Returns: void.
-void DrawTexture2D(ID3D11DeviceContext* deviceContext, GameState* gameState, TextureHandle texture, int x, int y, int width, int height, int zOrder, float angle)
-{
-	gameState->orthoMatrices.world = XMMatrixRotationZ(angle);
-	gameState->orthoMatrices.world = XMMatrixMultiply(gameState->orthoMatrices.world, XMMatrixScaling(width / 2, height / 2, 1.0));
-	gameState->orthoMatrices.world = XMMatrixMultiply(gameState->orthoMatrices.world, XMMatrixTranslation(x + width / 2, y + height / 2, zOrder));
-	OverwriteGPUShaderMatrices(deviceContext, gameState->matrixBuffer, &gameState->orthoMatrices);
+	//Every planet carries its own world matrix, so only the camera changes
+	gameMemory->renderState.SetVSConstantBuffer(0, gameMemory->perspectiveBuffer);
 
-	deviceContext->PSSetShaderResources(0, 1, &texture);
-	gameState->quadVertexBuffer.Draw(deviceContext);
+	gameMemory->planetRenderer.Flush(&gameMemory->renderState, &gameMemory->sphereVertexBuffer, gameMemory->planetTextures, &gameMemory->renderStats);
+	gameMemory->renderState.SetPixelShader(gameMemory->pixelShader);
+	return true;
 }
 
 
-//Function: DrawModel()
-//Description: This method draws a planet by setting the shader resources and then drawing the vertex buffer
-//Returns: void.
-void DrawModel(ID3D11DeviceContext* deviceContext, DXBuffer* vertexBuffer, TextureHandle texture)
+//Function: PlanetWorldMatrix(const RenderCommand& command)
+//Description: This method positions the planet by first rotating, then scaling and finally translating
+//Returns: XMMATRIX = the world matrix of the planet.
+XMMATRIX PlanetWorldMatrix(const RenderCommand& command)
 {
-	deviceContext->PSSetShaderResources(0, 1, &texture);
-	vertexBuffer->Draw(deviceContext);
+	XMFLOAT3 rotationAxis = XMFLOAT3{ command.rotationAxis.x, command.rotationAxis.y, command.rotationAxis.z };
+	XMMATRIX world = XMMatrixMultiply(XMMatrixRotationAxis(XMLoadFloat3(&rotationAxis), command.angle), XMMatrixRotationX(XM_PI / 2));
+	world = XMMatrixMultiply(world, XMMatrixScaling(0.85f, 0.85f, 0.85f));
+	world = XMMatrixMultiply(world, XMMatrixTranslation(command.position.x, command.position.y, command.position.z));
+	return world;
 }
 
 #pragma endregion
\ No newline at end of file
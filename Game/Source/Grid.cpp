@@ -0,0 +1,150 @@
+/*
+File Name:		Grid.cpp
+Description:	This file holds the uniform grid broadphase for rocket collisions. Ships are only moved between tiles when the
+				range of tiles they overlap changes, so keeping the grid up to date costs next to nothing when ships are slow.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Grid.h"
+
+
+//Function: Initialize(int tilesX, int tilesY, float tileWidth, float tileHeight)
+//Description: This method sizes the grid to the tile layout of the screen and empties it.
+//Returns: void.
+void ShipGrid::Initialize(int tilesX, int tilesY, float tileWidth, float tileHeight)
+{
+	this->tilesX = tilesX;
+	this->tilesY = tilesY;
+	this->tileWidth = tileWidth;
+	this->tileHeight = tileHeight;
+	this->tiles.resize(tilesX * tilesY);
+	Clear();
+}
+
+
+//Function: Clear()
+//Description: This method removes every ship from the grid. The ships themselves are not touched, so they must not be
+//removed or updated again afterwards.
+//Returns: void.
+void ShipGrid::Clear()
+{
+	for (size_t i = 0, size = this->tiles.size(); i != size; i++)
+	{
+		this->tiles[i].clear();
+	}
+}
+
+
+//Function: Update(Ship* ship)
+//Description: This method inserts a ship into the grid, or moves it to the tiles its bounding box overlaps now. If the ship
+//still overlaps the same tiles as last time nothing is done.
+//Returns: void.
+void ShipGrid::Update(Ship* ship)
+{
+	int minX, minY, maxX, maxY;
+	TileRange(ship->position.x - (ship->size.x / 2), ship->position.y - (ship->size.y / 2), ship->size.x, ship->size.y, &minX, &minY, &maxX, &maxY);
+
+	if (ship->inGrid)
+	{
+		if (minX == ship->gridMinX && minY == ship->gridMinY && maxX == ship->gridMaxX && maxY == ship->gridMaxY)
+			return;
+
+		Remove(ship);
+	}
+
+	ship->inGrid = true;
+	ship->gridMinX = minX;
+	ship->gridMinY = minY;
+	ship->gridMaxX = maxX;
+	ship->gridMaxY = maxY;
+
+	for (int tileY = minY; tileY <= maxY; tileY++)
+	{
+		for (int tileX = minX; tileX <= maxX; tileX++)
+		{
+			this->tiles[tileY * this->tilesX + tileX].push_back(ship);
+		}
+	}
+}
+
+
+//Function: Remove(Ship* ship)
+//Description: This method removes a ship from every tile it was stored in, swapping the last ship of the tile into its slot.
+//Returns: void.
+void ShipGrid::Remove(Ship* ship)
+{
+	if (!ship->inGrid)
+		return;
+
+	for (int tileY = ship->gridMinY; tileY <= ship->gridMaxY; tileY++)
+	{
+		for (int tileX = ship->gridMinX; tileX <= ship->gridMaxX; tileX++)
+		{
+			std::vector<Ship*>& tile = this->tiles[tileY * this->tilesX + tileX];
+			for (size_t i = 0, size = tile.size(); i != size; i++)
+			{
+				if (tile[i] == ship)
+				{
+					tile[i] = tile.back();
+					tile.pop_back();
+					break;
+				}
+			}
+		}
+	}
+
+	ship->inGrid = false;
+}
+
+
+//Function: Query(float x, float y, float width, float height)
+//Description: This method finds the ships stored in the tiles the box overlaps. A ship stored in several of those tiles is only
+//reported from the first tile it shares with the box, so every ship is returned once. The results still need a narrowphase test.
+//Returns: std::vector<Ship*>& = the candidate ships, valid until the next query.
+std::vector<Ship*>& ShipGrid::Query(float x, float y, float width, float height)
+{
+	this->results.clear();
+
+	int minX, minY, maxX, maxY;
+	TileRange(x, y, width, height, &minX, &minY, &maxX, &maxY);
+
+	for (int tileY = minY; tileY <= maxY; tileY++)
+	{
+		for (int tileX = minX; tileX <= maxX; tileX++)
+		{
+			std::vector<Ship*>& tile = this->tiles[tileY * this->tilesX + tileX];
+			for (size_t i = 0, size = tile.size(); i != size; i++)
+			{
+				Ship* ship = tile[i];
+
+				//Only report the ship from the first tile the box and the ship both overlap
+				int firstX = (minX > ship->gridMinX) ? minX : ship->gridMinX;
+				int firstY = (minY > ship->gridMinY) ? minY : ship->gridMinY;
+				if (tileX == firstX && tileY == firstY)
+				{
+					this->results.push_back(ship);
+				}
+			}
+		}
+	}
+
+	return this->results;
+}
+
+
+//Function: TileRange(float x, float y, float width, float height, int* minX, int* minY, int* maxX, int* maxY)
+//Description: This method gets the range of tiles a box overlaps. Anything off the screen is clamped into the border tiles.
+//Returns: void.
+void ShipGrid::TileRange(float x, float y, float width, float height, int* minX, int* minY, int* maxX, int* maxY)
+{
+	int tileMinX = (int)floorf(x / this->tileWidth);
+	int tileMinY = (int)floorf(y / this->tileHeight);
+	int tileMaxX = (int)floorf((x + width) / this->tileWidth);
+	int tileMaxY = (int)floorf((y + height) / this->tileHeight);
+
+	*minX = (tileMinX < 0) ? 0 : (tileMinX >= this->tilesX) ? this->tilesX - 1 : tileMinX;
+	*minY = (tileMinY < 0) ? 0 : (tileMinY >= this->tilesY) ? this->tilesY - 1 : tileMinY;
+	*maxX = (tileMaxX < 0) ? 0 : (tileMaxX >= this->tilesX) ? this->tilesX - 1 : tileMaxX;
+	*maxY = (tileMaxY < 0) ? 0 : (tileMaxY >= this->tilesY) ? this->tilesY - 1 : tileMaxY;
+}
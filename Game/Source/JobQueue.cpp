@@ -0,0 +1,68 @@
+/*
+File Name:		JobQueue.cpp
+Description:	This file holds the definition of the job queue and the method to run it on worker threads.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/JobQueue.h"
+#include <atomic>
+#include <thread>
+
+
+//Function: JobQueue(int maxThreads)
+//Description: This is the constructor for a job queue. A queue limited to 1 thread runs every job on the calling thread.
+//Returns: void.
+JobQueue::JobQueue(int maxThreads)
+{
+	this->maxThreads = maxThreads;
+}
+
+
+//Function: Add(std::function<void()> job)
+//Description: This method queues a job. Jobs are started in the order they were added, so the slowest should go first.
+//Returns: void.
+void JobQueue::Add(std::function<void()> job)
+{
+	this->jobs.push_back(job);
+}
+
+
+//Function: Run()
+//Description: This method runs every queued job, one worker per hardware thread up to maxThreads with the calling thread being one of them.
+//Each worker takes the next job that has not been started until there are none left. It returns once all of them finished.
+//Returns: void.
+void JobQueue::Run()
+{
+	std::atomic<size_t> nextJob(0);
+	std::vector<std::function<void()>>& jobs = this->jobs;
+
+	auto worker = [&]()
+	{
+		for (size_t job = nextJob++; job < jobs.size(); job = nextJob++)
+		{
+			jobs[job]();
+		}
+	};
+
+	size_t threadCount = std::thread::hardware_concurrency();
+	if (this->maxThreads > 0 && threadCount > (size_t)this->maxThreads)
+		threadCount = this->maxThreads;
+	if (threadCount > jobs.size())
+		threadCount = jobs.size();
+
+	std::vector<std::thread> threads;
+	for (size_t i = 1; i < threadCount; i++)
+	{
+		threads.push_back(std::thread(worker));
+	}
+
+	worker();
+
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		threads[i].join();
+	}
+
+	this->jobs.clear();
+}
@@ -0,0 +1,155 @@
+/*
+File Name:		MappedFile.cpp
+Description:	This file holds the definition of the memory-mapped file and the methods to map and unmap it.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/MappedFile.h"
+
+#if defined(_WIN32)
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+//Function: MappedFile()
+//Description: This is the constructor for a mapped file. Nothing is mapped until Open is called.
+//Returns: void.
+MappedFile::MappedFile()
+{
+	this->data = 0;
+	this->size = 0;
+
+#if defined(_WIN32)
+	this->fileHandle = INVALID_HANDLE_VALUE;
+	this->mappingHandle = 0;
+#else
+	this->fileDescriptor = -1;
+#endif
+}
+
+
+//Function: ~MappedFile()
+//Description: This is the destructor for a mapped file, it unmaps the file if it is still open.
+//Returns: void.
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+
+//Function: Open(const char* fileName)
+//Description: This method maps a whole file read-only. An empty file opens successfully with no data.
+//Returns: bool = whether the file was mapped.
+bool MappedFile::Open(const char* fileName)
+{
+	Close();
+
+#if defined(_WIN32)
+	this->fileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (this->fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(this->fileHandle, &fileSize))
+	{
+		Close();
+		return false;
+	}
+
+	this->size = (size_t)fileSize.QuadPart;
+	if (this->size == 0)
+		return true;
+
+	this->mappingHandle = CreateFileMappingA(this->fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!this->mappingHandle)
+	{
+		Close();
+		return false;
+	}
+
+	this->data = (const unsigned char*)MapViewOfFile(this->mappingHandle, FILE_MAP_READ, 0, 0, 0);
+#else
+	this->fileDescriptor = open(fileName, O_RDONLY);
+	if (this->fileDescriptor < 0)
+		return false;
+
+	struct stat fileInfo;
+	if (fstat(this->fileDescriptor, &fileInfo) != 0)
+	{
+		Close();
+		return false;
+	}
+
+	this->size = (size_t)fileInfo.st_size;
+	if (this->size == 0)
+		return true;
+
+	void* mapping = mmap(0, this->size, PROT_READ, MAP_PRIVATE, this->fileDescriptor, 0);
+	this->data = (mapping == MAP_FAILED) ? 0 : (const unsigned char*)mapping;
+#endif
+
+	if (!this->data)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+
+//Function: Close()
+//Description: This method unmaps the file and closes its handles. It is safe to call on a file that is not open.
+//Returns: void.
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+	if (this->data)
+		UnmapViewOfFile(this->data);
+	if (this->mappingHandle)
+		CloseHandle(this->mappingHandle);
+	if (this->fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(this->fileHandle);
+
+	this->fileHandle = INVALID_HANDLE_VALUE;
+	this->mappingHandle = 0;
+#else
+	if (this->data)
+		munmap((void*)this->data, this->size);
+	if (this->fileDescriptor >= 0)
+		close(this->fileDescriptor);
+
+	this->fileDescriptor = -1;
+#endif
+
+	this->data = 0;
+	this->size = 0;
+}
+
+
+//Function: Touch()
+//Description: This method reads one byte of every page so the whole file is paged in now instead of on first use.
+//Returns: void.
+void MappedFile::Touch() const
+{
+	Touch(0, this->size);
+}
+
+
+//Function: Touch(size_t offset, size_t size)
+//Description: This method reads one byte of every page in part of the file.
+//Returns: void.
+void MappedFile::Touch(size_t offset, size_t size) const
+{
+	volatile unsigned char sum = 0;
+	for (size_t i = 0; i < size; i += MAPPED_FILE_PAGE_SIZE)
+	{
+		sum += this->data[offset + i];
+	}
+}
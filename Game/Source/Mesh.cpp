@@ -0,0 +1,292 @@
+/*
+File Name:		Mesh.cpp
+Description:	This file holds the methods to read and write the binary mesh format, and the optimizations the packer runs on
+				meshes before writing them. The triangle order comes from Tipsify (Sander, Nehab and Barczak, 2007).
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Mesh.h"
+#include <string.h>
+#include <algorithm>
+
+
+//Function: ReadMesh(const unsigned char* data, size_t size, MeshData* mesh)
+//Description: This method checks the header and points the mesh at the vertices and indices that follow it. Nothing is copied.
+//The data has to be 4 byte aligned, which every asset in the archive is.
+//Returns: bool = whether the data holds a whole mesh whose indices are all in range.
+bool ReadMesh(const unsigned char* data, size_t size, MeshData* mesh)
+{
+	if (size < sizeof(MeshHeader))
+		return false;
+
+	const MeshHeader* header = (const MeshHeader*)data;
+	if (header->magic != MESH_MAGIC || header->version != MESH_VERSION)
+		return false;
+
+	size_t available = size - sizeof(MeshHeader);
+	if (header->vertexCount > available / sizeof(MeshVertex))
+		return false;
+
+	available -= header->vertexCount * sizeof(MeshVertex);
+	if (header->indexCount > available / sizeof(uint32_t))
+		return false;
+
+	mesh->vertices = (const MeshVertex*)(data + sizeof(MeshHeader));
+	mesh->vertexCount = header->vertexCount;
+	mesh->indices = (const uint32_t*)(mesh->vertices + header->vertexCount);
+	mesh->indexCount = header->indexCount;
+
+	for (uint32_t i = 0; i < mesh->indexCount; i++)
+	{
+		if (mesh->indices[i] >= mesh->vertexCount)
+			return false;
+	}
+
+	return true;
+}
+
+
+//Function: WriteMesh(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices, std::vector<unsigned char>* bytes)
+//Description: This method lays a mesh out in the binary format.
+//Returns: void.
+void WriteMesh(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices, std::vector<unsigned char>* bytes)
+{
+	MeshHeader header;
+	header.magic = MESH_MAGIC;
+	header.version = MESH_VERSION;
+	header.vertexCount = (uint32_t)vertices.size();
+	header.indexCount = (uint32_t)indices.size();
+
+	size_t vertexBytes = vertices.size() * sizeof(MeshVertex);
+	size_t indexBytes = indices.size() * sizeof(uint32_t);
+	bytes->resize(sizeof(MeshHeader) + vertexBytes + indexBytes);
+
+	unsigned char* destination = bytes->data();
+	memcpy(destination, &header, sizeof(MeshHeader));
+	if (vertexBytes)
+		memcpy(destination + sizeof(MeshHeader), vertices.data(), vertexBytes);
+	if (indexBytes)
+		memcpy(destination + sizeof(MeshHeader) + vertexBytes, indices.data(), indexBytes);
+}
+
+
+//Function: WeldMesh(const std::vector<MeshVertex>& triangles, std::vector<MeshVertex>* vertices, std::vector<uint32_t>* indices)
+//Description: This method turns a plain triangle list into an indexed one. Vertices that are exactly the same, position and
+//texture coordinate, become one vertex. Vertices keep the order they are first used in.
+//Returns: void.
+void WeldMesh(const std::vector<MeshVertex>& triangles, std::vector<MeshVertex>* vertices, std::vector<uint32_t>* indices)
+{
+	uint32_t count = (uint32_t)triangles.size();
+
+	//Sort the corners so equal vertices end up next to each other, ties keep their original order
+	std::vector<uint32_t> order(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&triangles](uint32_t a, uint32_t b)
+	{
+		return memcmp(&triangles[a], &triangles[b], sizeof(MeshVertex)) < 0;
+	});
+
+	//Every corner points at the first corner with the same vertex
+	std::vector<uint32_t> first(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		bool same = i > 0 && memcmp(&triangles[order[i]], &triangles[order[i - 1]], sizeof(MeshVertex)) == 0;
+		first[order[i]] = same ? first[order[i - 1]] : order[i];
+	}
+
+	vertices->clear();
+	indices->resize(count);
+	std::vector<uint32_t> remap(count, UINT32_MAX);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint32_t corner = first[i];
+		if (remap[corner] == UINT32_MAX)
+		{
+			remap[corner] = (uint32_t)vertices->size();
+			vertices->push_back(triangles[corner]);
+		}
+
+		(*indices)[i] = remap[corner];
+	}
+}
+
+
+//Function: SkipDeadEnd()
+//Description: This method finds where Tipsify carries on once the fanning vertex has no triangles left. It tries the vertices
+//used most recently first, as they are likely still in the cache, then any vertex with triangles left.
+//Returns: int64_t = the next fanning vertex, -1 once every triangle has been emitted.
+static int64_t SkipDeadEnd(const std::vector<uint32_t>& liveTriangles, std::vector<uint32_t>* deadEnds, uint32_t* cursor)
+{
+	while (!deadEnds->empty())
+	{
+		uint32_t vertex = deadEnds->back();
+		deadEnds->pop_back();
+		if (liveTriangles[vertex] > 0)
+			return vertex;
+	}
+
+	for (; *cursor < liveTriangles.size(); (*cursor)++)
+	{
+		if (liveTriangles[*cursor] > 0)
+			return *cursor;
+	}
+
+	return -1;
+}
+
+
+//Function: OptimizeVertexCache(std::vector<uint32_t>* indices, uint32_t vertexCount, int cacheSize)
+//Description: This method reorders the triangles with Tipsify. It fans around one vertex at a time, emitting all its triangles,
+//then moves to the vertex of those triangles that will still be in the cache after its own triangles are emitted.
+//Returns: void.
+void OptimizeVertexCache(std::vector<uint32_t>* indices, uint32_t vertexCount, int cacheSize)
+{
+	uint32_t triangleCount = (uint32_t)(indices->size() / 3);
+	if (triangleCount == 0)
+		return;
+
+	const std::vector<uint32_t> input = *indices;
+
+	//Triangles that use each vertex, stored as one list with an offset per vertex
+	std::vector<uint32_t> liveTriangles(vertexCount, 0);
+	for (uint32_t i = 0; i < triangleCount * 3; i++)
+	{
+		liveTriangles[input[i]]++;
+	}
+
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (uint32_t v = 0; v < vertexCount; v++)
+	{
+		offsets[v + 1] = offsets[v] + liveTriangles[v];
+	}
+
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	std::vector<uint32_t> filled(offsets.begin(), offsets.end() - 1);
+	for (uint32_t t = 0; t < triangleCount; t++)
+	{
+		for (int corner = 0; corner < 3; corner++)
+		{
+			adjacency[filled[input[t * 3 + corner]]++] = t;
+		}
+	}
+
+	//When each vertex last went into the simulated cache, a vertex is still cached while time - cacheTime <= cacheSize
+	std::vector<uint32_t> cacheTime(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<uint32_t> deadEnds;
+	std::vector<uint32_t> candidates;
+	uint32_t cursor = 0;
+
+	indices->clear();
+	int64_t fanning = SkipDeadEnd(liveTriangles, &deadEnds, &cursor);
+	while (fanning >= 0)
+	{
+		candidates.clear();
+
+		//Emit every triangle around the fanning vertex that has not been emitted yet
+		for (uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; a++)
+		{
+			uint32_t t = adjacency[a];
+			if (emitted[t])
+				continue;
+
+			for (int corner = 0; corner < 3; corner++)
+			{
+				uint32_t vertex = input[t * 3 + corner];
+				indices->push_back(vertex);
+				deadEnds.push_back(vertex);
+				candidates.push_back(vertex);
+				liveTriangles[vertex]--;
+
+				if (time - cacheTime[vertex] > (uint32_t)cacheSize)
+				{
+					cacheTime[vertex] = time;
+					time++;
+				}
+			}
+
+			emitted[t] = true;
+		}
+
+		//Move to the candidate that was cached the longest ago but will still be cached once its own triangles are emitted
+		int64_t next = -1;
+		int64_t bestPriority = -1;
+		for (size_t c = 0; c < candidates.size(); c++)
+		{
+			uint32_t vertex = candidates[c];
+			if (liveTriangles[vertex] == 0)
+				continue;
+
+			int64_t priority = 0;
+			if (time - cacheTime[vertex] + 2 * liveTriangles[vertex] <= (uint32_t)cacheSize)
+				priority = time - cacheTime[vertex];
+
+			if (priority > bestPriority)
+			{
+				bestPriority = priority;
+				next = vertex;
+			}
+		}
+
+		fanning = (next >= 0) ? next : SkipDeadEnd(liveTriangles, &deadEnds, &cursor);
+	}
+}
+
+
+//Function: OptimizeVertexFetch(std::vector<MeshVertex>* vertices, std::vector<uint32_t>* indices)
+//Description: This method reorders the vertices into the order the triangles first use them, so the vertex fetches walk
+//through memory instead of jumping around it. Vertices no triangle uses are dropped.
+//Returns: void.
+void OptimizeVertexFetch(std::vector<MeshVertex>* vertices, std::vector<uint32_t>* indices)
+{
+	std::vector<uint32_t> remap(vertices->size(), UINT32_MAX);
+	std::vector<MeshVertex> ordered;
+	ordered.reserve(vertices->size());
+
+	for (size_t i = 0; i < indices->size(); i++)
+	{
+		uint32_t& index = (*indices)[i];
+		if (remap[index] == UINT32_MAX)
+		{
+			remap[index] = (uint32_t)ordered.size();
+			ordered.push_back((*vertices)[index]);
+		}
+
+		index = remap[index];
+	}
+
+	vertices->swap(ordered);
+}
+
+
+//Function: MeshACMR(const std::vector<uint32_t>& indices, uint32_t vertexCount, int cacheSize)
+//Description: This method runs the triangles through a simulated FIFO post-transform cache and counts the vertices that had
+//to be transformed. A plain triangle list transforms 3 per triangle, a perfect order on a big mesh gets close to 0.5.
+//Returns: float = the average cache miss ratio, transformed vertices per triangle.
+float MeshACMR(const std::vector<uint32_t>& indices, uint32_t vertexCount, int cacheSize)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return 0.0f;
+
+	//A vertex is in the FIFO while fewer than cacheSize misses happened since it went in
+	std::vector<int64_t> insertedAt(vertexCount, -1);
+	int64_t misses = 0;
+	for (size_t i = 0; i < triangleCount * 3; i++)
+	{
+		uint32_t vertex = indices[i];
+		if (insertedAt[vertex] < 0 || misses - insertedAt[vertex] >= cacheSize)
+		{
+			insertedAt[vertex] = misses;
+			misses++;
+		}
+	}
+
+	return (float)misses / (float)triangleCount;
+}
@@ -0,0 +1,183 @@
+/*
+File Name:		MeshCheck.cpp
+Description:	This file is the mesh check. It compares a mesh the asset packer converted with Assimp against a golden copy of
+				it in the repo. Welding and the cache optimization are free to reorder vertices and triangles, and Assimp may
+				parse a coordinate a bit differently from whatever made the golden copy, so the meshes are compared as sets of
+				triangles: every triangle of one must be in the other with the same winding and its corners within a small
+				tolerance. The vertex counts after welding must match exactly.
+				Usage: MeshCheck <archive> <asset name> <golden mesh>
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#include "../Include/Archive.h"
+#include "../Include/MappedFile.h"
+#include "../Include/Mesh.h"
+
+//How far apart two corners may be and still be the same corner, well under the 6 decimals obj files are written with
+#define MESH_CHECK_TOLERANCE 1e-5f
+
+//A triangle as its 3 corners, starting from the smallest so the same triangle always reads the same way
+struct CheckTriangle
+{
+	MeshVertex corners[3];
+};
+
+
+//Function: Key(const MeshVertex& vertex, int component)
+//Description: This method rounds a component of a corner to the tolerance, so corners that differ by less than it sort together.
+//Returns: long long = the rounded component.
+static long long Key(const MeshVertex& vertex, int component)
+{
+	const float* values = &vertex.x;
+	return (long long)floor(values[component] / (MESH_CHECK_TOLERANCE * 10.0f) + 0.5f);
+}
+
+
+//Function: Less(const MeshVertex& a, const MeshVertex& b)
+//Description: This method orders corners by their rounded components.
+//Returns: bool = whether a goes before b.
+static bool Less(const MeshVertex& a, const MeshVertex& b)
+{
+	for (int component = 0; component < 5; component++)
+	{
+		long long keyA = Key(a, component);
+		long long keyB = Key(b, component);
+		if (keyA != keyB)
+			return keyA < keyB;
+	}
+
+	return false;
+}
+
+
+//Function: SameCorner(const MeshVertex& a, const MeshVertex& b)
+//Description: This method checks whether two corners are within the tolerance of each other.
+//Returns: bool = whether they are.
+static bool SameCorner(const MeshVertex& a, const MeshVertex& b)
+{
+	const float* valuesA = &a.x;
+	const float* valuesB = &b.x;
+	for (int component = 0; component < 5; component++)
+	{
+		if (!(fabsf(valuesA[component] - valuesB[component]) <= MESH_CHECK_TOLERANCE))
+			return false;
+	}
+
+	return true;
+}
+
+
+//Function: Triangles(const MeshData& mesh)
+//Description: This method expands a mesh into its triangles, each rotated to start at its smallest corner, and sorts them.
+//Rotating keeps the winding, which a back face culled mesh depends on.
+//Returns: std::vector<CheckTriangle> = the sorted triangles.
+static std::vector<CheckTriangle> Triangles(const MeshData& mesh)
+{
+	uint32_t cornerCount = mesh.indexCount ? mesh.indexCount : mesh.vertexCount;
+
+	std::vector<CheckTriangle> triangles(cornerCount / 3);
+	for (size_t t = 0; t < triangles.size(); t++)
+	{
+		MeshVertex corners[3];
+		for (int c = 0; c < 3; c++)
+		{
+			uint32_t corner = (uint32_t)(t * 3 + c);
+			corners[c] = mesh.vertices[mesh.indexCount ? mesh.indices[corner] : corner];
+		}
+
+		int first = 0;
+		for (int c = 1; c < 3; c++)
+		{
+			if (Less(corners[c], corners[first]))
+				first = c;
+		}
+
+		for (int c = 0; c < 3; c++)
+		{
+			triangles[t].corners[c] = corners[(first + c) % 3];
+		}
+	}
+
+	std::sort(triangles.begin(), triangles.end(), [](const CheckTriangle& a, const CheckTriangle& b)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			if (Less(a.corners[c], b.corners[c]))
+				return true;
+			if (Less(b.corners[c], a.corners[c]))
+				return false;
+		}
+		return false;
+	});
+
+	return triangles;
+}
+
+
+//Function: main()
+//Description: This is the main method of the mesh check.
+//Returns: int = 0 if the packed mesh matches the golden one, 1 otherwise.
+int main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		printf("Usage: MeshCheck <archive> <asset name> <golden mesh>\n");
+		return 1;
+	}
+
+	AssetArchive archive;
+	if (!archive.Open(argv[1]))
+	{
+		printf("MeshCheck: could not open %s\n", argv[1]);
+		return 1;
+	}
+
+	const ArchiveEntry* entry = archive.Find(argv[2]);
+	MeshData packed = {};
+	if (!entry || entry->type != AssetMesh || !ReadMesh(archive.Data(entry), (size_t)entry->size, &packed))
+	{
+		printf("MeshCheck: %s has no mesh %s\n", argv[1], argv[2]);
+		return 1;
+	}
+
+	MappedFile goldenFile;
+	MeshData golden = {};
+	if (!goldenFile.Open(argv[3]) || !ReadMesh(goldenFile.data, goldenFile.size, &golden))
+	{
+		printf("MeshCheck: could not read the golden mesh %s\n", argv[3]);
+		return 1;
+	}
+
+	if (packed.vertexCount != golden.vertexCount || packed.indexCount != golden.indexCount)
+	{
+		printf("MeshCheck: %s has %u vertices and %u indices, the golden mesh %u and %u\n", argv[2], packed.vertexCount, packed.indexCount,
+			golden.vertexCount, golden.indexCount);
+		return 1;
+	}
+
+	std::vector<CheckTriangle> packedTriangles = Triangles(packed);
+	std::vector<CheckTriangle> goldenTriangles = Triangles(golden);
+	for (size_t t = 0; t < goldenTriangles.size(); t++)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			const MeshVertex& a = packedTriangles[t].corners[c];
+			const MeshVertex& b = goldenTriangles[t].corners[c];
+			if (!SameCorner(a, b))
+			{
+				printf("MeshCheck: %s triangle %d corner %d is (%g %g %g %g %g), the golden mesh has (%g %g %g %g %g)\n", argv[2], (int)t, c,
+					a.x, a.y, a.z, a.u, a.v, b.x, b.y, b.z, b.u, b.v);
+				return 1;
+			}
+		}
+	}
+
+	printf("MeshCheck: %s matches %s, %d triangles on %u vertices\n", argv[2], argv[3], (int)goldenTriangles.size(), golden.vertexCount);
+	return 0;
+}
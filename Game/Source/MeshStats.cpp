@@ -0,0 +1,85 @@
+/*
+File Name:		MeshStats.cpp
+Description:	This file is the mesh stats tool. For every obj file given it runs the same welding and vertex cache optimization
+				as the asset packer and reports the vertex counts and the average cache miss ratio (ACMR) before and after,
+				for a few post-transform cache sizes.
+				Usage: MeshStats <obj file>...
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <vector>
+
+#include "../Include/Mesh.h"
+#include "../Include/ObjLoader.h"
+
+//Cache sizes to report, the optimization always targets MESH_CACHE_SIZE
+static const int statCacheSizes[] = { 8, 16, 32 };
+
+
+//Function: PrintACMR(const char* label, const std::vector<uint32_t>& indices, uint32_t vertexCount)
+//Description: This method prints one row of ACMRs, one per cache size.
+//Returns: void.
+static void PrintACMR(const char* label, const std::vector<uint32_t>& indices, uint32_t vertexCount)
+{
+	printf("  %-22s", label);
+	for (int i = 0; i < (int)(sizeof(statCacheSizes) / sizeof(statCacheSizes[0])); i++)
+	{
+		printf("  %6.3f", MeshACMR(indices, vertexCount, statCacheSizes[i]));
+	}
+	printf("\n");
+}
+
+
+//Function: main()
+//Description: This is the main method of the stats tool.
+//Returns: int = 0 if every file was read, 1 if not.
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("Usage: MeshStats <obj file>...\n");
+		return 1;
+	}
+
+	int result = 0;
+	for (int file = 1; file < argc; file++)
+	{
+		std::vector<MeshVertex> triangles;
+		if (!ObjLoader::VerticesFromObj(argv[file], &triangles))
+		{
+			printf("%s: could not be read\n", argv[file]);
+			result = 1;
+			continue;
+		}
+
+		//As it was drawn before, every corner its own vertex
+		std::vector<uint32_t> listIndices(triangles.size());
+		for (size_t i = 0; i < listIndices.size(); i++)
+		{
+			listIndices[i] = (uint32_t)i;
+		}
+
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		WeldMesh(triangles, &vertices, &indices);
+
+		printf("%s: %d triangles, %d vertices welded to %d\n", argv[file], (int)(triangles.size() / 3), (int)triangles.size(), (int)vertices.size());
+		printf("  %-22s", "ACMR, cache size");
+		for (int i = 0; i < (int)(sizeof(statCacheSizes) / sizeof(statCacheSizes[0])); i++)
+		{
+			printf("  %6d", statCacheSizes[i]);
+		}
+		printf("\n");
+
+		PrintACMR("triangle list", listIndices, (uint32_t)triangles.size());
+		PrintACMR("welded", indices, (uint32_t)vertices.size());
+
+		OptimizeVertexCache(&indices, (uint32_t)vertices.size(), MESH_CACHE_SIZE);
+		OptimizeVertexFetch(&vertices, &indices);
+		PrintACMR("welded and optimized", indices, (uint32_t)vertices.size());
+	}
+
+	return result;
+}
@@ -0,0 +1,610 @@
+/*
+File Name:		Mixer.cpp
+Description:	This file holds the methods of the software audio mixer: starting and stopping voices, mixing them into the output
+				stream, and the wave file backend.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Mixer.h"
+#include <math.h>
+#include <string.h>
+
+//SSE2 is always there on x64, elsewhere samples are mixed one at a time
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+	#define MIXER_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define MIXER_SSE2 0
+#endif
+
+
+#pragma region Mixing
+
+//Function: MixSamples(const int16_t* samples, float* output, int count, float gainLeft, float gainRight)
+//Description: This method adds count interleaved stereo samples to the output, the left ones scaled by gainLeft and the right
+//ones by gainRight. The count is even.
+//Returns: void.
+static void MixSamples(const int16_t* samples, float* output, int count, float gainLeft, float gainRight)
+{
+	int i = 0;
+
+#if MIXER_SSE2
+	//Eight samples at a time, each half is widened to 32 bits by shifting it into the top of the lane and back down. A lane
+	//holds two whole frames, so the same left, right scale fits both halves.
+	__m128 scale = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i packed = _mm_loadu_si128((const __m128i*)(samples + i));
+		__m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+		__m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16));
+		_mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(low, scale)));
+		_mm_storeu_ps(output + i + 4, _mm_add_ps(_mm_loadu_ps(output + i + 4), _mm_mul_ps(high, scale)));
+	}
+#endif
+
+	for (; i < count; i += 2)
+	{
+		output[i] += (float)samples[i] * gainLeft;
+		output[i + 1] += (float)samples[i + 1] * gainRight;
+	}
+}
+
+
+//Function: ConvertSamples(const float* mixed, int16_t* output, int count)
+//Description: This method turns mixed samples back into 16 bit ones, clipping anything louder than 16 bits can hold.
+//Returns: void.
+static void ConvertSamples(const float* mixed, int16_t* output, int count)
+{
+	int i = 0;
+
+#if MIXER_SSE2
+	//The clamp comes first, out of range floats would otherwise convert to the most negative integer
+	__m128 lowest = _mm_set1_ps(-32768.0f);
+	__m128 highest = _mm_set1_ps(32767.0f);
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i low = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_load_ps(mixed + i), lowest), highest));
+		__m128i high = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_load_ps(mixed + i + 4), lowest), highest));
+		_mm_storeu_si128((__m128i*)(output + i), _mm_packs_epi32(low, high));
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		float sample = mixed[i];
+		if (sample < -32768.0f)
+			sample = -32768.0f;
+		if (sample > 32767.0f)
+			sample = 32767.0f;
+		output[i] = (int16_t)lrintf(sample);
+	}
+}
+
+
+//Function: Initialize()
+//Description: This method frees every voice.
+//Returns: void.
+void AudioMixer::Initialize()
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	memset(this->voices, 0, sizeof(this->voices));
+	this->playCount = 0;
+}
+
+
+//Function: Play(const MixerSound& sound, float gainLeft, float gainRight, float pitch, bool looping, int tag, int tagLimit)
+//Description: This method starts a sound on a free voice. A pitch of 2 plays it an octave up and twice as fast. A sound too
+//quiet to hear is never started. With a tag limit, once that many voices of the tag play the quietest of them, the oldest
+//if they tie, makes way for the new sound, unless the new one is quieter still, then it is dropped. Otherwise when every
+//voice is busy the oldest sound that does not loop is cut off for it, looping sounds are never taken.
+//Returns: int = the voice the sound plays on, or -1 if it could not be started.
+int AudioMixer::Play(const MixerSound& sound, float gainLeft, float gainRight, float pitch, bool looping, int tag, int tagLimit)
+{
+	float loudness = (gainLeft > gainRight) ? gainLeft : gainRight;
+	if (!sound.data || !sound.frameCount || pitch <= 0.0f || loudness < MIXER_AUDIBLE_GAIN)
+		return -1;
+
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	int chosen = -1;
+	if (tagLimit > 0)
+	{
+		int count = 0;
+		float quietest = 0.0f;
+		for (int i = 0; i < MIXER_MAX_VOICES; i++)
+		{
+			MixerVoice* voice = &this->voices[i];
+			if (!voice->sound.data || voice->tag != tag)
+				continue;
+
+			float voiceLoudness = (voice->gainLeft > voice->gainRight) ? voice->gainLeft : voice->gainRight;
+			if (chosen < 0 || voiceLoudness < quietest ||
+				(voiceLoudness == quietest && this->playCount - voice->started > this->playCount - this->voices[chosen].started))
+			{
+				chosen = i;
+				quietest = voiceLoudness;
+			}
+			count++;
+		}
+
+		if (count < tagLimit)
+		{
+			chosen = -1;
+		}
+		else if (quietest > loudness)
+		{
+			return -1;
+		}
+	}
+
+	if (chosen < 0)
+	{
+		for (int i = 0; i < MIXER_MAX_VOICES; i++)
+		{
+			MixerVoice* voice = &this->voices[i];
+			if (!voice->sound.data)
+			{
+				chosen = i;
+				break;
+			}
+
+			if (!voice->looping && (chosen < 0 || this->playCount - voice->started > this->playCount - this->voices[chosen].started))
+			{
+				chosen = i;
+			}
+		}
+
+		if (chosen < 0)
+			return -1;
+	}
+
+	MixerVoice* voice = &this->voices[chosen];
+	voice->sound = sound;
+	voice->position = 0;
+	voice->step = (uint64_t)((double)pitch * (double)MIXER_UNIT_STEP);
+	voice->gainLeft = gainLeft;
+	voice->gainRight = gainRight;
+	voice->looping = looping;
+	voice->tag = tag;
+	voice->started = this->playCount++;
+	voice->decodedBlock = UINT32_MAX;
+	return chosen;
+}
+
+
+//Function: Stop(int tag)
+//Description: This method stops every voice started with a tag.
+//Returns: void.
+void AudioMixer::Stop(int tag)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	for (int i = 0; i < MIXER_MAX_VOICES; i++)
+	{
+		if (this->voices[i].sound.data && this->voices[i].tag == tag)
+		{
+			this->voices[i].sound.data = 0;
+		}
+	}
+}
+
+
+//Function: IsPlaying(int tag)
+//Description: This method checks whether any voice started with a tag is still playing.
+//Returns: bool = whether one is.
+bool AudioMixer::IsPlaying(int tag)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+	for (int i = 0; i < MIXER_MAX_VOICES; i++)
+	{
+		if (this->voices[i].sound.data && this->voices[i].tag == tag)
+			return true;
+	}
+	return false;
+}
+
+
+//Function: Mix(int16_t* output, int frameCount)
+//Description: This method mixes the next frames of every voice into the output, freeing the voices that reach their end.
+//Returns: void.
+void AudioMixer::Mix(int16_t* output, int frameCount)
+{
+	std::lock_guard<std::mutex> guard(this->lock);
+
+	while (frameCount > 0)
+	{
+		int blockFrames = (frameCount < MIXER_BLOCK_FRAMES) ? frameCount : MIXER_BLOCK_FRAMES;
+		memset(this->accumulator, 0, blockFrames * MIXER_CHANNELS * sizeof(float));
+
+		for (int i = 0; i < MIXER_MAX_VOICES; i++)
+		{
+			if (this->voices[i].sound.data)
+			{
+				this->MixVoice(&this->voices[i], this->accumulator, blockFrames);
+			}
+		}
+
+		ConvertSamples(this->accumulator, output, blockFrames * MIXER_CHANNELS);
+		output += blockFrames * MIXER_CHANNELS;
+		frameCount -= blockFrames;
+	}
+}
+
+
+//Function: MixVoice(MixerVoice* voice, float* output, int frameCount)
+//Description: This method adds the next frames of one voice to the output. Voices at their own pitch are mixed a run of samples
+//at a time, the others step through the sound and blend each pair of frames they land between.
+//Returns: void.
+void AudioMixer::MixVoice(MixerVoice* voice, float* output, int frameCount)
+{
+	uint32_t soundFrames = voice->sound.frameCount;
+
+	int mixed = 0;
+	while (mixed < frameCount)
+	{
+		uint32_t frame = (uint32_t)(voice->position >> 32);
+		uint32_t spanStart;
+		uint32_t spanEnd;
+		const int16_t* frames = this->VoiceFrames(voice, frame, &spanStart, &spanEnd);
+
+		if (voice->step == MIXER_UNIT_STEP)
+		{
+			uint32_t count = spanEnd - frame;
+			if (count > (uint32_t)(frameCount - mixed))
+			{
+				count = (uint32_t)(frameCount - mixed);
+			}
+
+			MixSamples(frames + (frame - spanStart) * MIXER_CHANNELS, output + mixed * MIXER_CHANNELS, (int)count * MIXER_CHANNELS, voice->gainLeft, voice->gainRight);
+			voice->position += (uint64_t)count << 32;
+			mixed += (int)count;
+		}
+		else
+		{
+			int16_t after[MIXER_CHANNELS];
+			this->FrameAfter(voice, spanEnd, after);
+			float gains[MIXER_CHANNELS] = {voice->gainLeft, voice->gainRight};
+
+			for (; mixed < frameCount && frame < spanEnd; frame = (uint32_t)(voice->position >> 32))
+			{
+				const int16_t* current = frames + (frame - spanStart) * MIXER_CHANNELS;
+				const int16_t* next = (frame + 1 < spanEnd) ? current + MIXER_CHANNELS : after;
+
+				float blend = (float)(uint32_t)voice->position * (1.0f / 4294967296.0f);
+				for (int channel = 0; channel < MIXER_CHANNELS; channel++)
+				{
+					float a = (float)current[channel];
+					float b = (float)next[channel];
+					output[mixed * MIXER_CHANNELS + channel] += (a + (b - a) * blend) * gains[channel];
+				}
+
+				voice->position += voice->step;
+				mixed++;
+			}
+		}
+
+		if ((voice->position >> 32) >= soundFrames)
+		{
+			if (!voice->looping)
+			{
+				voice->sound.data = 0;
+				return;
+			}
+
+			voice->position %= (uint64_t)soundFrames << 32;
+		}
+	}
+}
+
+
+//Function: VoiceFrames(MixerVoice* voice, uint32_t frame, uint32_t* spanStart, uint32_t* spanEnd)
+//Description: This method finds the 16 bit frames around a frame of a voice. That is the whole of a sound stored as samples,
+//and the block the frame is in for ADPCM, which is decoded into the voice unless it already was.
+//Returns: const int16_t* = the frames from spanStart up to spanEnd.
+const int16_t* AudioMixer::VoiceFrames(MixerVoice* voice, uint32_t frame, uint32_t* spanStart, uint32_t* spanEnd)
+{
+	if (voice->sound.encoding == MixerPCM16)
+	{
+		*spanStart = 0;
+		*spanEnd = voice->sound.frameCount;
+		return (const int16_t*)voice->sound.data;
+	}
+
+	uint32_t block = frame / ADPCM_BLOCK_FRAMES;
+	if (voice->decodedBlock != block)
+	{
+		AdpcmDecodeBlock((const unsigned char*)voice->sound.data + (size_t)block * ADPCM_BLOCK_BYTES, voice->decoded);
+		voice->decodedBlock = block;
+	}
+
+	*spanStart = block * ADPCM_BLOCK_FRAMES;
+	*spanEnd = *spanStart + ADPCM_BLOCK_FRAMES;
+	if (*spanEnd > voice->sound.frameCount)
+	{
+		*spanEnd = voice->sound.frameCount;
+	}
+	return voice->decoded;
+}
+
+
+//Function: FrameAfter(MixerVoice* voice, uint32_t spanEnd, int16_t* output)
+//Description: This method reads the frame that follows a span, for blending the last frame of it. After the end of the sound
+//that is the first frame of a looping sound and silence otherwise, an ADPCM block is followed by the header of the next one.
+//Returns: void.
+void AudioMixer::FrameAfter(MixerVoice* voice, uint32_t spanEnd, int16_t* output)
+{
+	uint32_t frame = spanEnd;
+	if (frame >= voice->sound.frameCount)
+	{
+		if (!voice->looping)
+		{
+			for (int channel = 0; channel < MIXER_CHANNELS; channel++)
+			{
+				output[channel] = 0;
+			}
+			return;
+		}
+
+		frame = 0;
+	}
+
+	if (voice->sound.encoding == MixerPCM16)
+	{
+		const int16_t* samples = (const int16_t*)voice->sound.data + (size_t)frame * MIXER_CHANNELS;
+		for (int channel = 0; channel < MIXER_CHANNELS; channel++)
+		{
+			output[channel] = samples[channel];
+		}
+	}
+	else
+	{
+		AdpcmFirstFrame((const unsigned char*)voice->sound.data + (size_t)(frame / ADPCM_BLOCK_FRAMES) * ADPCM_BLOCK_BYTES, output);
+	}
+}
+
+#pragma endregion
+
+
+#pragma region Wave Writer
+
+//Function: WriteWaveHeader(FILE* file, uint32_t frameCount)
+//Description: This method writes the header of a 44.1kHz 16bit stereo wave file holding frameCount frames.
+//Returns: void.
+static void WriteWaveHeader(FILE* file, uint32_t frameCount)
+{
+	uint32_t dataSize = frameCount * MIXER_CHANNELS * sizeof(int16_t);
+	uint32_t riffSize = 36 + dataSize;
+	uint32_t formatSize = 16;
+	uint16_t formatTag = 1;
+	uint16_t channels = MIXER_CHANNELS;
+	uint32_t sampleRate = MIXER_SAMPLE_RATE;
+	uint32_t bytesPerSecond = MIXER_SAMPLE_RATE * MIXER_CHANNELS * sizeof(int16_t);
+	uint16_t blockAlign = MIXER_CHANNELS * sizeof(int16_t);
+	uint16_t bitsPerSample = 16;
+
+	fwrite("RIFF", 1, 4, file);
+	fwrite(&riffSize, sizeof(riffSize), 1, file);
+	fwrite("WAVEfmt ", 1, 8, file);
+	fwrite(&formatSize, sizeof(formatSize), 1, file);
+	fwrite(&formatTag, sizeof(formatTag), 1, file);
+	fwrite(&channels, sizeof(channels), 1, file);
+	fwrite(&sampleRate, sizeof(sampleRate), 1, file);
+	fwrite(&bytesPerSecond, sizeof(bytesPerSecond), 1, file);
+	fwrite(&blockAlign, sizeof(blockAlign), 1, file);
+	fwrite(&bitsPerSample, sizeof(bitsPerSample), 1, file);
+	fwrite("data", 1, 4, file);
+	fwrite(&dataSize, sizeof(dataSize), 1, file);
+}
+
+
+//Function: WaveWriterBackend(const char* fileName)
+//Description: This method sets up the backend to write to fileName, or to write nothing if it is 0.
+//Returns: n/a.
+WaveWriterBackend::WaveWriterBackend(const char* fileName)
+{
+	this->fileName = fileName;
+	this->file = 0;
+	this->mixer = 0;
+	this->framesWritten = 0;
+}
+
+
+//Function: Start(AudioMixer* mixer)
+//Description: This method opens the wave file, its header is filled in once the length is known.
+//Returns: bool = whether the file could be opened.
+bool WaveWriterBackend::Start(AudioMixer* mixer)
+{
+	this->mixer = mixer;
+	this->framesWritten = 0;
+
+	if (!this->fileName)
+		return true;
+
+	this->file = fopen(this->fileName, "wb");
+	if (!this->file)
+		return false;
+
+	WriteWaveHeader(this->file, 0);
+	return true;
+}
+
+
+//Function: Render(int frameCount)
+//Description: This method mixes the next frameCount frames and writes them out.
+//Returns: void.
+void WaveWriterBackend::Render(int frameCount)
+{
+	if (!this->mixer)
+		return;
+
+	int16_t block[MIXER_BLOCK_FRAMES * MIXER_CHANNELS];
+	while (frameCount > 0)
+	{
+		int blockFrames = (frameCount < MIXER_BLOCK_FRAMES) ? frameCount : MIXER_BLOCK_FRAMES;
+		this->mixer->Mix(block, blockFrames);
+		if (this->file)
+		{
+			fwrite(block, sizeof(int16_t) * MIXER_CHANNELS, blockFrames, this->file);
+		}
+
+		this->framesWritten += (uint32_t)blockFrames;
+		frameCount -= blockFrames;
+	}
+}
+
+
+//Function: Stop()
+//Description: This method writes the final header and closes the wave file.
+//Returns: void.
+void WaveWriterBackend::Stop()
+{
+	if (this->file)
+	{
+		fseek(this->file, 0, SEEK_SET);
+		WriteWaveHeader(this->file, this->framesWritten);
+		fclose(this->file);
+		this->file = 0;
+	}
+
+	this->mixer = 0;
+}
+
+#pragma endregion
+
+
+//Function: VolumeToGain(long volume)
+//Description: This method turns a volume in hundredths of a decibel, the way DirectSound and the audio commands give it, into
+//the factor the samples are scaled by. 0 is full volume, -2000 is a tenth of it.
+//Returns: float = the gain.
+float VolumeToGain(long volume)
+{
+	return powf(10.0f, (float)volume / 2000.0f);
+}
+
+
+//Function: SpatialGains(Vector2 offset, float screenWidth, float screenHeight, float* left, float* right)
+//Description: This method works out the gain of each side for a sound offset from the player. Within SPATIAL_NEAR of the
+//screen diagonal it plays at full level, past that it falls off with distance and is brought smoothly down to silence at
+//SPATIAL_FAR. It is panned by how far left or right it is, half a screen width away being all the way to one side, with a
+//constant power pan boosted so a centred sound keeps its full level on both sides.
+//Returns: void.
+void SpatialGains(Vector2 offset, float screenWidth, float screenHeight, float* left, float* right)
+{
+	float diagonal = sqrtf(screenWidth * screenWidth + screenHeight * screenHeight);
+	float nearDistance = diagonal * SPATIAL_NEAR;
+	float farDistance = diagonal * SPATIAL_FAR;
+	float distance = sqrtf(offset.x * offset.x + offset.y * offset.y);
+
+	float attenuation = 0.0f;
+	if (distance < farDistance)
+	{
+		float fade = (distance > nearDistance) ? (distance - nearDistance) / (farDistance - nearDistance) : 0.0f;
+		attenuation = nearDistance / ((distance > nearDistance) ? distance : nearDistance) * (1.0f - fade * fade);
+	}
+
+	float pan = (screenWidth > 0.0f) ? offset.x / (screenWidth * 0.5f) : 0.0f;
+	if (pan < -1.0f)
+		pan = -1.0f;
+	if (pan > 1.0f)
+		pan = 1.0f;
+
+	//Hard to one side the other comes out a hair under zero, so both are held between zero and one
+	float angle = (pan + 1.0f) * 0.78539816f;
+	float leftPan = 1.41421356f * cosf(angle);
+	float rightPan = 1.41421356f * sinf(angle);
+	*left = attenuation * ((leftPan < 0.0f) ? 0.0f : (leftPan > 1.0f) ? 1.0f : leftPan);
+	*right = attenuation * ((rightPan < 0.0f) ? 0.0f : (rightPan > 1.0f) ? 1.0f : rightPan);
+}
+
+
+//Function: SoundVoiceLimit(SoundId sound)
+//Description: This method gives the most voices a sound can have at once. The battle sounds fire in bursts and get a handful,
+//so a crowded fight does not spend the whole pool on them, everything else plays once at a time.
+//Returns: int = the limit.
+static int SoundVoiceLimit(SoundId sound)
+{
+	switch (sound)
+	{
+	case SoundMissileFire:
+	case SoundMissileHit:
+		return 8;
+	default:
+		return 1;
+	}
+}
+
+
+//Function: MixerSoundFromAsset(const AssetArchive* archive, const ArchiveEntry* entry)
+//Description: This method wraps a sound in the asset archive for playing, in place. Sounds are 44.1kHz stereo, either 16 bit
+//samples or ADPCM blocks, which the packer marks with 4 bits per sample.
+//Returns: MixerSound = the sound, with no data if it is in any other format or shorter than its frame count says.
+MixerSound MixerSoundFromAsset(const AssetArchive* archive, const ArchiveEntry* entry)
+{
+	MixerSound sound = {};
+	if (!entry || entry->type != AssetSound || entry->sound.sampleRate != MIXER_SAMPLE_RATE || entry->sound.channels != MIXER_CHANNELS)
+		return sound;
+
+	uint32_t frameCount = entry->sound.frameCount;
+	if (entry->sound.bitsPerSample == 16 && entry->size >= (uint64_t)frameCount * MIXER_CHANNELS * sizeof(int16_t))
+	{
+		sound.encoding = MixerPCM16;
+	}
+	else if (entry->sound.bitsPerSample == 4 && entry->size >= AdpcmSize(frameCount))
+	{
+		sound.encoding = MixerADPCM;
+	}
+	else
+	{
+		return sound;
+	}
+
+	sound.frameCount = frameCount;
+	sound.data = frameCount ? archive->Data(entry) : 0;
+	return sound;
+}
+
+
+//Function: PlayAudioCommands(AudioMixer* mixer, const MixerSound* sounds, const std::vector<AudioCommand>& commands, float screenWidth, float screenHeight)
+//Description: This method plays, loops and stops the sounds a simulation step asked for, in the order they were emitted. Voices
+//are tagged with their SoundId, so a stop reaches every copy of the sound playing, and each sound is held to its voice limit.
+//Positional sounds are panned and faded by their offset from the player on a screen of the size given.
+//Returns: void.
+void PlayAudioCommands(AudioMixer* mixer, const MixerSound* sounds, const std::vector<AudioCommand>& commands, float screenWidth, float screenHeight)
+{
+	for (size_t i = 0, size = commands.size(); i != size; i++)
+	{
+		const AudioCommand& command = commands[i];
+
+		//Sounds that failed to load are skipped
+		const MixerSound& sound = sounds[command.sound];
+		if (!sound.data)
+			continue;
+
+		float gainLeft = VolumeToGain(command.volume);
+		float gainRight = gainLeft;
+		if (command.positional)
+		{
+			float left;
+			float right;
+			SpatialGains(command.offset, screenWidth, screenHeight, &left, &right);
+			gainLeft *= left;
+			gainRight *= right;
+		}
+
+		switch (command.type)
+		{
+		case AudioPlay:
+			mixer->Play(sound, gainLeft, gainRight, 1.0f, false, command.sound, SoundVoiceLimit(command.sound));
+			break;
+		case AudioLoop:
+			if (!mixer->IsPlaying(command.sound))
+			{
+				mixer->Play(sound, gainLeft, gainRight, 1.0f, true, command.sound);
+			}
+			break;
+		case AudioStop:
+			mixer->Stop(command.sound);
+			break;
+		}
+	}
+}
@@ -0,0 +1,490 @@
+/*
+File Name:		MixerCheck.cpp
+Description:	This file is the audio mixer check. It plays made up sounds through the mixer with no sound device, renders them
+				with the wave writer backend into a wave file and reads the samples back. It checks that a voice off its own
+				pitch blends the frames it lands between, that a full pool gives the oldest sound that does not loop to a new
+				one and never a looping one, that stopping a tag silences every voice with it and no other, and that voices
+				louder together than 16 bits can hold clip rather than wrap around. For the battlefield sounds it checks the
+				panning and falloff of SpatialGains, that a tag held to a voice limit gives up its quietest voice only to a
+				louder sound, and that sounds too quiet or too far away to hear never get a voice.
+				Usage: MixerCheck [wave file]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "../Include/Mixer.h"
+
+//Frames in the ramp sound, its left side climbs by RAMP_STEP a frame and its right side falls by the same
+#define RAMP_FRAMES 1000
+#define RAMP_STEP 8
+
+//The screen the spatial checks place sounds on, its diagonal is 1000
+#define CHECK_SCREEN_WIDTH 800.0f
+#define CHECK_SCREEN_HEIGHT 600.0f
+
+//The size of a wave header as the wave writer writes it
+#define WAVE_HEADER_SIZE 44
+
+static const char* waveName = "MixerCheck.wav";
+
+
+//Function: Render(AudioMixer* mixer, int frameCount, std::vector<int16_t>* samples)
+//Description: This method mixes the next frameCount frames into the wave file with the wave writer backend and reads them back.
+//The header must give the length of what was written.
+//Returns: bool = whether the file was written and read back whole.
+static bool Render(AudioMixer* mixer, int frameCount, std::vector<int16_t>* samples)
+{
+	WaveWriterBackend backend(waveName);
+	if (!backend.Start(mixer))
+	{
+		printf("MixerCheck: could not write %s\n", waveName);
+		return false;
+	}
+	backend.Render(frameCount);
+	backend.Stop();
+
+	FILE* file = fopen(waveName, "rb");
+	if (!file)
+	{
+		printf("MixerCheck: could not read %s back\n", waveName);
+		return false;
+	}
+
+	unsigned char header[WAVE_HEADER_SIZE];
+	samples->assign((size_t)frameCount * MIXER_CHANNELS, 0);
+	bool read = fread(header, 1, WAVE_HEADER_SIZE, file) == WAVE_HEADER_SIZE &&
+		fread(samples->data(), sizeof(int16_t), samples->size(), file) == samples->size() && fgetc(file) == EOF;
+	fclose(file);
+
+	uint32_t dataSize = (uint32_t)header[40] | ((uint32_t)header[41] << 8) | ((uint32_t)header[42] << 16) | ((uint32_t)header[43] << 24);
+	if (!read || dataSize != (uint32_t)frameCount * MIXER_CHANNELS * sizeof(int16_t))
+	{
+		printf("MixerCheck: %s does not hold the %d frames rendered\n", waveName, frameCount);
+		return false;
+	}
+
+	return true;
+}
+
+
+//Function: CheckPitch(AudioMixer* mixer, const MixerSound& ramp, float pitch)
+//Description: This method plays the ramp at a pitch. Blending between frames keeps a ramp a ramp, so frame n of the output must
+//be the ramp at n times the pitch, until the last frame of the sound, which blends into the silence after it. After that the
+//voice must be free and the output silent.
+//Returns: bool = whether the output was the ramp at that pitch.
+static bool CheckPitch(AudioMixer* mixer, const MixerSound& ramp, float pitch)
+{
+	mixer->Initialize();
+	mixer->Play(ramp, 1.0f, 1.0f, pitch, false, 0);
+
+	int soundFrames = (int)ceil(RAMP_FRAMES / pitch);
+	std::vector<int16_t> samples;
+	if (!Render(mixer, soundFrames + 100, &samples))
+		return false;
+
+	for (int n = 0; n < soundFrames + 100; n++)
+	{
+		double position = n * (double)pitch;
+		if (position >= RAMP_FRAMES - 1 && n < soundFrames)
+			continue;
+
+		double expected = (n < soundFrames) ? position * RAMP_STEP : 0.0;
+		for (int channel = 0; channel < MIXER_CHANNELS; channel++)
+		{
+			double sample = samples[n * MIXER_CHANNELS + channel];
+			double channelExpected = (channel == 0) ? expected : -expected;
+			if (fabs(sample - channelExpected) > 1.0)
+			{
+				printf("MixerCheck: at pitch %g frame %d channel %d is %g, expected %g\n", pitch, n, channel, sample, channelExpected);
+				return false;
+			}
+		}
+	}
+
+	if (mixer->IsPlaying(0))
+	{
+		printf("MixerCheck: at pitch %g the voice still plays after the end of the sound\n", pitch);
+		return false;
+	}
+
+	return true;
+}
+
+
+//Function: CheckStealing(AudioMixer* mixer, const MixerSound& ramp)
+//Description: This method fills the pool, the first sound looping, and plays one more. It must take the voice of the oldest
+//sound that does not loop. With every voice looping there is no voice to take and the new sound must not start.
+//Returns: bool = whether the right voices were taken.
+static bool CheckStealing(AudioMixer* mixer, const MixerSound& ramp)
+{
+	mixer->Initialize();
+	for (int tag = 0; tag < MIXER_MAX_VOICES; tag++)
+	{
+		if (mixer->Play(ramp, 1.0f, 1.0f, 1.0f, tag == 0, tag) < 0)
+		{
+			printf("MixerCheck: sound %d did not start with free voices left\n", tag);
+			return false;
+		}
+	}
+
+	mixer->Play(ramp, 1.0f, 1.0f, 1.0f, false, MIXER_MAX_VOICES);
+	if (!mixer->IsPlaying(0) || mixer->IsPlaying(1) || !mixer->IsPlaying(2) || !mixer->IsPlaying(MIXER_MAX_VOICES))
+	{
+		printf("MixerCheck: a new sound on a full pool did not take the voice of the oldest one that does not loop\n");
+		return false;
+	}
+
+	mixer->Initialize();
+	for (int tag = 0; tag < MIXER_MAX_VOICES; tag++)
+	{
+		mixer->Play(ramp, 1.0f, 1.0f, 1.0f, true, tag);
+	}
+
+	if (mixer->Play(ramp, 1.0f, 1.0f, 1.0f, false, MIXER_MAX_VOICES) >= 0 || mixer->IsPlaying(MIXER_MAX_VOICES))
+	{
+		printf("MixerCheck: a new sound took the voice of a looping one\n");
+		return false;
+	}
+
+	for (int tag = 0; tag < MIXER_MAX_VOICES; tag++)
+	{
+		if (!mixer->IsPlaying(tag))
+		{
+			printf("MixerCheck: looping sound %d stopped when the pool was full\n", tag);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//Function: CheckStop(AudioMixer* mixer, const MixerSound& ramp)
+//Description: This method plays three copies of the ramp on one tag, looping, and one on another tag at half level, then stops
+//the first tag. The output must be the other sound alone.
+//Returns: bool = whether only the stopped tag went silent.
+static bool CheckStop(AudioMixer* mixer, const MixerSound& ramp)
+{
+	mixer->Initialize();
+	for (int i = 0; i < 3; i++)
+	{
+		mixer->Play(ramp, 1.0f, 1.0f, 1.0f, true, 7);
+	}
+	mixer->Play(ramp, 0.5f, 0.5f, 1.0f, false, 8);
+
+	std::vector<int16_t> samples;
+	if (!Render(mixer, 10, &samples))
+		return false;
+
+	mixer->Stop(7);
+	if (mixer->IsPlaying(7) || !mixer->IsPlaying(8))
+	{
+		printf("MixerCheck: stopping tag 7 did not stop exactly its voices\n");
+		return false;
+	}
+
+	if (!Render(mixer, 100, &samples))
+		return false;
+
+	for (int n = 0; n < 100; n++)
+	{
+		int expected = (10 + n) * RAMP_STEP / 2;
+		if (samples[n * MIXER_CHANNELS] != expected || samples[n * MIXER_CHANNELS + 1] != -expected)
+		{
+			printf("MixerCheck: frame %d after the stop is %d %d, expected %d %d\n", n, samples[n * MIXER_CHANNELS], samples[n * MIXER_CHANNELS + 1],
+				expected, -expected);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//Function: CheckSaturation(AudioMixer* mixer)
+//Description: This method plays sounds near full scale over each other, which add up to far more than 16 bits can hold, and
+//a quieter looping one that fits alone. Every frame count from 1 to 20 is mixed, so the wide path and the one sample at a time
+//path are both reached.
+//Returns: bool = whether the loud frames clipped to the limits and the quiet one came through exactly once they stopped.
+static bool CheckSaturation(AudioMixer* mixer)
+{
+	static int16_t loud[20 * MIXER_CHANNELS];
+	for (int n = 0; n < 20; n++)
+	{
+		loud[n * MIXER_CHANNELS] = 30000;
+		loud[n * MIXER_CHANNELS + 1] = -30000;
+	}
+	MixerSound sound = { loud, 20, MixerPCM16 };
+
+	for (int frameCount = 1; frameCount <= 20; frameCount++)
+	{
+		mixer->Initialize();
+		for (int i = 0; i < 3; i++)
+		{
+			mixer->Play(sound, 1.0f, 1.0f, 1.0f, false, 0);
+		}
+		mixer->Play(sound, 0.1f, 0.1f, 1.0f, true, 1);
+
+		std::vector<int16_t> samples;
+		if (!Render(mixer, frameCount, &samples))
+			return false;
+
+		for (int n = 0; n < frameCount; n++)
+		{
+			if (samples[n * MIXER_CHANNELS] != 32767 || samples[n * MIXER_CHANNELS + 1] != -32768)
+			{
+				printf("MixerCheck: frame %d of %d mixed to %d %d instead of clipping\n", n, frameCount, samples[n * MIXER_CHANNELS],
+					samples[n * MIXER_CHANNELS + 1]);
+				return false;
+			}
+		}
+
+		mixer->Stop(0);
+		if (!Render(mixer, 1, &samples) || samples[0] != 3000 || samples[1] != -3000)
+		{
+			printf("MixerCheck: a quiet sound alone mixed to %d %d, expected 3000 -3000\n", samples[0], samples[1]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//Function: CheckSpatial()
+//Description: This method places sounds around the player. A sound on the player plays at full level on both sides, one within
+//SPATIAL_NEAR of the diagonal keeps its full level on the side it leans to, half a screen to one side is silent on the other,
+//one straight ahead at twice SPATIAL_NEAR is at half level less the start of the fade, and one at SPATIAL_FAR or past it is
+//silent. Going out from the player in any direction the level never rises, the gains
+//stay between zero and one, and a sound mirrored left to right has its gains swapped.
+//Returns: bool = whether the gains did all that.
+static bool CheckSpatial()
+{
+	float diagonal = sqrtf(CHECK_SCREEN_WIDTH * CHECK_SCREEN_WIDTH + CHECK_SCREEN_HEIGHT * CHECK_SCREEN_HEIGHT);
+	float left;
+	float right;
+
+	SpatialGains(Vector2{ 0.0f, 0.0f }, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT, &left, &right);
+	if (fabsf(left - 1.0f) > 1e-5f || fabsf(right - 1.0f) > 1e-5f)
+	{
+		printf("MixerCheck: a sound on the player has gains %g %g, expected 1 1\n", left, right);
+		return false;
+	}
+
+	SpatialGains(Vector2{ diagonal * SPATIAL_NEAR * 0.8f, 0.0f }, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT, &left, &right);
+	if (!(left < right) || fabsf(right - 1.0f) > 1e-5f)
+	{
+		printf("MixerCheck: a near sound to the right has gains %g %g, expected the right one at 1 and the left one lower\n", left, right);
+		return false;
+	}
+
+	SpatialGains(Vector2{ -CHECK_SCREEN_WIDTH / 2.0f, 0.0f }, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT, &left, &right);
+	if (!(left > 0.0f) || right != 0.0f)
+	{
+		printf("MixerCheck: a sound half a screen to the left has gains %g %g, expected only the left one\n", left, right);
+		return false;
+	}
+
+	//Falling off with distance halves the level, the fade to SPATIAL_FAR takes off the square of how far into it the sound is
+	float fade = SPATIAL_NEAR / (SPATIAL_FAR - SPATIAL_NEAR);
+	float expected = 0.5f * (1.0f - fade * fade);
+	SpatialGains(Vector2{ 0.0f, diagonal * SPATIAL_NEAR * 2.0f }, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT, &left, &right);
+	if (fabsf(left - expected) > 1e-4f || fabsf(right - expected) > 1e-4f)
+	{
+		printf("MixerCheck: a sound ahead at twice SPATIAL_NEAR has gains %g %g, expected %g\n", left, right, expected);
+		return false;
+	}
+
+	SpatialGains(Vector2{ 0.0f, diagonal * SPATIAL_FAR }, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT, &left, &right);
+	if (left != 0.0f || right != 0.0f)
+	{
+		printf("MixerCheck: a sound at SPATIAL_FAR has gains %g %g, expected silence\n", left, right);
+		return false;
+	}
+
+	for (int direction = 0; direction < 16; direction++)
+	{
+		float angle = direction * (2.0f * 3.14159265f / 16.0f);
+		float lastLoudness = 2.0f;
+		for (int step = 0; step <= 120; step++)
+		{
+			float distance = diagonal * step / 100.0f;
+			Vector2 offset = { cosf(angle) * distance, sinf(angle) * distance };
+			SpatialGains(offset, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT, &left, &right);
+
+			float mirroredLeft;
+			float mirroredRight;
+			SpatialGains(Vector2{ -offset.x, offset.y }, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT, &mirroredLeft, &mirroredRight);
+
+			float loudness = (left > right) ? left : right;
+			if (left < 0.0f || left > 1.0f || right < 0.0f || right > 1.0f || loudness > lastLoudness + 1e-5f ||
+				fabsf(left - mirroredRight) > 1e-5f || fabsf(right - mirroredLeft) > 1e-5f)
+			{
+				printf("MixerCheck: a sound at (%g %g) has gains %g %g, mirrored %g %g, the last step was %g\n", offset.x, offset.y, left, right,
+					mirroredLeft, mirroredRight, lastLoudness);
+				return false;
+			}
+			lastLoudness = loudness;
+		}
+	}
+
+	return true;
+}
+
+
+//Function: CountVoices(AudioMixer* mixer, int tag)
+//Description: This method counts the voices playing with a tag.
+//Returns: int = the count.
+static int CountVoices(AudioMixer* mixer, int tag)
+{
+	int count = 0;
+	for (int i = 0; i < MIXER_MAX_VOICES; i++)
+	{
+		if (mixer->voices[i].sound.data && mixer->voices[i].tag == tag)
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+
+//Function: CheckTagLimit(AudioMixer* mixer, const MixerSound& ramp)
+//Description: This method fills a tag up to a limit of 8, every other sound quieter. A sound quieter than those must be dropped,
+//a louder one must take the voice of the oldest of them, and a sound on another tag must still start. A sound too quiet to hear must not start even
+//with voices free. Then it fires bursts of missiles through PlayAudioCommands, near the player and off past SPATIAL_FAR. The
+//near burst must hold to the voice limit the game gives them and the far one must not start at all.
+//Returns: bool = whether the limits held.
+static bool CheckTagLimit(AudioMixer* mixer, const MixerSound& ramp)
+{
+	mixer->Initialize();
+	int oldestQuiet = -1;
+	for (int i = 0; i < 8; i++)
+	{
+		float gain = (i % 2) ? 0.4f : 0.5f;
+		int voice = mixer->Play(ramp, gain, gain * 0.5f, 1.0f, false, 1, 8);
+		if (i == 1)
+		{
+			oldestQuiet = voice;
+		}
+	}
+
+	if (mixer->Play(ramp, 0.3f, 0.3f, 1.0f, false, 1, 8) >= 0 || CountVoices(mixer, 1) != 8)
+	{
+		printf("MixerCheck: a sound quieter than every voice of a tag at its limit was started\n");
+		return false;
+	}
+
+	if (mixer->Play(ramp, 0.2f, 0.45f, 1.0f, false, 1, 8) != oldestQuiet || CountVoices(mixer, 1) != 8)
+	{
+		printf("MixerCheck: a louder sound on a tag at its limit did not take the voice of the oldest of the quietest\n");
+		return false;
+	}
+
+	if (mixer->Play(ramp, 0.1f, 0.1f, 1.0f, false, 2, 8) < 0)
+	{
+		printf("MixerCheck: a tag at its limit kept another tag from starting\n");
+		return false;
+	}
+
+	if (mixer->Play(ramp, MIXER_AUDIBLE_GAIN * 0.5f, MIXER_AUDIBLE_GAIN * 0.9f, 1.0f, false, 3) >= 0)
+	{
+		printf("MixerCheck: a sound below MIXER_AUDIBLE_GAIN was started\n");
+		return false;
+	}
+
+	MixerSound sounds[SoundCount] = {};
+	sounds[SoundMissileFire] = ramp;
+	float diagonal = sqrtf(CHECK_SCREEN_WIDTH * CHECK_SCREEN_WIDTH + CHECK_SCREEN_HEIGHT * CHECK_SCREEN_HEIGHT);
+
+	mixer->Initialize();
+	std::vector<AudioCommand> commands;
+	for (int i = 0; i < 20; i++)
+	{
+		AudioCommand command = {};
+		command.type = AudioPlay;
+		command.sound = SoundMissileFire;
+		command.volume = -1500;
+		command.positional = true;
+		command.offset = Vector2{ diagonal * SPATIAL_FAR * 1.1f, (float)i };
+		commands.push_back(command);
+	}
+	PlayAudioCommands(mixer, sounds, commands, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT);
+	if (CountVoices(mixer, SoundMissileFire) != 0)
+	{
+		printf("MixerCheck: missiles fired past SPATIAL_FAR were given voices\n");
+		return false;
+	}
+
+	for (size_t i = 0; i < commands.size(); i++)
+	{
+		commands[i].offset = Vector2{ (float)i * 10.0f, 0.0f };
+	}
+	PlayAudioCommands(mixer, sounds, commands, CHECK_SCREEN_WIDTH, CHECK_SCREEN_HEIGHT);
+	if (CountVoices(mixer, SoundMissileFire) != 8)
+	{
+		printf("MixerCheck: a burst of 20 missiles played on %d voices, expected the limit of 8\n", CountVoices(mixer, SoundMissileFire));
+		return false;
+	}
+
+	return true;
+}
+
+
+//Function: main()
+//Description: This is the main method of the audio mixer check.
+//Returns: int = 0 if every check passed, 1 otherwise.
+int main(int argc, char** argv)
+{
+	if (argc > 1)
+	{
+		waveName = argv[1];
+	}
+
+	static int16_t rampFrames[RAMP_FRAMES * MIXER_CHANNELS];
+	for (int n = 0; n < RAMP_FRAMES; n++)
+	{
+		rampFrames[n * MIXER_CHANNELS] = (int16_t)(n * RAMP_STEP);
+		rampFrames[n * MIXER_CHANNELS + 1] = (int16_t)(-n * RAMP_STEP);
+	}
+	MixerSound ramp = { rampFrames, RAMP_FRAMES, MixerPCM16 };
+
+	//The mixer is too big for the stack
+	AudioMixer* mixer = new AudioMixer();
+
+	const float pitches[] = { 1.0f, 0.5f, 0.75f, 1.5f, 2.0f, 3.3f };
+	for (size_t i = 0; i < sizeof(pitches) / sizeof(pitches[0]); i++)
+	{
+		if (!CheckPitch(mixer, ramp, pitches[i]))
+			return 1;
+	}
+	printf("MixerCheck: %d pitches blend between frames\n", (int)(sizeof(pitches) / sizeof(pitches[0])));
+
+	if (!CheckStealing(mixer, ramp))
+		return 1;
+	printf("MixerCheck: a full pool gives up the oldest voice that does not loop\n");
+
+	if (!CheckStop(mixer, ramp))
+		return 1;
+	printf("MixerCheck: stopping a tag stops every voice with it and no other\n");
+
+	if (!CheckSaturation(mixer))
+		return 1;
+	printf("MixerCheck: loud mixes clip at the limits of 16 bits\n");
+
+	if (!CheckSpatial())
+		return 1;
+	printf("MixerCheck: positional sounds pan and fade with their offset from the player\n");
+
+	if (!CheckTagLimit(mixer, ramp))
+		return 1;
+	printf("MixerCheck: tags hold to their voice limits and sounds nobody can hear get no voice\n");
+
+	remove(waveName);
+	return 0;
+}
@@ -8,10 +8,10 @@ Date:			April 14, 2017
 #include "../Include/Planet.h"
 
 
-//Function: Planet(ID3D11Device* device, ID3D11DeviceContext* deviceContext, float speed, XMFLOAT3 position, TextureHandle texture)
+//Function: Planet(float speed, Vector3 position, SpriteId texture)
 //Description: This is the constructor for a planet. It initializes all values to their default states
 //Returns: void.
-Planet::Planet(ID3D11Device* device, ID3D11DeviceContext* deviceContext, float speed, XMFLOAT3 position, TextureHandle texture)
+Planet::Planet(float speed, Vector3 position, SpriteId texture)
 {
 	this->texture = texture;
 	this->rotationSpeed = speed;
@@ -31,13 +31,3 @@ void Planet::Update(float timeElapsed)
 {
 	this->angle += this->rotationSpeed * timeElapsed;
 }
-
-//Function: SetPosition()
-//Description: This method positions the planet by first rotating, then scaling and finally translating
-//Returns: void.
-void Planet::SetPosition(MatrixBufferType * perspectiveMatrices)
-{
-	perspectiveMatrices->world = XMMatrixMultiply(XMMatrixRotationAxis(XMLoadFloat3(&this->rotationAxis), this->angle), XMMatrixRotationX(XM_PI / 2));
-	perspectiveMatrices->world = XMMatrixMultiply(perspectiveMatrices->world, XMMatrixScaling(0.85f, 0.85f, 0.85f));
-	perspectiveMatrices->world = XMMatrixMultiply(perspectiveMatrices->world, XMMatrixTranslation(this->position.x, this->position.y, this->position.z));
-}
@@ -0,0 +1,96 @@
+/*
+File Name:		PlanetRenderer.cpp
+Description:	This file holds the definition of the instanced planet renderer and the methods to collect and draw planets.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/PlanetRenderer.h"
+
+
+//Function: Initialize(ID3D11Device* device)
+//Description: This method creates the dynamic instance buffer. It is only created once, so reinitializing the game reuses it.
+//Returns: bool = whether the buffer exists.
+bool PlanetRenderer::Initialize(ID3D11Device* device)
+{
+	if (this->instanceBuffer)
+		return true;
+
+	D3D11_BUFFER_DESC instanceBufferDesc = {};
+	instanceBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	instanceBufferDesc.ByteWidth = sizeof(PlanetInstance) * MAX_PLANET_INSTANCES;
+	instanceBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	instanceBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	HRESULT result = device->CreateBuffer(&instanceBufferDesc, NULL, &this->instanceBuffer);
+	this->bufferUsed = MAX_PLANET_INSTANCES;
+
+	return SUCCEEDED(result);
+}
+
+
+//Function: Push(const XMMATRIX& world, int slice)
+//Description: This method queues a planet for the next flush.
+//Returns: void.
+void PlanetRenderer::Push(const XMMATRIX& world, int slice)
+{
+	PlanetInstance instance;
+	XMStoreFloat4x4(&instance.world, world);
+	instance.slice = (float)slice;
+
+	this->instances.push_back(instance);
+}
+
+
+//Function: Flush(RenderStateCache* renderState, DXBuffer* sphereVertexBuffer, TextureHandle planetTextures, RenderStats* stats)
+//Description: This method draws the queued planets with the perspective matrices that are currently bound. Every planet
+//shares the sphere and the texture array, so a pass is a single DrawInstanced however many planets there are. Like the
+//sprites, the instances are appended to the buffer and it is only discarded when it fills up.
+//The planet shaders and input layout are left bound.
+//Returns: void.
+void PlanetRenderer::Flush(RenderStateCache* renderState, DXBuffer* sphereVertexBuffer, TextureHandle planetTextures, RenderStats* stats)
+{
+	ID3D11DeviceContext* deviceContext = renderState->deviceContext;
+
+	int count = (int)this->instances.size();
+	if (count == 0 || !this->instanceBuffer)
+		return;
+
+	ID3D11Buffer* buffers[2] = { sphereVertexBuffer->data, this->instanceBuffer };
+	UINT strides[2] = { sizeof(VertexType), sizeof(PlanetInstance) };
+	renderState->SetVertexBuffers(2, buffers, strides);
+	renderState->SetIndexBuffer(sphereVertexBuffer->indices);
+	renderState->SetInputLayout(this->layout);
+	renderState->SetVertexShader(this->vertexShader);
+	renderState->SetPixelShader(this->pixelShader);
+	renderState->SetPSResource(1, planetTextures);
+
+	for (int first = 0; first < count;)
+	{
+		//Append to the buffer, discarding it only when this pass does not fit
+		int passCount = (count - first < MAX_PLANET_INSTANCES) ? count - first : MAX_PLANET_INSTANCES;
+		D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+		if (this->bufferUsed + passCount > MAX_PLANET_INSTANCES)
+		{
+			mapType = D3D11_MAP_WRITE_DISCARD;
+			this->bufferUsed = 0;
+		}
+
+		D3D11_MAPPED_SUBRESOURCE mappedResource = {};
+		if (FAILED(deviceContext->Map(this->instanceBuffer, 0, mapType, 0, &mappedResource)))
+			break;
+		stats->mapCalls++;
+
+		PlanetInstance* bufferInstances = (PlanetInstance*)mappedResource.pData + this->bufferUsed;
+		memcpy(bufferInstances, &this->instances[first], passCount * sizeof(PlanetInstance));
+		deviceContext->Unmap(this->instanceBuffer, 0);
+
+		sphereVertexBuffer->DrawInstanced(deviceContext, passCount, this->bufferUsed);
+		stats->drawCalls++;
+
+		this->bufferUsed += passCount;
+		first += passCount;
+	}
+
+	this->instances.clear();
+}
@@ -0,0 +1,206 @@
+/*
+File Name:		Profiler.cpp
+Description:	This file holds the methods of the frame profiler: registering scope names, giving each thread its ring, summing
+				the last frame for the HUD and writing the rings out as a Chrome trace.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Profiler.h"
+#include <stdio.h>
+#include <string.h>
+#include <functional>
+#include <thread>
+
+Profiler* globalProfiler = 0;
+
+//The ring the calling thread writes to, looked up once per thread. A thread gives its ring back when it exits.
+struct ProfileThreadSlot
+{
+	Profiler* profiler;
+	ProfileRing* ring;
+
+	~ProfileThreadSlot()
+	{
+		if (this->ring)
+			this->ring->owner.store(0);
+	}
+};
+static thread_local ProfileThreadSlot threadSlot;
+
+
+//Function: WallSeconds()
+//Description: This method reads the steady clock the time stamp counter is measured against.
+//Returns: double = seconds since an arbitrary point.
+static double WallSeconds()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+//Function: ProfilerRegister(const char* name)
+//Description: This method finds or adds a scope name. Names are copied, so they outlive reloads of the game code.
+//Returns: int = the index of the name, or -1 if there is no profiler or no room for another name.
+int ProfilerRegister(const char* name)
+{
+	Profiler* profiler = globalProfiler;
+	if (!profiler)
+		return -1;
+
+	std::lock_guard<std::mutex> lock(profiler->nameLock);
+	int count = profiler->nameCount.load();
+	for (int i = 0; i < count; i++)
+	{
+		if (!strncmp(profiler->names[i], name, PROFILE_NAME_LENGTH - 1))
+			return i;
+	}
+
+	if (count == PROFILE_MAX_NAMES)
+		return -1;
+
+	strncpy(profiler->names[count], name, PROFILE_NAME_LENGTH - 1);
+	profiler->names[count][PROFILE_NAME_LENGTH - 1] = 0;
+	profiler->nameCount.store(count + 1);
+	return count;
+}
+
+
+//Function: ProfilerThreadRing()
+//Description: This method returns the ring of the calling thread. The first call on a thread looks for the ring it already
+//owns, which the platform code may have claimed, or claims a free one.
+//Returns: ProfileRing* = the ring, or 0 if there is no profiler or every ring is taken.
+ProfileRing* ProfilerThreadRing()
+{
+	Profiler* profiler = globalProfiler;
+	if (threadSlot.profiler == profiler)
+		return threadSlot.ring;
+
+	threadSlot.profiler = profiler;
+	threadSlot.ring = 0;
+	if (!profiler)
+		return 0;
+
+	uint64_t owner = (uint64_t)std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+	for (int i = 0; i < PROFILE_MAX_THREADS; i++)
+	{
+		if (profiler->rings[i].owner.load() == owner)
+		{
+			threadSlot.ring = &profiler->rings[i];
+			return threadSlot.ring;
+		}
+	}
+
+	for (int i = 0; i < PROFILE_MAX_THREADS; i++)
+	{
+		uint64_t unowned = 0;
+		if (profiler->rings[i].owner.compare_exchange_strong(unowned, owner))
+		{
+			profiler->rings[i].depth = 0;
+			threadSlot.ring = &profiler->rings[i];
+			return threadSlot.ring;
+		}
+	}
+
+	return 0;
+}
+
+
+//Function: Initialize()
+//Description: This method starts the clocks the ticks are measured against.
+//Returns: void.
+void Profiler::Initialize()
+{
+	this->startTicks = ProfilerTicks();
+	this->startSeconds = WallSeconds();
+	this->ticksPerSecond = 0.0;
+	this->frameStart = this->startTicks;
+	this->frameMilliseconds = 0.0;
+	memset(this->frameTotals, 0, sizeof(this->frameTotals));
+}
+
+
+//Function: Milliseconds(uint64_t ticks)
+//Description: This method turns a tick count into milliseconds.
+//Returns: double = the milliseconds, 0 until the tick rate is known.
+double Profiler::Milliseconds(uint64_t ticks) const
+{
+	return (this->ticksPerSecond > 0.0) ? (double)ticks * 1000.0 / this->ticksPerSecond : 0.0;
+}
+
+
+//Function: Frame()
+//Description: This method marks the start of a frame from the main thread. The tick rate is measured again against the wall
+//clock since startup, and the events the calling thread wrote since the last frame started are summed by name.
+//Returns: void.
+void Profiler::Frame()
+{
+	uint64_t now = ProfilerTicks();
+	double elapsed = WallSeconds() - this->startSeconds;
+	if (elapsed > 0.0)
+	{
+		this->ticksPerSecond = (double)(now - this->startTicks) / elapsed;
+	}
+
+	memset(this->frameTotals, 0, sizeof(this->frameTotals));
+
+	//Events are written as their scopes end, so walking back from the newest stops at the first that ended before the frame
+	ProfileRing* ring = ProfilerThreadRing();
+	if (ring)
+	{
+		uint32_t written = ring->written.load(std::memory_order_acquire);
+		uint32_t available = (written < PROFILE_RING_SIZE) ? written : PROFILE_RING_SIZE;
+		for (uint32_t i = 1; i <= available; i++)
+		{
+			const ProfileEvent& event = ring->events[(written - i) % PROFILE_RING_SIZE];
+			if (event.end < this->frameStart)
+				break;
+
+			this->frameTotals[event.name].calls++;
+			this->frameTotals[event.name].milliseconds += this->Milliseconds(event.end - event.start);
+		}
+	}
+
+	this->frameMilliseconds = this->Milliseconds(now - this->frameStart);
+	this->frameStart = now;
+}
+
+
+//Function: WriteTrace(const char* fileName)
+//Description: This method writes every event still in the rings as Chrome trace_event JSON. Each ring is a thread of its own,
+//the one of the calling thread is named the main thread.
+//Returns: bool = whether the file was written.
+bool Profiler::WriteTrace(const char* fileName)
+{
+	FILE* file = fopen(fileName, "w");
+	if (!file)
+		return false;
+
+	ProfileRing* mainRing = ProfilerThreadRing();
+	double microsecondsPerTick = (this->ticksPerSecond > 0.0) ? 1000000.0 / this->ticksPerSecond : 0.0;
+
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	const char* separator = "";
+	for (int thread = 0; thread < PROFILE_MAX_THREADS; thread++)
+	{
+		ProfileRing* ring = &this->rings[thread];
+		uint32_t written = ring->written.load(std::memory_order_acquire);
+		if (!written)
+			continue;
+
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}", separator, thread, (ring == mainRing) ? "Main thread" : "Thread", thread);
+		separator = ",\n";
+
+		uint32_t available = (written < PROFILE_RING_SIZE) ? written : PROFILE_RING_SIZE;
+		for (uint32_t i = written - available; i != written; i++)
+		{
+			const ProfileEvent& event = ring->events[i % PROFILE_RING_SIZE];
+			double start = (double)(int64_t)(event.start - this->startTicks) * microsecondsPerTick;
+			double duration = (double)(event.end - event.start) * microsecondsPerTick;
+			fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", this->names[event.name], thread, start, duration);
+		}
+	}
+	fprintf(file, "\n]}\n");
+
+	fclose(file);
+	return true;
+}
@@ -0,0 +1,446 @@
+/*
+File Name:		RenderFrame.cpp
+Description:	This file is the headless frame renderer. It runs the simulation with no window, GPU or sound card, draws the scene
+				it emits with the software renderer the same way Game.cpp draws it with D3D11, and writes the frame to a TGA file.
+				Given a golden image it compares the frame against it channel by channel, and fails when more than -maxpixels
+				pixels, 0 by default, have a channel that differs by more than -tolerance, also 0 by default. It also reports how
+				many frames per second the software renderer draws. The HUD text drawn by the DirectXTK sprite batch is left out.
+				Everything it uses is portable, so it also builds on machines without the Windows SDK.
+				Usage: RenderFrame <archive> <output tga> [-steps n] [-frames n] [-seed n] [-golden tga] [-tolerance n] [-maxpixels n]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../Include/Archive.h"
+#include "../Include/Atlas.h"
+#include "../Include/Mesh.h"
+#include "../Include/Simulation.h"
+#include "../Include/SoftwareRenderer.h"
+#include "../Include/TGA.h"
+
+//The size main.cpp creates the window with
+#define FRAME_WIDTH 800
+#define FRAME_HEIGHT 600
+
+//Same step as SIMULATION_DT in Game.h, which cannot be included without D3D11
+#define HEADLESS_DT (1.0f / 60.0f)
+
+//The part of a texture a sprite is drawn from, like SpriteRegion
+struct HeadlessRegion
+{
+	const SoftwareTexture* texture;
+	float uvRect[4];
+};
+
+//A sprite queued for the next flush
+struct HeadlessSprite
+{
+	const HeadlessRegion* region;
+	float x;
+	float y;
+	float width;
+	float height;
+	int zOrder;
+	float angle;
+};
+
+//Everything a frame is drawn from, the textures point into the archive
+struct HeadlessAssets
+{
+	SoftwareTexture backgrounds[NUM_BACKGROUNDS];
+	SoftwareTexture introBackground;
+	SoftwareTexture introLogo;
+	SoftwareTexture planets[NUM_PLANET_TYPES];
+
+	std::vector<SoftwareTexture> atlasPages;
+
+	HeadlessRegion sprites[SpriteCount];
+	HeadlessRegion energyIcon;
+	HeadlessRegion scienceIcon;
+	HeadlessRegion abilityIcons[4];
+
+	MeshData quad;
+	MeshData sphere;
+};
+
+//The renderer and the matrices of both cameras
+struct HeadlessFrame
+{
+	SoftwareRenderer renderer;
+	SoftwareMatrix perspective;
+	SoftwareMatrix ortho;
+	std::vector<HeadlessSprite> sprites;
+};
+
+
+//Function: FindTexture(const AssetArchive& archive, const char* name, SoftwareTexture* texture, std::string* missing)
+//Description: This method points a texture at the pixels of an archive entry. Missing entries are added to the missing list.
+//Returns: bool = whether the texture was found.
+static bool FindTexture(const AssetArchive& archive, const char* name, SoftwareTexture* texture, std::string* missing)
+{
+	const ArchiveEntry* entry = archive.Find(name);
+	if (!entry || entry->type != AssetTexture)
+	{
+		missing->append(name).append("\n");
+		return false;
+	}
+
+	texture->width = (int)entry->texture.width;
+	texture->height = (int)entry->texture.height;
+	texture->pixels = archive.Data(entry);
+	return true;
+}
+
+
+//Function: FindMesh(const AssetArchive& archive, const char* name, MeshData* mesh, std::string* missing)
+//Description: This method reads a mesh in place from the archive. Missing or broken meshes are added to the missing list.
+//Returns: bool = whether the mesh was read.
+static bool FindMesh(const AssetArchive& archive, const char* name, MeshData* mesh, std::string* missing)
+{
+	const ArchiveEntry* entry = archive.Find(name);
+	if (!entry || entry->type != AssetMesh || !ReadMesh(archive.Data(entry), (size_t)entry->size, mesh))
+	{
+		missing->append(name).append("\n");
+		return false;
+	}
+
+	return true;
+}
+
+
+//Function: LoadHeadlessAssets(const AssetArchive& archive, HeadlessAssets* assets)
+//Description: This method finds every texture and mesh a frame needs, and the atlas page and rectangle of every sprite.
+//Returns: bool = whether every asset was found.
+static bool LoadHeadlessAssets(const AssetArchive& archive, HeadlessAssets* assets)
+{
+	std::string missing;
+
+	for (int i = 0; i < NUM_BACKGROUNDS; i++)
+	{
+		char name[64];
+		sprintf(name, "Textures/universe%d.tga", i + 1);
+		FindTexture(archive, name, &assets->backgrounds[i], &missing);
+	}
+	FindTexture(archive, "Textures/introbackground.tga", &assets->introBackground, &missing);
+	FindTexture(archive, "Textures/logo.tga", &assets->introLogo, &missing);
+
+	const char* planetNames[NUM_PLANET_TYPES] =
+	{
+		"Textures/planet1.tga", "Textures/planet2.tga", "Textures/planet3.tga", "Textures/planet4.tga", "Textures/planet5.tga",
+		"Textures/planet6.tga", "Textures/planet7.tga", "Textures/planet8.tga", "Textures/planet9.tga", "Textures/planet10.tga",
+		"Textures/blackhole.tga",
+	};
+	for (int i = 0; i < NUM_PLANET_TYPES; i++)
+	{
+		FindTexture(archive, planetNames[i], &assets->planets[i], &missing);
+	}
+
+	struct AtlasSprite
+	{
+		HeadlessRegion* region;
+		const char* name;
+	};
+	AtlasSprite atlasSprites[] =
+	{
+		{ &assets->energyIcon, "Textures/energy.tga" },
+		{ &assets->scienceIcon, "Textures/science.tga" },
+		{ &assets->abilityIcons[0], "Textures/ability1icon.tga" },
+		{ &assets->abilityIcons[1], "Textures/ability2icon.tga" },
+		{ &assets->abilityIcons[2], "Textures/ability3icon.tga" },
+		{ &assets->abilityIcons[3], "Textures/ability4icon.tga" },
+		{ &assets->sprites[SpritePlayerRocket + 0], "Textures/rocket1_y.tga" },
+		{ &assets->sprites[SpritePlayerRocket + 1], "Textures/rocket2_y.tga" },
+		{ &assets->sprites[SpritePlayerRocket + 2], "Textures/rocket3_y.tga" },
+		{ &assets->sprites[SpriteEnemyRocket + 0], "Textures/rocket1_r.tga" },
+		{ &assets->sprites[SpriteEnemyRocket + 1], "Textures/rocket2_r.tga" },
+		{ &assets->sprites[SpriteEnemyRocket + 2], "Textures/rocket3_r.tga" },
+		{ &assets->sprites[SpriteEnemyRocket + 3], "Textures/laser_beam.tga" },
+		{ &assets->sprites[SpriteExplosion], "Textures/explosion.tga" },
+		{ &assets->sprites[SpritePlayer], "Textures/ship.tga" },
+		{ &assets->sprites[SpriteEnemy + 0], "Textures/enemy1.tga" },
+		{ &assets->sprites[SpriteEnemy + 1], "Textures/enemy2.tga" },
+		{ &assets->sprites[SpriteBoss + 0], "Textures/enemyboss1.tga" },
+		{ &assets->sprites[SpriteBoss + 1], "Textures/enemyboss2.tga" },
+		{ &assets->sprites[SpriteBoss + 2], "Textures/enemyboss3.tga" },
+	};
+	int atlasSpriteCount = (int)(sizeof(atlasSprites) / sizeof(atlasSprites[0]));
+
+	std::vector<const ArchiveEntry*> spriteEntries(atlasSpriteCount);
+	uint32_t pageCount = 0;
+	for (int i = 0; i < atlasSpriteCount; i++)
+	{
+		const ArchiveEntry* entry = archive.Find(atlasSprites[i].name);
+		if (!entry || entry->type != AssetSprite)
+		{
+			missing.append(atlasSprites[i].name).append("\n");
+			continue;
+		}
+
+		spriteEntries[i] = entry;
+		pageCount = std::max(pageCount, entry->sprite.page + 1);
+	}
+
+	assets->atlasPages.resize(pageCount);
+	for (uint32_t i = 0; i < pageCount; i++)
+	{
+		char name[64];
+		snprintf(name, sizeof(name), ATLAS_PAGE_NAME, (int)i);
+		FindTexture(archive, name, &assets->atlasPages[i], &missing);
+	}
+
+	FindMesh(archive, "Models/quad.mesh", &assets->quad, &missing);
+	FindMesh(archive, "Models/sphere.mesh", &assets->sphere, &missing);
+
+	if (!missing.empty())
+	{
+		printf("RenderFrame: the archive is missing these assets:\n%s", missing.c_str());
+		return false;
+	}
+
+	for (int i = 0; i < atlasSpriteCount; i++)
+	{
+		const ArchiveSpriteInfo& sprite = spriteEntries[i]->sprite;
+		const SoftwareTexture& page = assets->atlasPages[sprite.page];
+
+		HeadlessRegion* region = atlasSprites[i].region;
+		region->texture = &page;
+		region->uvRect[0] = (float)sprite.x / page.width;
+		region->uvRect[1] = (float)sprite.y / page.height;
+		region->uvRect[2] = (float)sprite.width / page.width;
+		region->uvRect[3] = (float)sprite.height / page.height;
+	}
+
+	return true;
+}
+
+
+//Function: FlushSprites(HeadlessFrame* frame, const HeadlessAssets& assets)
+//Description: This method draws the queued sprites in the order SpriteRenderer::Flush does, far sprites first, then by texture.
+//Returns: void.
+static void FlushSprites(HeadlessFrame* frame, const HeadlessAssets& assets)
+{
+	std::stable_sort(frame->sprites.begin(), frame->sprites.end(), [](const HeadlessSprite& a, const HeadlessSprite& b)
+	{
+		if (a.zOrder != b.zOrder)
+			return a.zOrder > b.zOrder;
+		return a.region->texture < b.region->texture;
+	});
+
+	for (size_t i = 0; i < frame->sprites.size(); i++)
+	{
+		const HeadlessSprite& sprite = frame->sprites[i];
+		if (!sprite.region->texture)
+			continue;
+
+		frame->renderer.DrawSprite(assets.quad, frame->ortho, sprite.region->texture, sprite.region->uvRect, sprite.x, sprite.y, sprite.width, sprite.height, sprite.zOrder, sprite.angle);
+	}
+
+	frame->sprites.clear();
+}
+
+
+//Function: QueueSprite(HeadlessFrame* frame, const HeadlessRegion* region, float x, float y, float width, float height, int zOrder, float angle)
+//Description: This method queues a sprite, like DrawTexture2D.
+//Returns: void.
+static void QueueSprite(HeadlessFrame* frame, const HeadlessRegion* region, float x, float y, float width, float height, int zOrder, float angle = 0.0f)
+{
+	frame->sprites.push_back(HeadlessSprite{ region, x, y, width, height, zOrder, angle });
+}
+
+
+//Function: DrawFrame(HeadlessFrame* frame, const HeadlessAssets& assets, const GameState& gameState)
+//Description: This method draws what GameUpdateAndRender draws after the last step: the background, the render commands and
+//the HUD icons, in the same order.
+//Returns: void.
+static void DrawFrame(HeadlessFrame* frame, const HeadlessAssets& assets, const GameState& gameState)
+{
+	frame->renderer.Clear(0.1f, 0.1f, 0.1f);
+
+	HeadlessRegion background = { (gameState.levelState == LevelState::Start) ? &assets.introBackground : &assets.backgrounds[gameState.backgroundIndex], { 0.0f, 0.0f, 1.0f, 1.0f } };
+	if (gameState.levelState != LevelState::GameOver)
+	{
+		QueueSprite(frame, &background, 0, 0, (float)gameState.screenWidth, (float)gameState.screenHeight, 99, VECTOR_PI);
+	}
+
+	//The frame is drawn right after a step, so moving sprites are drawn where the step left them
+	for (size_t i = 0; i < gameState.renderCommands.size(); i++)
+	{
+		const RenderCommand& command = gameState.renderCommands[i];
+
+		if (command.type == RenderPlanet)
+		{
+			FlushSprites(frame, assets);
+
+			SoftwareMatrix world = MatrixMultiply(MatrixRotationAxis(command.rotationAxis.x, command.rotationAxis.y, command.rotationAxis.z, command.angle), MatrixRotationX(VECTOR_PI / 2));
+			world = MatrixMultiply(world, MatrixScaling(0.85f, 0.85f, 0.85f));
+			world = MatrixMultiply(world, MatrixTranslation(command.position.x, command.position.y, command.position.z));
+			frame->renderer.DrawMesh(assets.sphere, MatrixMultiply(world, frame->perspective), &assets.planets[command.sprite - SpritePlanet]);
+		}
+		else
+		{
+			QueueSprite(frame, &assets.sprites[command.sprite], command.x, command.y, command.width, command.height, command.zOrder, command.angle);
+		}
+	}
+
+	if (gameState.levelState == LevelState::Discovery || gameState.levelState == LevelState::Exploration)
+	{
+		QueueSprite(frame, &assets.energyIcon, 10, (float)gameState.screenHeight - 50, 40, 40, 1);
+		QueueSprite(frame, &assets.scienceIcon, 10, (float)gameState.screenHeight - 100, 40, 40, 1, VECTOR_PI);
+		QueueSprite(frame, &assets.abilityIcons[0], 10, 10, 60, 60, 1, VECTOR_PI);
+		QueueSprite(frame, &assets.abilityIcons[1], 80, 10, 60, 60, 1, VECTOR_PI);
+		QueueSprite(frame, &assets.abilityIcons[2], 150, 10, 60, 60, 1, VECTOR_PI);
+		QueueSprite(frame, &assets.abilityIcons[3], 220, 10, 60, 60, 1, VECTOR_PI);
+	}
+	else if (gameState.levelState == LevelState::Start)
+	{
+		HeadlessRegion logo = { &assets.introLogo, { 0.0f, 0.0f, 1.0f, 1.0f } };
+		QueueSprite(frame, &logo, (float)(gameState.screenWidth / 2) - 200, (float)gameState.screenHeight - 150, 400, 100, 1, VECTOR_PI);
+	}
+
+	FlushSprites(frame, assets);
+	frame->renderer.Flush();
+}
+
+
+//Function: CompareGolden(const SoftwareRenderer& renderer, const char* goldenName, int tolerance, int maxPixels)
+//Description: This method compares the frame against a golden image, channel by channel. A golden image made by another
+//compiler can be off by a rounding here and there, which the tolerance allows for, and a math library that rounds a sine the
+//other way can move an edge by a pixel, which the pixels allowed past the tolerance are for.
+//Returns: bool = whether no more than maxPixels pixels have a channel that differs by more than the tolerance.
+static bool CompareGolden(const SoftwareRenderer& renderer, const char* goldenName, int tolerance, int maxPixels)
+{
+	std::vector<unsigned char> golden;
+	int width = 0;
+	int height = 0;
+	if (!ReadTGA(goldenName, &golden, &width, &height))
+	{
+		printf("RenderFrame: could not read the golden image %s\n", goldenName);
+		return false;
+	}
+	if (width != renderer.width || height != renderer.height)
+	{
+		printf("RenderFrame: the golden image is %dx%d, the frame is %dx%d\n", width, height, renderer.width, renderer.height);
+		return false;
+	}
+
+	int differentPixels = 0;
+	int largestDifference = 0;
+	for (size_t i = 0; i < golden.size(); i += 4)
+	{
+		bool different = false;
+		for (int c = 0; c < 3; c++)
+		{
+			int difference = abs((int)golden[i + c] - (int)renderer.colorBuffer[i + c]);
+			largestDifference = (difference > largestDifference) ? difference : largestDifference;
+			different |= difference > tolerance;
+		}
+		differentPixels += different ? 1 : 0;
+	}
+
+	if (differentPixels > maxPixels)
+	{
+		printf("RenderFrame: %d pixels differ from %s, by up to %d\n", differentPixels, goldenName, largestDifference);
+		return false;
+	}
+
+	printf("RenderFrame: matches %s, %d pixels differ by more than %d\n", goldenName, differentPixels, tolerance);
+	return true;
+}
+
+
+//Function: main()
+//Description: This is the main method of the headless frame renderer.
+//Returns: int = 0 if the frame was written and matched the golden image, 1 if not.
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printf("Usage: RenderFrame <archive> <output tga> [-steps n] [-frames n] [-seed n] [-golden tga] [-tolerance n] [-maxpixels n]\n");
+		return 1;
+	}
+
+	int steps = 120;
+	int frames = 100;
+	unsigned int seed = 1;
+	const char* goldenName = 0;
+	int tolerance = 0;
+	int maxPixels = 0;
+	for (int i = 3; i + 1 < argc; i += 2)
+	{
+		if (!strcmp(argv[i], "-steps"))
+			steps = atoi(argv[i + 1]);
+		else if (!strcmp(argv[i], "-frames"))
+			frames = atoi(argv[i + 1]);
+		else if (!strcmp(argv[i], "-seed"))
+			seed = (unsigned int)atoi(argv[i + 1]);
+		else if (!strcmp(argv[i], "-golden"))
+			goldenName = argv[i + 1];
+		else if (!strcmp(argv[i], "-tolerance"))
+			tolerance = atoi(argv[i + 1]);
+		else if (!strcmp(argv[i], "-maxpixels"))
+			maxPixels = atoi(argv[i + 1]);
+	}
+
+	AssetArchive archive;
+	if (!archive.Open(argv[1]))
+	{
+		printf("RenderFrame: could not open %s\n", argv[1]);
+		return 1;
+	}
+
+	HeadlessAssets* assets = new HeadlessAssets();
+	if (!LoadHeadlessAssets(archive, assets))
+		return 1;
+
+	//Press enter on the first step to leave the start screen, then let the scene play out. The seed fixes the level.
+	GameState* gameState = new GameState();
+	SeedSimulationRandom(gameState, seed);
+	gameState->screenWidth = FRAME_WIDTH;
+	gameState->screenHeight = FRAME_HEIGHT;
+	for (int i = 0; i < steps; i++)
+	{
+		Input input = {};
+		input.enter = (i == 0);
+		SimulationStep(*gameState, input, HEADLESS_DT);
+	}
+
+	HeadlessFrame frame;
+	frame.renderer.Initialize(FRAME_WIDTH, FRAME_HEIGHT);
+	frame.perspective = MatrixPerspectiveFovLH(VECTOR_PI / 2.0f, (float)FRAME_WIDTH / (float)FRAME_HEIGHT, 0.1f, 100.0f);
+	frame.ortho = MatrixMultiply(MatrixOrthographicLH((float)FRAME_WIDTH, (float)FRAME_HEIGHT, 0.1f, 100.0f), MatrixTranslation(-1, -1, 0));
+
+	//Draw the same frame over and over to measure the renderer alone
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < frames; i++)
+	{
+		DrawFrame(&frame, *assets, *gameState);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (frames == 0)
+	{
+		DrawFrame(&frame, *assets, *gameState);
+	}
+	else
+	{
+		printf("RenderFrame: %d frames at %dx%d in %.1f ms, %.1f frames per second\n", frames, FRAME_WIDTH, FRAME_HEIGHT, seconds * 1000.0, frames / seconds);
+	}
+
+	if (!frame.renderer.WriteFrame(argv[2]))
+	{
+		printf("RenderFrame: could not write %s\n", argv[2]);
+		return 1;
+	}
+
+	if (goldenName && !CompareGolden(frame.renderer, goldenName, tolerance, maxPixels))
+		return 1;
+
+	return 0;
+}
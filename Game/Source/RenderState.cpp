@@ -0,0 +1,232 @@
+/*
+File Name:		RenderState.cpp
+Description:	This file holds the definition of the render state cache and the binds that go through it.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/RenderState.h"
+
+
+//Function: BeginFrame(ID3D11DeviceContext* deviceContext)
+//Description: This method starts a frame on the given context. The sprite batch rebinds most of the pipeline at the end of every
+//frame, so nothing is trusted from the last one and the counters start over.
+//Returns: void.
+void RenderStateCache::BeginFrame(ID3D11DeviceContext* deviceContext)
+{
+	this->deviceContext = deviceContext;
+	this->bindsIssued = 0;
+	this->bindsSkipped = 0;
+	this->Invalidate();
+}
+
+
+//Function: Invalidate()
+//Description: This method forgets everything the cache knows is bound, for when something else has bound state on the context.
+//Returns: void.
+void RenderStateCache::Invalidate()
+{
+	this->known = 0;
+	this->knownConstantBuffers = 0;
+	this->knownResources = 0;
+	this->knownVertexBuffers = 0;
+}
+
+
+//Function: SetVertexShader(ID3D11VertexShader* shader)
+//Description: This method binds a vertex shader unless it is already bound.
+//Returns: void.
+void RenderStateCache::SetVertexShader(ID3D11VertexShader* shader)
+{
+	if ((this->known & StateVertexShader) && this->vertexShader == shader)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->VSSetShader(shader, 0, 0);
+	this->vertexShader = shader;
+	this->known |= StateVertexShader;
+	this->bindsIssued++;
+}
+
+
+//Function: SetPixelShader(ID3D11PixelShader* shader)
+//Description: This method binds a pixel shader unless it is already bound.
+//Returns: void.
+void RenderStateCache::SetPixelShader(ID3D11PixelShader* shader)
+{
+	if ((this->known & StatePixelShader) && this->pixelShader == shader)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->PSSetShader(shader, 0, 0);
+	this->pixelShader = shader;
+	this->known |= StatePixelShader;
+	this->bindsIssued++;
+}
+
+
+//Function: SetInputLayout(ID3D11InputLayout* inputLayout)
+//Description: This method binds an input layout unless it is already bound.
+//Returns: void.
+void RenderStateCache::SetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	if ((this->known & StateInputLayout) && this->layout == inputLayout)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->IASetInputLayout(inputLayout);
+	this->layout = inputLayout;
+	this->known |= StateInputLayout;
+	this->bindsIssued++;
+}
+
+
+//Function: SetTopology(D3D11_PRIMITIVE_TOPOLOGY primitiveTopology)
+//Description: This method sets the primitive topology unless it is already set.
+//Returns: void.
+void RenderStateCache::SetTopology(D3D11_PRIMITIVE_TOPOLOGY primitiveTopology)
+{
+	if ((this->known & StateTopology) && this->topology == primitiveTopology)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->IASetPrimitiveTopology(primitiveTopology);
+	this->topology = primitiveTopology;
+	this->known |= StateTopology;
+	this->bindsIssued++;
+}
+
+
+//Function: SetRasterizerState(ID3D11RasterizerState* state)
+//Description: This method binds a rasterizer state unless it is already bound.
+//Returns: void.
+void RenderStateCache::SetRasterizerState(ID3D11RasterizerState* state)
+{
+	if ((this->known & StateRasterizer) && this->rasterState == state)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->RSSetState(state);
+	this->rasterState = state;
+	this->known |= StateRasterizer;
+	this->bindsIssued++;
+}
+
+
+//Function: SetBlendState(ID3D11BlendState* state)
+//Description: This method binds a blend state with no blend factor and every sample enabled, unless it is already bound.
+//Returns: void.
+void RenderStateCache::SetBlendState(ID3D11BlendState* state)
+{
+	if ((this->known & StateBlend) && this->blendState == state)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->OMSetBlendState(state, 0, 0xffffffff);
+	this->blendState = state;
+	this->known |= StateBlend;
+	this->bindsIssued++;
+}
+
+
+//Function: SetIndexBuffer(ID3D11Buffer* buffer)
+//Description: This method binds a 32 bit index buffer unless it is already bound. Buffers without indices pass 0 and leave
+//the bound one alone, non-indexed draws do not read it.
+//Returns: void.
+void RenderStateCache::SetIndexBuffer(ID3D11Buffer* buffer)
+{
+	if (!buffer)
+		return;
+
+	if ((this->known & StateIndexBuffer) && this->indexBuffer == buffer)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->IASetIndexBuffer(buffer, DXGI_FORMAT_R32_UINT, 0);
+	this->indexBuffer = buffer;
+	this->known |= StateIndexBuffer;
+	this->bindsIssued++;
+}
+
+
+//Function: SetVSConstantBuffer(int slot, ID3D11Buffer* buffer)
+//Description: This method binds a vertex shader constant buffer to a slot unless it is already bound there.
+//Returns: void.
+void RenderStateCache::SetVSConstantBuffer(int slot, ID3D11Buffer* buffer)
+{
+	unsigned int bit = 1u << slot;
+	if ((this->knownConstantBuffers & bit) && this->constantBuffers[slot] == buffer)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->VSSetConstantBuffers(slot, 1, &buffer);
+	this->constantBuffers[slot] = buffer;
+	this->knownConstantBuffers |= bit;
+	this->bindsIssued++;
+}
+
+
+//Function: SetPSResource(int slot, ID3D11ShaderResourceView* resource)
+//Description: This method binds a pixel shader resource to a slot unless it is already bound there.
+//Returns: void.
+void RenderStateCache::SetPSResource(int slot, ID3D11ShaderResourceView* resource)
+{
+	unsigned int bit = 1u << slot;
+	if ((this->knownResources & bit) && this->resources[slot] == resource)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	this->deviceContext->PSSetShaderResources(slot, 1, &resource);
+	this->resources[slot] = resource;
+	this->knownResources |= bit;
+	this->bindsIssued++;
+}
+
+
+//Function: SetVertexBuffers(int count, ID3D11Buffer* const* buffers, const UINT* strides)
+//Description: This method binds vertex buffers to the first slots, at offset 0. They are bound with one call when any of them
+//differs from what is bound.
+//Returns: void.
+void RenderStateCache::SetVertexBuffers(int count, ID3D11Buffer* const* buffers, const UINT* strides)
+{
+	unsigned int bits = (1u << count) - 1;
+	bool bound = (this->knownVertexBuffers & bits) == bits;
+	for (int i = 0; i < count && bound; i++)
+	{
+		bound = this->vertexBuffers[i] == buffers[i] && this->vertexStrides[i] == strides[i];
+	}
+
+	if (bound)
+	{
+		this->bindsSkipped++;
+		return;
+	}
+
+	UINT offsets[RENDER_STATE_SLOTS] = {};
+	this->deviceContext->IASetVertexBuffers(0, count, buffers, strides, offsets);
+	for (int i = 0; i < count; i++)
+	{
+		this->vertexBuffers[i] = buffers[i];
+		this->vertexStrides[i] = strides[i];
+	}
+	this->knownVertexBuffers |= bits;
+	this->bindsIssued++;
+}
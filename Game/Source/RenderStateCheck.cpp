@@ -0,0 +1,469 @@
+/*
+File Name:		RenderStateCheck.cpp
+Description:	This file is the render state cache check. It runs the cache on a WARP device, so no GPU or window is needed, with
+				a long random run of binds drawn from a few shaders, states and buffers, nulls included. Now and then state is
+				bound straight on the context behind the cache's back and the cache is invalidated, like the sprite batch does,
+				and now and then a new frame is started. After every step the state really bound on the context is read back
+				and compared with the last thing bound, and the issued and skipped counters are compared with what a bind of
+				already bound state should have done.
+				Usage: RenderStateCheck [steps]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Include/RenderState.h"
+
+//How many of each object the binds pick from, the last pick of every pool is null
+#define CHECK_POOL_SIZE 3
+
+//Two of each shader so binds can differ, the pixel shaders read texture t0 so resources matter to them
+static const char shaderSource[] =
+	"cbuffer Camera : register(b0) { matrix view; };\n"
+	"Texture2D shaderTexture : register(t0);\n"
+	"SamplerState sampleType : register(s0);\n"
+	"struct VertexInput { float3 position : POSITION; float2 tex : TEXCOORD0; };\n"
+	"struct PixelInput { float4 position : SV_POSITION; float2 tex : TEXCOORD0; };\n"
+	"PixelInput FirstVertexShader(VertexInput input) { PixelInput output; output.position = mul(float4(input.position, 1.0f), view); output.tex = input.tex; return output; }\n"
+	"PixelInput SecondVertexShader(VertexInput input) { PixelInput output; output.position = float4(input.position, 1.0f); output.tex = input.tex; return output; }\n"
+	"float4 FirstPixelShader(PixelInput input) : SV_TARGET { return shaderTexture.Sample(sampleType, input.tex); }\n"
+	"float4 SecondPixelShader(PixelInput input) : SV_TARGET { return float4(input.tex, 0.0f, 1.0f); }\n";
+
+//Everything the binds pick from
+struct CheckObjects
+{
+	ID3D11VertexShader* vertexShaders[CHECK_POOL_SIZE];
+	ID3D11PixelShader* pixelShaders[CHECK_POOL_SIZE];
+	ID3D11InputLayout* layouts[CHECK_POOL_SIZE];
+	ID3D11RasterizerState* rasterStates[CHECK_POOL_SIZE];
+	ID3D11BlendState* blendStates[CHECK_POOL_SIZE];
+	ID3D11Buffer* indexBuffers[CHECK_POOL_SIZE];
+	ID3D11Buffer* constantBuffers[CHECK_POOL_SIZE];
+	ID3D11ShaderResourceView* resources[CHECK_POOL_SIZE];
+	ID3D11Buffer* vertexBuffers[CHECK_POOL_SIZE];
+};
+
+//What the check bound last, which is what the context must have bound, and which of it the cache may trust
+struct CheckState
+{
+	unsigned int known;
+	unsigned int knownConstantBuffers;
+	unsigned int knownResources;
+	unsigned int knownVertexBuffers;
+
+	ID3D11VertexShader* vertexShader;
+	ID3D11PixelShader* pixelShader;
+	ID3D11InputLayout* layout;
+	D3D11_PRIMITIVE_TOPOLOGY topology;
+	ID3D11RasterizerState* rasterState;
+	ID3D11BlendState* blendState;
+	ID3D11Buffer* indexBuffer;
+	ID3D11Buffer* constantBuffers[RENDER_STATE_SLOTS];
+	ID3D11ShaderResourceView* resources[RENDER_STATE_SLOTS];
+	ID3D11Buffer* vertexBuffers[RENDER_STATE_SLOTS];
+	UINT vertexStrides[RENDER_STATE_SLOTS];
+
+	int bindsIssued;
+	int bindsSkipped;
+};
+
+static const D3D11_PRIMITIVE_TOPOLOGY topologies[] = { D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP };
+static const UINT strides[] = { sizeof(VertexType), 68 };
+
+
+//Function: Release(IUnknown* object)
+//Description: This method releases a reference the context handed out when its state was read back.
+//Returns: void.
+static void Release(IUnknown* object)
+{
+	if (object)
+	{
+		object->Release();
+	}
+}
+
+
+//Function: CompileShader(const char* entryPoint, const char* target)
+//Description: This method compiles one of the check's shaders.
+//Returns: ID3DBlob* = the bytecode, or 0 if it did not compile.
+static ID3DBlob* CompileShader(const char* entryPoint, const char* target)
+{
+	ID3DBlob* code = 0;
+	ID3DBlob* errors = 0;
+	if (FAILED(D3DCompile(shaderSource, sizeof(shaderSource) - 1, "RenderStateCheck", 0, 0, entryPoint, target, D3D10_SHADER_ENABLE_STRICTNESS, 0, &code, &errors)))
+	{
+		printf("RenderStateCheck: %s did not compile: %s\n", entryPoint, errors ? (const char*)errors->GetBufferPointer() : "");
+		Release(errors);
+		return 0;
+	}
+
+	Release(errors);
+	return code;
+}
+
+
+//Function: CreateBuffer(ID3D11Device* device, UINT bindFlags, UINT size)
+//Description: This method creates an empty default usage buffer.
+//Returns: ID3D11Buffer* = the buffer, or 0 if it could not be created.
+static ID3D11Buffer* CreateBuffer(ID3D11Device* device, UINT bindFlags, UINT size)
+{
+	D3D11_BUFFER_DESC bufferDesc = {};
+	bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+	bufferDesc.ByteWidth = size;
+	bufferDesc.BindFlags = bindFlags;
+
+	ID3D11Buffer* buffer = 0;
+	device->CreateBuffer(&bufferDesc, 0, &buffer);
+	return buffer;
+}
+
+
+//Function: CreateObjects(ID3D11Device* device, CheckObjects* objects)
+//Description: This method creates two of everything the binds pick from. The runtime hands back the same object for identical
+//state descriptions, so the two rasterizer and blend states are made to differ.
+//Returns: bool = whether everything was created.
+static bool CreateObjects(ID3D11Device* device, CheckObjects* objects)
+{
+	const char* vertexEntryPoints[] = { "FirstVertexShader", "SecondVertexShader" };
+	const char* pixelEntryPoints[] = { "FirstPixelShader", "SecondPixelShader" };
+
+	D3D11_INPUT_ELEMENT_DESC polygonLayout[2] = {};
+	polygonLayout[0].SemanticName = "POSITION";
+	polygonLayout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+	polygonLayout[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+	polygonLayout[1].SemanticName = "TEXCOORD";
+	polygonLayout[1].Format = DXGI_FORMAT_R32G32_FLOAT;
+	polygonLayout[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+	polygonLayout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+
+	for (int i = 0; i < CHECK_POOL_SIZE - 1; i++)
+	{
+		ID3DBlob* vertexCode = CompileShader(vertexEntryPoints[i], "vs_5_0");
+		ID3DBlob* pixelCode = CompileShader(pixelEntryPoints[i], "ps_5_0");
+		if (!vertexCode || !pixelCode)
+			return false;
+
+		device->CreateVertexShader(vertexCode->GetBufferPointer(), vertexCode->GetBufferSize(), 0, &objects->vertexShaders[i]);
+		device->CreatePixelShader(pixelCode->GetBufferPointer(), pixelCode->GetBufferSize(), 0, &objects->pixelShaders[i]);
+		device->CreateInputLayout(polygonLayout, 2, vertexCode->GetBufferPointer(), vertexCode->GetBufferSize(), &objects->layouts[i]);
+		Release(vertexCode);
+		Release(pixelCode);
+
+		D3D11_RASTERIZER_DESC rasterDesc = {};
+		rasterDesc.FillMode = D3D11_FILL_SOLID;
+		rasterDesc.CullMode = (i == 0) ? D3D11_CULL_BACK : D3D11_CULL_NONE;
+		rasterDesc.DepthClipEnable = TRUE;
+		device->CreateRasterizerState(&rasterDesc, &objects->rasterStates[i]);
+
+		D3D11_BLEND_DESC blendDesc = {};
+		blendDesc.RenderTarget[0].BlendEnable = (i == 0) ? TRUE : FALSE;
+		blendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+		blendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+		blendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+		blendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+		blendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
+		blendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+		blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+		device->CreateBlendState(&blendDesc, &objects->blendStates[i]);
+
+		objects->indexBuffers[i] = CreateBuffer(device, D3D11_BIND_INDEX_BUFFER, 256);
+		objects->constantBuffers[i] = CreateBuffer(device, D3D11_BIND_CONSTANT_BUFFER, sizeof(CameraBufferType));
+		objects->vertexBuffers[i] = CreateBuffer(device, D3D11_BIND_VERTEX_BUFFER, 1024);
+
+		D3D11_TEXTURE2D_DESC textureDesc = {};
+		textureDesc.Width = 4;
+		textureDesc.Height = 4;
+		textureDesc.MipLevels = 1;
+		textureDesc.ArraySize = 1;
+		textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+		textureDesc.SampleDesc.Count = 1;
+		textureDesc.Usage = D3D11_USAGE_DEFAULT;
+		textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+		ID3D11Texture2D* texture = 0;
+		device->CreateTexture2D(&textureDesc, 0, &texture);
+		if (texture)
+		{
+			device->CreateShaderResourceView(texture, 0, &objects->resources[i]);
+			Release(texture);
+		}
+
+		if (!objects->vertexShaders[i] || !objects->pixelShaders[i] || !objects->layouts[i] || !objects->rasterStates[i] || !objects->blendStates[i] ||
+			!objects->indexBuffers[i] || !objects->constantBuffers[i] || !objects->vertexBuffers[i] || !objects->resources[i])
+			return false;
+	}
+
+	return objects->rasterStates[0] != objects->rasterStates[1] && objects->blendStates[0] != objects->blendStates[1];
+}
+
+
+//Function: Expect(CheckState* expected, unsigned int* known, unsigned int bit, bool same)
+//Description: This method works out what a bind through the cache should count. It is skipped only when the cache knows the
+//state and it is the same, either way the cache knows it afterwards.
+//Returns: void.
+static void Expect(CheckState* expected, unsigned int* known, unsigned int bit, bool same)
+{
+	if ((*known & bit) && same)
+	{
+		expected->bindsSkipped++;
+	}
+	else
+	{
+		expected->bindsIssued++;
+	}
+	*known |= bit;
+}
+
+
+//Function: ForgetEverything(CheckState* expected)
+//Description: This method forgets what the cache may trust, like Invalidate does.
+//Returns: void.
+static void ForgetEverything(CheckState* expected)
+{
+	expected->known = 0;
+	expected->knownConstantBuffers = 0;
+	expected->knownResources = 0;
+	expected->knownVertexBuffers = 0;
+}
+
+
+//Function: VerifyBound(ID3D11DeviceContext* deviceContext, const CheckState& expected, const RenderStateCache& cache)
+//Description: This method reads back the state bound on the context and compares it and the counters of the cache with what
+//they should be.
+//Returns: const char* = what differs, or 0 if nothing does.
+static const char* VerifyBound(ID3D11DeviceContext* deviceContext, const CheckState& expected, const RenderStateCache& cache)
+{
+	const char* mismatch = 0;
+
+	ID3D11VertexShader* vertexShader = 0;
+	deviceContext->VSGetShader(&vertexShader, 0, 0);
+	if (vertexShader != expected.vertexShader)
+		mismatch = "vertex shader";
+	Release(vertexShader);
+
+	ID3D11PixelShader* pixelShader = 0;
+	deviceContext->PSGetShader(&pixelShader, 0, 0);
+	if (pixelShader != expected.pixelShader)
+		mismatch = "pixel shader";
+	Release(pixelShader);
+
+	ID3D11InputLayout* layout = 0;
+	deviceContext->IAGetInputLayout(&layout);
+	if (layout != expected.layout)
+		mismatch = "input layout";
+	Release(layout);
+
+	D3D11_PRIMITIVE_TOPOLOGY topology;
+	deviceContext->IAGetPrimitiveTopology(&topology);
+	if (topology != expected.topology)
+		mismatch = "topology";
+
+	ID3D11RasterizerState* rasterState = 0;
+	deviceContext->RSGetState(&rasterState);
+	if (rasterState != expected.rasterState)
+		mismatch = "rasterizer state";
+	Release(rasterState);
+
+	ID3D11BlendState* blendState = 0;
+	FLOAT blendFactor[4];
+	UINT sampleMask;
+	deviceContext->OMGetBlendState(&blendState, blendFactor, &sampleMask);
+	if (blendState != expected.blendState)
+		mismatch = "blend state";
+	Release(blendState);
+
+	ID3D11Buffer* indexBuffer = 0;
+	DXGI_FORMAT indexFormat;
+	UINT indexOffset;
+	deviceContext->IAGetIndexBuffer(&indexBuffer, &indexFormat, &indexOffset);
+	if (indexBuffer != expected.indexBuffer)
+		mismatch = "index buffer";
+	Release(indexBuffer);
+
+	ID3D11Buffer* constantBuffers[RENDER_STATE_SLOTS] = {};
+	ID3D11ShaderResourceView* resources[RENDER_STATE_SLOTS] = {};
+	ID3D11Buffer* vertexBuffers[RENDER_STATE_SLOTS] = {};
+	UINT vertexStrides[RENDER_STATE_SLOTS] = {};
+	UINT vertexOffsets[RENDER_STATE_SLOTS] = {};
+	deviceContext->VSGetConstantBuffers(0, RENDER_STATE_SLOTS, constantBuffers);
+	deviceContext->PSGetShaderResources(0, RENDER_STATE_SLOTS, resources);
+	deviceContext->IAGetVertexBuffers(0, RENDER_STATE_SLOTS, vertexBuffers, vertexStrides, vertexOffsets);
+	for (int slot = 0; slot < RENDER_STATE_SLOTS; slot++)
+	{
+		if (constantBuffers[slot] != expected.constantBuffers[slot])
+			mismatch = "constant buffer";
+		if (resources[slot] != expected.resources[slot])
+			mismatch = "shader resource";
+
+		//The stride of an empty slot is not kept
+		if (vertexBuffers[slot] != expected.vertexBuffers[slot] || (vertexBuffers[slot] && vertexStrides[slot] != expected.vertexStrides[slot]))
+			mismatch = "vertex buffer";
+
+		Release(constantBuffers[slot]);
+		Release(resources[slot]);
+		Release(vertexBuffers[slot]);
+	}
+
+	if (cache.bindsIssued != expected.bindsIssued)
+		mismatch = "binds issued";
+	if (cache.bindsSkipped != expected.bindsSkipped)
+		mismatch = "binds skipped";
+
+	return mismatch;
+}
+
+
+//Function: main()
+//Description: This is the main method of the render state cache check.
+//Returns: int = 0 if the context always had the right state bound and the counters were right, 1 otherwise.
+int main(int argc, char** argv)
+{
+	int steps = (argc > 1) ? atoi(argv[1]) : 20000;
+	if (steps <= 0)
+	{
+		printf("Usage: RenderStateCheck [steps]\n");
+		return 1;
+	}
+
+	ID3D11Device* device = 0;
+	ID3D11DeviceContext* deviceContext = 0;
+	D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
+	if (FAILED(D3D11CreateDevice(0, D3D_DRIVER_TYPE_WARP, 0, 0, &featureLevel, 1, D3D11_SDK_VERSION, &device, 0, &deviceContext)))
+	{
+		printf("RenderStateCheck: could not create a WARP device\n");
+		return 1;
+	}
+
+	//The last object of every pool stays null
+	CheckObjects objects = {};
+	if (!CreateObjects(device, &objects))
+	{
+		printf("RenderStateCheck: could not create the shaders, states and buffers\n");
+		return 1;
+	}
+
+	//A cleared context has nothing bound, which is where the expected state starts too
+	deviceContext->ClearState();
+	CheckState expected = {};
+	expected.topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+
+	RenderStateCache cache = {};
+	cache.BeginFrame(deviceContext);
+
+	srand(1);
+	int frames = 1;
+	int invalidations = 0;
+	for (int step = 0; step < steps; step++)
+	{
+		int pick = rand() % CHECK_POOL_SIZE;
+		int slot = rand() % RENDER_STATE_SLOTS;
+		int operation = rand() % 12;
+		switch (operation)
+		{
+		case 0:
+			Expect(&expected, &expected.known, StateVertexShader, expected.vertexShader == objects.vertexShaders[pick]);
+			expected.vertexShader = objects.vertexShaders[pick];
+			cache.SetVertexShader(objects.vertexShaders[pick]);
+			break;
+		case 1:
+			Expect(&expected, &expected.known, StatePixelShader, expected.pixelShader == objects.pixelShaders[pick]);
+			expected.pixelShader = objects.pixelShaders[pick];
+			cache.SetPixelShader(objects.pixelShaders[pick]);
+			break;
+		case 2:
+			Expect(&expected, &expected.known, StateInputLayout, expected.layout == objects.layouts[pick]);
+			expected.layout = objects.layouts[pick];
+			cache.SetInputLayout(objects.layouts[pick]);
+			break;
+		case 3:
+		{
+			D3D11_PRIMITIVE_TOPOLOGY topology = topologies[pick % 2];
+			Expect(&expected, &expected.known, StateTopology, expected.topology == topology);
+			expected.topology = topology;
+			cache.SetTopology(topology);
+			break;
+		}
+		case 4:
+			Expect(&expected, &expected.known, StateRasterizer, expected.rasterState == objects.rasterStates[pick]);
+			expected.rasterState = objects.rasterStates[pick];
+			cache.SetRasterizerState(objects.rasterStates[pick]);
+			break;
+		case 5:
+			Expect(&expected, &expected.known, StateBlend, expected.blendState == objects.blendStates[pick]);
+			expected.blendState = objects.blendStates[pick];
+			cache.SetBlendState(objects.blendStates[pick]);
+			break;
+		case 6:
+			//A null index buffer leaves the bound one alone and counts as nothing
+			if (objects.indexBuffers[pick])
+			{
+				Expect(&expected, &expected.known, StateIndexBuffer, expected.indexBuffer == objects.indexBuffers[pick]);
+				expected.indexBuffer = objects.indexBuffers[pick];
+			}
+			cache.SetIndexBuffer(objects.indexBuffers[pick]);
+			break;
+		case 7:
+			Expect(&expected, &expected.knownConstantBuffers, 1u << slot, expected.constantBuffers[slot] == objects.constantBuffers[pick]);
+			expected.constantBuffers[slot] = objects.constantBuffers[pick];
+			cache.SetVSConstantBuffer(slot, objects.constantBuffers[pick]);
+			break;
+		case 8:
+			Expect(&expected, &expected.knownResources, 1u << slot, expected.resources[slot] == objects.resources[pick]);
+			expected.resources[slot] = objects.resources[pick];
+			cache.SetPSResource(slot, objects.resources[pick]);
+			break;
+		case 9:
+		{
+			//One or two buffers at once, like the sprite and planet renderers bind
+			int count = 1 + rand() % 2;
+			ID3D11Buffer* buffers[2] = { objects.vertexBuffers[pick], objects.vertexBuffers[rand() % CHECK_POOL_SIZE] };
+			UINT bufferStrides[2] = { strides[rand() % 2], strides[rand() % 2] };
+
+			unsigned int bits = (1u << count) - 1;
+			bool same = (expected.knownVertexBuffers & bits) == bits;
+			for (int i = 0; i < count; i++)
+			{
+				same = same && expected.vertexBuffers[i] == buffers[i] && expected.vertexStrides[i] == bufferStrides[i];
+				expected.vertexBuffers[i] = buffers[i];
+				expected.vertexStrides[i] = bufferStrides[i];
+			}
+			Expect(&expected, &expected.knownVertexBuffers, bits, same);
+			cache.SetVertexBuffers(count, buffers, bufferStrides);
+			break;
+		}
+		case 10:
+		{
+			//Bind behind the cache's back, like the sprite batch, then tell it to forget
+			expected.vertexShader = objects.vertexShaders[pick];
+			expected.blendState = objects.blendStates[rand() % CHECK_POOL_SIZE];
+			expected.resources[0] = objects.resources[rand() % CHECK_POOL_SIZE];
+			deviceContext->VSSetShader(expected.vertexShader, 0, 0);
+			deviceContext->OMSetBlendState(expected.blendState, 0, 0xffffffff);
+			deviceContext->PSSetShaderResources(0, 1, &expected.resources[0]);
+
+			ForgetEverything(&expected);
+			cache.Invalidate();
+			invalidations++;
+			break;
+		}
+		case 11:
+			ForgetEverything(&expected);
+			expected.bindsIssued = 0;
+			expected.bindsSkipped = 0;
+			cache.BeginFrame(deviceContext);
+			frames++;
+			break;
+		}
+
+		const char* mismatch = VerifyBound(deviceContext, expected, cache);
+		if (mismatch)
+		{
+			printf("RenderStateCheck: step %d, operation %d: the %s is wrong\n", step, operation, mismatch);
+			return 1;
+		}
+	}
+
+	printf("RenderStateCheck: %d steps over %d frames and %d invalidations bound the right state\n", steps, frames, invalidations);
+	return 0;
+}
@@ -0,0 +1,226 @@
+/*
+File Name:		Replay.cpp
+Description:	This file holds the methods to record the input of every simulation step, read a recording back, and hash the
+				game state so a replay can be checked step by step against the run it was recorded from.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Replay.h"
+#include "../Include/MappedFile.h"
+#include <string.h>
+
+
+//Function: Begin(const char* fileName, uint32_t seed, int screenWidth, int screenHeight, float dt)
+//Description: This method creates the recording and writes its header. Steps are appended until End is called.
+//Returns: bool = whether the file was created.
+bool InputRecorder::Begin(const char* fileName, uint32_t seed, int screenWidth, int screenHeight, float dt)
+{
+	this->End();
+
+	this->file = fopen(fileName, "wb");
+	if (!this->file)
+		return false;
+
+	ReplayHeader header = {};
+	header.magic = REPLAY_MAGIC;
+	header.version = REPLAY_VERSION;
+	header.seed = seed;
+	header.screenWidth = screenWidth;
+	header.screenHeight = screenHeight;
+	header.dt = dt;
+	fwrite(&header, sizeof(header), 1, this->file);
+
+	this->stepCount = 0;
+	return true;
+}
+
+
+//Function: Record(const Input& input, uint32_t stateHash)
+//Description: This method appends one step, the input it was given and the hash of the state it left. Does nothing when
+//no recording was begun.
+//Returns: void.
+void InputRecorder::Record(const Input& input, uint32_t stateHash)
+{
+	if (!this->file)
+		return;
+
+	ReplayStep step = PackInput(input);
+	step.stateHash = stateHash;
+	fwrite(&step, sizeof(step), 1, this->file);
+	this->stepCount++;
+}
+
+
+//Function: End()
+//Description: This method closes the recording, if there is one.
+//Returns: void.
+void InputRecorder::End()
+{
+	if (this->file)
+	{
+		fclose(this->file);
+		this->file = 0;
+	}
+}
+
+
+//Function: PackInput(const Input& input)
+//Description: This method packs the buttons into bits and the mouse position into 16 bits each. The hash is left at 0.
+//Returns: ReplayStep = the packed input.
+ReplayStep PackInput(const Input& input)
+{
+	ReplayStep step = {};
+	step.buttons |= input.mouse.downL ? ReplayMouseDownL : 0;
+	step.buttons |= input.mouse.downR ? ReplayMouseDownR : 0;
+	step.buttons |= input.mouse.clickedL ? ReplayMouseClickedL : 0;
+	step.buttons |= input.mouse.clickedR ? ReplayMouseClickedR : 0;
+	step.buttons |= input.key1 ? ReplayKey1 : 0;
+	step.buttons |= input.key2 ? ReplayKey2 : 0;
+	step.buttons |= input.key3 ? ReplayKey3 : 0;
+	step.buttons |= input.key4 ? ReplayKey4 : 0;
+	step.buttons |= input.keyE ? ReplayKeyE : 0;
+	step.buttons |= input.enter ? ReplayEnter : 0;
+	step.mouseX = (int16_t)input.mouse.x;
+	step.mouseY = (int16_t)input.mouse.y;
+	return step;
+}
+
+
+//Function: UnpackInput(const ReplayStep& step)
+//Description: This method turns a recorded step back into the input the simulation was given.
+//Returns: Input = the input of the step.
+Input UnpackInput(const ReplayStep& step)
+{
+	Input input = {};
+	input.mouse.downL = (step.buttons & ReplayMouseDownL) != 0;
+	input.mouse.downR = (step.buttons & ReplayMouseDownR) != 0;
+	input.mouse.clickedL = (step.buttons & ReplayMouseClickedL) != 0;
+	input.mouse.clickedR = (step.buttons & ReplayMouseClickedR) != 0;
+	input.key1 = (step.buttons & ReplayKey1) != 0;
+	input.key2 = (step.buttons & ReplayKey2) != 0;
+	input.key3 = (step.buttons & ReplayKey3) != 0;
+	input.key4 = (step.buttons & ReplayKey4) != 0;
+	input.keyE = (step.buttons & ReplayKeyE) != 0;
+	input.enter = (step.buttons & ReplayEnter) != 0;
+	input.mouse.x = step.mouseX;
+	input.mouse.y = step.mouseY;
+	return input;
+}
+
+
+//Function: LoadReplay(const char* fileName, Replay* replay)
+//Description: This method reads a whole recording. A recording cut short mid step, by a crash for instance, keeps its whole steps.
+//Returns: bool = whether the file is a recording of this version.
+bool LoadReplay(const char* fileName, Replay* replay)
+{
+	MappedFile file;
+	if (!file.Open(fileName) || file.size < sizeof(ReplayHeader))
+		return false;
+
+	memcpy(&replay->header, file.data, sizeof(ReplayHeader));
+	if (replay->header.magic != REPLAY_MAGIC || replay->header.version != REPLAY_VERSION)
+		return false;
+
+	size_t stepCount = (file.size - sizeof(ReplayHeader)) / sizeof(ReplayStep);
+	replay->steps.resize(stepCount);
+	if (stepCount)
+	{
+		memcpy(replay->steps.data(), file.data + sizeof(ReplayHeader), stepCount * sizeof(ReplayStep));
+	}
+
+	return true;
+}
+
+
+//Function: HashBytes(uint32_t hash, const void* data, size_t size)
+//Description: This method folds bytes into a 32 bit FNV-1a hash.
+//Returns: uint32_t = the new hash.
+static uint32_t HashBytes(uint32_t hash, const void* data, size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+
+//Function: HashValue(uint32_t hash, const T& value)
+//Description: This method folds one field into the hash. Floats are hashed by their bits, so any drift at all shows up.
+//Returns: uint32_t = the new hash.
+template <typename T>
+static uint32_t HashValue(uint32_t hash, const T& value)
+{
+	return HashBytes(hash, &value, sizeof(value));
+}
+
+
+//Function: HashShip(uint32_t hash, const Ship* ship)
+//Description: This method folds the parts of a ship the simulation changes into the hash.
+//Returns: uint32_t = the new hash.
+static uint32_t HashShip(uint32_t hash, const Ship* ship)
+{
+	hash = HashValue(hash, ship->position.x);
+	hash = HashValue(hash, ship->position.y);
+	hash = HashValue(hash, ship->destination.x);
+	hash = HashValue(hash, ship->destination.y);
+	hash = HashValue(hash, ship->angle);
+	hash = HashValue(hash, ship->energy);
+	hash = HashValue(hash, ship->science);
+	return hash;
+}
+
+
+//Function: HashGameState(const GameState& gameState)
+//Description: This method hashes the simulated part of the game state: the scene, the clock, the ships, the planets and the
+//rockets. The commands are left out, they follow from the rest.
+//Returns: uint32_t = the hash of the state.
+uint32_t HashGameState(const GameState& gameState)
+{
+	uint32_t hash = 2166136261u;
+
+	hash = HashValue(hash, gameState.levelState);
+	hash = HashValue(hash, gameState.clock.now);
+	hash = HashValue(hash, gameState.backgroundIndex);
+	hash = HashValue(hash, gameState.scienceGathered);
+	hash = HashValue(hash, gameState.currentSector);
+	hash = HashValue(hash, gameState.visitingPlanet);
+
+	if (gameState.player)
+	{
+		hash = HashShip(hash, gameState.player);
+	}
+
+	hash = HashValue(hash, gameState.enemies.size());
+	for (size_t i = 0; i < gameState.enemies.size(); i++)
+	{
+		hash = HashShip(hash, gameState.enemies[i]);
+	}
+
+	hash = HashValue(hash, gameState.planets.size());
+	for (size_t i = 0; i < gameState.planets.size(); i++)
+	{
+		const Planet* planet = gameState.planets[i];
+		hash = HashValue(hash, planet->position.x);
+		hash = HashValue(hash, planet->position.y);
+		hash = HashValue(hash, planet->angle);
+		hash = HashValue(hash, planet->energy);
+		hash = HashValue(hash, planet->science);
+		hash = HashValue(hash, planet->texture);
+	}
+
+	const RocketPool& rockets = gameState.rockets;
+	hash = HashValue(hash, rockets.count);
+	for (int i = 0; i < rockets.count; i++)
+	{
+		hash = HashValue(hash, rockets.position[i].x);
+		hash = HashValue(hash, rockets.position[i].y);
+		hash = HashValue(hash, rockets.exploded[i]);
+	}
+
+	return hash;
+}
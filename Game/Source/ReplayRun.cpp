@@ -0,0 +1,177 @@
+/*
+File Name:		ReplayRun.cpp
+Description:	This file is the replay driver. It feeds a recording made with Main.exe -record <file> back into the simulation
+				with no window, renderer or sound, as fast as the CPU allows. After every step the state hash is compared with
+				the recorded one and the first step that differs is reported. Running the recording more than once gives a
+				repeatable workload for profiling, and the steps per second are reported at the end.
+				Usage: ReplayRun <recording> [runs]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "../Include/Replay.h"
+#include "../Include/Archive.h"
+#include "../Include/Mixer.h"
+#include "../Include/Simulation.h"
+
+
+//Function: LoadSounds(const AssetArchive& archive, MixerSound* sounds)
+//Description: This method finds every sound in the archive the way the game does, background tracks 4 to 6 reuse the first three.
+//Returns: bool = whether every sound was found.
+static bool LoadSounds(const AssetArchive& archive, MixerSound* sounds)
+{
+	const char* names[] =
+	{
+		"Audio/spaceship_move.wav",
+		"Audio/missile_fire.wav",
+		"Audio/missile_hit.wav",
+		"Audio/intro.wav",
+		"Audio/background01.wav",
+		"Audio/background02.wav",
+		"Audio/background03.wav",
+	};
+
+	for (int i = 0; i < SoundBackground + 3; i++)
+	{
+		sounds[i] = MixerSoundFromAsset(&archive, archive.Find(names[i]));
+		if (!sounds[i].data)
+		{
+			printf("ReplayRun: the archive has no %s the mixer can play\n", names[i]);
+			return false;
+		}
+	}
+
+	sounds[SoundBackground + 3] = sounds[SoundBackground + 0];
+	sounds[SoundBackground + 4] = sounds[SoundBackground + 1];
+	sounds[SoundBackground + 5] = sounds[SoundBackground + 2];
+	return true;
+}
+
+
+//Function: RunReplay(const Replay& replay, const MixerSound* sounds, WaveWriterBackend* output)
+//Description: This method runs the recording once from a fresh game state, seeded the way the recorded run was. Given sounds,
+//every step also plays its audio commands and mixes the frames of its dt into the output.
+//Returns: size_t = the first step whose state hash differs from the recording, or the step count if none does.
+static size_t RunReplay(const Replay& replay, const MixerSound* sounds, WaveWriterBackend* output)
+{
+	AudioMixer* mixer = 0;
+	if (sounds)
+	{
+		mixer = new AudioMixer();
+		mixer->Initialize();
+		if (!output->Start(mixer))
+		{
+			printf("ReplayRun: could not write %s, mixing without it\n", output->fileName);
+		}
+	}
+	double audioFrames = 0.0;
+
+	GameState* gameState = new GameState();
+	SeedSimulationRandom(gameState, replay.header.seed);
+	gameState->screenWidth = replay.header.screenWidth;
+	gameState->screenHeight = replay.header.screenHeight;
+
+	size_t step = 0;
+	for (; step < replay.steps.size(); step++)
+	{
+		SimulationStep(*gameState, UnpackInput(replay.steps[step]), replay.header.dt);
+
+		if (mixer)
+		{
+			//Steps are rarely a whole number of frames long, the remainder is carried to the next step
+			PlayAudioCommands(mixer, sounds, gameState->audioCommands, gameState->screenWidth, gameState->screenHeight);
+			audioFrames += replay.header.dt * MIXER_SAMPLE_RATE;
+			int frames = (int)audioFrames;
+			output->Render(frames);
+			audioFrames -= frames;
+		}
+
+		if (HashGameState(*gameState) != replay.steps[step].stateHash)
+			break;
+	}
+
+	if (mixer)
+	{
+		output->Stop();
+		delete mixer;
+	}
+
+	ReleaseGame(gameState);
+	delete gameState;
+	return step;
+}
+
+
+//Function: main()
+//Description: This is the main method of the replay driver.
+//Returns: int = 0 if every run matched the recording, 1 if not.
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("Usage: ReplayRun <recording> [runs] [-audio <archive> <wave file>]\n");
+		return 1;
+	}
+
+	Replay replay;
+	if (!LoadReplay(argv[1], &replay))
+	{
+		printf("ReplayRun: %s is not a recording\n", argv[1]);
+		return 1;
+	}
+
+	int runs = 1;
+	const char* archiveName = 0;
+	const char* waveName = 0;
+	for (int i = 2; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-audio") && i + 2 < argc)
+		{
+			archiveName = argv[++i];
+			waveName = argv[++i];
+		}
+		else
+		{
+			runs = atoi(argv[i]);
+		}
+	}
+
+	AssetArchive archive;
+	MixerSound sounds[SoundCount] = {};
+	if (archiveName)
+	{
+		if (!archive.Open(archiveName))
+		{
+			printf("ReplayRun: could not open %s\n", archiveName);
+			return 1;
+		}
+
+		if (!LoadSounds(archive, sounds))
+			return 1;
+	}
+
+	printf("ReplayRun: %zu steps of %.4f s at %dx%d, seed %u\n", replay.steps.size(), replay.header.dt, replay.header.screenWidth, replay.header.screenHeight, replay.header.seed);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int run = 0; run < runs; run++)
+	{
+		//Only the first run is written out, the others still pay for the mixing
+		WaveWriterBackend output((run == 0) ? waveName : 0);
+		size_t matched = RunReplay(replay, archiveName ? sounds : 0, &output);
+		if (matched != replay.steps.size())
+		{
+			printf("ReplayRun: run %d desynced at step %zu\n", run + 1, matched);
+			return 1;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double steps = (double)replay.steps.size() * runs;
+	printf("ReplayRun: %d runs matched in %.1f ms, %.0f steps per second\n", runs, seconds * 1000.0, (seconds > 0.0) ? steps / seconds : 0.0);
+	return 0;
+}
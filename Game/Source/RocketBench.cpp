@@ -0,0 +1,221 @@
+/*
+File Name:		RocketBench.cpp
+Description:	This file is the rocket benchmark. It runs the same rocket workload on the rocket pool and on the vector of
+				rocket pointers the game used before it, at 1k, 10k and 100k rockets: every step moves every rocket, rockets
+				that leave the screen explode and are removed a second later, and new rockets are fired to keep the count up.
+				Both sides draw from rand with the same seed, so they fire, move and remove the same rockets.
+				Usage: RocketBench [steps]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+#include "../Include/Rocket.h"
+
+#define BENCH_DT (1.0f / 60.0f)
+#define BENCH_WIDTH 800.0f
+#define BENCH_HEIGHT 600.0f
+
+//Steps an exploded rocket stays around for, the second the game shows its explosion
+#define BENCH_EXPLOSION_STEPS 60
+
+//A rocket the way the game stored them before the pool, one heap allocation each
+struct PointerRocket
+{
+	float speed;
+	int damage;
+	Vector2 position;
+	Vector2 size;
+	Vector2 direction;
+	float angle;
+	SpriteId texture;
+
+	bool exploded;
+	int explosionStep;
+	int shooter;
+};
+
+//Where a new rocket starts, where it goes and how fast
+struct RocketLaunch
+{
+	Vector2 position;
+	Vector2 direction;
+	float speed;
+};
+
+
+//Function: NextLaunch()
+//Description: This method picks where the next rocket is fired from, on screen, in which direction and at what speed.
+//Returns: RocketLaunch = the launch.
+static RocketLaunch NextLaunch()
+{
+	RocketLaunch launch;
+	launch.position = Vector2{ (float)(rand() % (int)BENCH_WIDTH), (float)(rand() % (int)BENCH_HEIGHT) };
+	float angle = (float)(rand() % 3600) * (VECTOR_PI / 1800.0f);
+	launch.direction = Vector2{ cosf(angle), sinf(angle) };
+	launch.speed = 300.0f + (float)(rand() % 300);
+	return launch;
+}
+
+
+//Function: OffScreen(Vector2 position, Vector2 size)
+//Description: This method checks whether a rocket has left the screen, the way the rocket loop of the game does.
+//Returns: bool = whether it has.
+static bool OffScreen(Vector2 position, Vector2 size)
+{
+	return !(position.x >= -size.x && position.x <= BENCH_WIDTH + size.x && position.y >= -size.y && position.y <= BENCH_HEIGHT + size.y);
+}
+
+
+//Function: RunPointerVector(int rocketCount, int steps)
+//Description: This method runs the workload on a vector of rocket pointers, like the loop the game had before the pool: every
+//rocket is allocated when it is fired, moved and rotated in place, and erased from the middle of the vector when it is removed.
+//Returns: double = the seconds the steps took.
+static double RunPointerVector(int rocketCount, int steps)
+{
+	srand(1);
+	std::vector<PointerRocket*> rockets;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int step = 0; step < steps; step++)
+	{
+		while ((int)rockets.size() < rocketCount)
+		{
+			RocketLaunch launch = NextLaunch();
+			PointerRocket* rocket = new PointerRocket();
+			rocket->position = launch.position;
+			rocket->size = Vector2{ 10.0f, 10.0f };
+			rocket->direction = launch.direction;
+			rocket->texture = SpritePlayerRocket;
+			rocket->speed = launch.speed;
+			rocket->damage = 10;
+			rocket->exploded = false;
+			rocket->explosionStep = 0;
+			rocket->shooter = 0;
+			rockets.push_back(rocket);
+		}
+
+		std::vector<PointerRocket*>::iterator it = rockets.begin();
+		while (it != rockets.end())
+		{
+			PointerRocket* rocket = *it;
+			if (!rocket->exploded)
+			{
+				rocket->position = rocket->position + rocket->direction * rocket->speed * BENCH_DT;
+				rocket->angle = acos(DotProduct(Vector2{ 1.0f, 0.0f }, rocket->direction));
+				if (rocket->direction.y < 0)
+				{
+					rocket->angle = 2 * VECTOR_PI - rocket->angle;
+				}
+
+				if (OffScreen(rocket->position, rocket->size))
+				{
+					rocket->exploded = true;
+					rocket->explosionStep = step;
+				}
+			}
+			else if (step - rocket->explosionStep > BENCH_EXPLOSION_STEPS)
+			{
+				delete rocket;
+				it = rockets.erase(it);
+				continue;
+			}
+
+			it++;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	for (size_t i = 0; i < rockets.size(); i++)
+	{
+		delete rockets[i];
+	}
+	return seconds;
+}
+
+
+//Function: RunPool(int steps)
+//Description: This method runs the workload on a rocket pool of the given capacity, filled to it, the way the game's rocket
+//loop uses its pool: one pass to move everything, then a pass to explode and remove.
+//Returns: double = the seconds the steps took.
+template <int Capacity>
+static double RunPool(int steps)
+{
+	srand(1);
+	FixedRocketPool<Capacity>* rockets = new FixedRocketPool<Capacity>();
+	rockets->Clear();
+
+	//Explosion times count steps here, the pool does not care what unit they are in
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int step = 0; step < steps; step++)
+	{
+		while (rockets->count < Capacity)
+		{
+			RocketLaunch launch = NextLaunch();
+			rockets->Fire(launch.position, Vector2{ 10.0f, 10.0f }, launch.direction, SpritePlayerRocket, launch.speed, 10);
+		}
+
+		rockets->MoveInDirection(BENCH_DT);
+
+		int index = 0;
+		while (index < rockets->count)
+		{
+			if (!rockets->exploded[index])
+			{
+				if (OffScreen(rockets->position[index], rockets->size[index]))
+				{
+					rockets->exploded[index] = true;
+					rockets->explosionTime[index] = step;
+				}
+			}
+			else if (step - rockets->explosionTime[index] > BENCH_EXPLOSION_STEPS)
+			{
+				rockets->Remove(index);
+				continue;
+			}
+
+			index++;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	delete rockets;
+	return seconds;
+}
+
+
+//Function: Report(int rocketCount, int steps, double vectorSeconds, double poolSeconds)
+//Description: This method prints the time per step of both sides and how much faster the pool is.
+//Returns: void.
+static void Report(int rocketCount, int steps, double vectorSeconds, double poolSeconds)
+{
+	printf("RocketBench: %6d rockets: pointer vector %9.3f ms per step, pool %7.3f ms per step, %.1fx\n", rocketCount,
+		vectorSeconds * 1000.0 / steps, poolSeconds * 1000.0 / steps, (poolSeconds > 0.0) ? vectorSeconds / poolSeconds : 0.0);
+}
+
+
+//Function: main()
+//Description: This is the main method of the rocket benchmark.
+//Returns: int = 0.
+int main(int argc, char** argv)
+{
+	int steps = (argc > 1) ? atoi(argv[1]) : 600;
+	if (steps <= 0)
+	{
+		printf("Usage: RocketBench [steps]\n");
+		return 1;
+	}
+
+	printf("RocketBench: %d steps of %.4f s\n", steps, BENCH_DT);
+	Report(1000, steps, RunPointerVector(1000, steps), RunPool<1000>(steps));
+	Report(10000, steps, RunPointerVector(10000, steps), RunPool<10000>(steps));
+
+	//Erasing from the middle of 100k pointers is slow enough that a tenth of the steps tells the story
+	int longSteps = (steps >= 10) ? steps / 10 : 1;
+	Report(100000, longSteps, RunPointerVector(100000, longSteps), RunPool<100000>(longSteps));
+	return 0;
+}
@@ -9,14 +9,16 @@ Date:			April 14, 2017
 #include "../Include/Ship.h"
 
 
-//Function: Ship(float speed, Vector2 startPosition, Vector2 size, TextureHandle texture, int energy, Ability abilities[NUM_ABILITIES])
+//Function: Ship(float speed, Vector2 startPosition, Vector2 size, SpriteId texture, int energy, Ability abilities[NUM_ABILITIES], GameTime now)
 //Description: This is the constructor for a ship. It initializes all information including texture energy and abilities.
+//The cooldowns start out just expired at the simulation time now.
 //Returns: void.
-Ship::Ship(float speed, Vector2 startPosition, Vector2 size, TextureHandle texture, int energy, Ability abilities[NUM_ABILITIES])
+Ship::Ship(float speed, Vector2 startPosition, Vector2 size, SpriteId texture, int energy, Ability abilities[NUM_ABILITIES], GameTime now)
 {
 	this->speed = speed;
 	this->maxspeed = speed;
 	this->position = startPosition;
+	this->previousPosition = startPosition;
 	this->size = size;
 	this->destination = startPosition;
 	this->texture = texture;
@@ -25,19 +27,20 @@ Ship::Ship(float speed, Vector2 startPosition, Vector2 size, TextureHandle textu
 	this->maxEnergy = energy;
 	this->science = 0;
 	this->cooldown = 2;
-	this->cooldown_time = time(0) - cooldown;
-	this->last_heal = time(0) - 1;
+	this->cooldown_time = now - SecondsToGameTime(cooldown);
+	this->last_heal = now - SecondsToGameTime(1);
 	this->spawnedMinions = false;
 
 	this->abilities[0] = abilities[0];
 	this->abilities[1] = abilities[1];
 	this->abilities[2] = abilities[2];
 
-	this->abilityShotTime[0] = time(0) - abilities[0].cooldown;
-	this->abilityShotTime[1] = time(0) - abilities[1].cooldown;
-	this->abilityShotTime[2] = time(0) - abilities[2].cooldown;
+	this->abilityShotTime[0] = now - SecondsToGameTime(abilities[0].cooldown);
+	this->abilityShotTime[1] = now - SecondsToGameTime(abilities[1].cooldown);
+	this->abilityShotTime[2] = now - SecondsToGameTime(abilities[2].cooldown);
 
 	this->boss = false;
+	this->inGrid = false;
 }
 
 
@@ -46,6 +49,9 @@ Ship::Ship(float speed, Vector2 startPosition, Vector2 size, TextureHandle textu
 //Returns: void.
 void Ship::MoveTowardDestination(float timeElapsed)
 {
+	//Remember where the step started so the renderer can interpolate between steps
+	this->previousPosition = this->position;
+
 	Vector2 diff = destination - this->position;
 
 	//If we are at our destination we dont want to move the ship
@@ -60,7 +66,7 @@ void Ship::MoveTowardDestination(float timeElapsed)
 		// we must subtract the smaller angle from 2*PI to get it's reflection
 		if (diff.y < 0)
 		{
-			this->angle = 2 * XM_PI - this->angle;
+			this->angle = 2 * VECTOR_PI - this->angle;
 		}
 	}
 }
@@ -0,0 +1,859 @@
+/*
+File Name:		Simulation.cpp
+Description:	This file runs the game logic for every scene. The player is spawned in with 100 health in the first sector.
+				The goal of the game is to fly to planets and collect energy and science while fighting off the enemies. The game
+				includes rockets shooting from players and enemies, along with boss fights every 10 rounds. Nothing in here
+				draws or plays anything, every scene pushes render and audio commands that the platform layer consumes.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/Simulation.h"
+#include "../Include/Profiler.h"
+
+
+//Function: SimulationStep(GameState& gameState, const Input& input, float dt)
+//Description: This method advances the game by dt seconds. It clears the commands from the last step, initializes the game
+//if needed, and runs the scene we are currently in.
+//Returns: void.
+void SimulationStep(GameState& gameState, const Input& input, float dt)
+{
+	PROFILE_SCOPE("SimulationStep");
+
+	gameState.renderCommands.clear();
+	gameState.audioCommands.clear();
+	gameState.clock.Advance(dt);
+
+	//If the game has not been initialized yet, do so
+	if (!gameState.initialized)
+	{
+		InitializeGame(&gameState);
+	}
+
+	//Switch between level states
+	switch (gameState.levelState)
+	{
+	case LevelState::Start:
+		RunStartGame(input, &gameState);
+		break;
+	case LevelState::Discovery:
+		RunDiscoveryScene(input, &gameState, dt);
+		break;
+	case LevelState::Exploration:
+		RunExplorationScene(input, &gameState, dt);
+		break;
+	case LevelState::GameOver:
+		RunGameOverScene(input, &gameState);
+	}
+}
+
+
+//Function: InitializeGame(GameState* gameState)
+//Description: This method sets up the tile grid, the player ship and enemy spawn points from the screen size in the game state,
+//and generates the first level if the game has been started.
+//Returns: void.
+void InitializeGame(GameState* gameState)
+{
+	//Set tile sizes
+	gameState->tileWidth = gameState->screenWidth / TILE_SIZE;
+	gameState->tileHeight = gameState->screenHeight / TILE_SIZE;
+	gameState->enemyGrid.Initialize(TILE_SIZE, TILE_SIZE, (float)gameState->tileWidth, (float)gameState->tileHeight);
+
+	//Initialize player ship
+	Vector2 playerStartPos = Vector2{ (float)gameState->tileWidth, (float)gameState->screenHeight / 2.0f };
+	Vector2 playerSize = Vector2{ (float)gameState->tileWidth, (float)gameState->tileHeight };
+	Ability abilities[NUM_ABILITIES] = { playerRocket1, playerRocket2, playerRocket3 };
+	delete gameState->player;
+	gameState->player = new Ship(SHIP_PLAYER_SPEED, playerStartPos, playerSize, SpritePlayer, 2000, abilities, gameState->clock.now);
+	gameState->player->energy = 100;
+
+	//Initialize enemy spawn points
+	gameState->enemySpawnpoints[0] = Vector2{ (float)gameState->screenWidth - (float)gameState->tileWidth, (float)gameState->screenHeight / 2.f };
+	gameState->enemySpawnpoints[1] = Vector2{ (float)gameState->screenWidth - (float)gameState->tileWidth, (float)gameState->screenHeight };
+	gameState->enemySpawnpoints[2] = Vector2{ (float)gameState->screenWidth - (float)gameState->tileWidth,  (float)gameState->tileHeight };
+	gameState->currentSector = 1;
+
+	//If the game has been started, generate the level
+	if (gameState->started)
+	{
+		GenerateLevel(gameState);
+	}
+
+	gameState->scienceGathered = 0;
+
+	gameState->initialized = true;
+}
+
+
+//Function: ReleaseGame(GameState* gameState)
+//Description: This method deletes the player ship, the enemy ships and the planets the game state owns, for drivers that
+//run the simulation and then throw the state away.
+//Returns: void.
+void ReleaseGame(GameState* gameState)
+{
+	ClearPlanets(gameState);
+
+	for (size_t i = 0; i < gameState->enemies.size(); i++)
+	{
+		gameState->enemyGrid.Remove(gameState->enemies[i]);
+		delete gameState->enemies[i];
+	}
+	gameState->enemies.clear();
+
+	delete gameState->player;
+	gameState->player = 0;
+}
+
+
+//Function: RunStartGame
+//Description: This method runs the logic for the start screen. It starts and stops the intro music, and starts the game
+//when the user presses enter.
+//Returns: void.
+void RunStartGame(Input input, GameState* gameState)
+{
+	PushAudio(gameState, AudioLoop, SoundIntro, -1000);
+	PushAudio(gameState, AudioStop, SoundSpaceShipMove);
+	PushAudio(gameState, AudioStop, (SoundId)(SoundBackground + gameState->backgroundIndex));
+
+	if (input.enter)
+	{
+		gameState->initialized = false;
+		gameState->started = true;
+		PushAudio(gameState, AudioStop, SoundIntro);
+	}
+}
+
+
+//Function: RunExplorationScene(Input input, GameState* gameState, float timeElapsed)
+//Description: This method runs the exploration scene. This is where the bulk of the action happens. From moving player and
+//enemy ships, to shooting different rockets and abilities to collision detection and sound effects.
+//Returns: void.
+void RunExplorationScene(Input input, GameState* gameState, float timeElapsed)
+{
+	Ship* player = gameState->player;
+	std::vector<Ship*>::iterator enemyIterator = gameState->enemies.begin();
+
+	//Get rid of ships that have been destroyed
+	while (enemyIterator != gameState->enemies.end())
+	{
+		Ship* enemy = (*enemyIterator);
+
+		if (enemy->energy <= 0)
+		{
+			gameState->enemyGrid.Remove(enemy);
+			enemyIterator = gameState->enemies.erase(enemyIterator);
+			delete enemy;
+		}
+		else
+		{
+			enemyIterator++;
+		}
+	}
+	enemyIterator = gameState->enemies.begin();
+
+	//If our energy reaches zero we lose.
+	if (player->energy <= 0)
+	{
+		gameState->levelState = LevelState::GameOver;
+		return;
+	}
+
+	//If it is a boss level, we want to check the boss' health and spawn minions every third of health.
+	if (gameState->currentSector % 10 == 0)
+	{
+		for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
+		{
+			Ship* enemy = gameState->enemies.at(i);
+			if (enemy->boss && enemy->energy < (enemy->maxEnergy / 3))
+			{
+				if (!enemy->spawnedMinions)
+				{
+					enemy->spawnedMinions = true;
+
+					//Ship information for a minion
+					Vector2 shipSize = Vector2{ (float)gameState->tileWidth, (float)gameState->tileHeight };
+					int minionEnergy = 100 + (100 * (gameState->currentSector / 10));
+					Ability minionAbilities[NUM_ABILITIES] = { enemy2Laser, enemy2Laser, enemy2Laser };
+
+					//Spawn minions
+					Ship* minion1 = new Ship(SHIP_ENEMY_SPEED, gameState->enemySpawnpoints[1], shipSize, (SpriteId)(SpriteEnemy + 1), minionEnergy, minionAbilities, gameState->clock.now);
+					Ship* minion2 = new Ship(SHIP_ENEMY_SPEED, gameState->enemySpawnpoints[2], shipSize, (SpriteId)(SpriteEnemy + 1), minionEnergy, minionAbilities, gameState->clock.now);
+
+					gameState->enemies.push_back(minion1);
+					gameState->enemies.push_back(minion2);
+				}
+			}
+		}
+	}
+
+	//If we click the left mouse button we set the players destination to the mouse click position
+	if (input.mouse.clickedL)
+	{
+		//If click is on the window, set the destination
+		if ((float)input.mouse.x >= 0 && (float)input.mouse.x <= gameState->screenWidth &&
+			(float)input.mouse.y >= 0 && (float)input.mouse.y <= gameState->screenHeight)
+		{
+			Vector2 newDestination = Vector2{ (float)input.mouse.x, (float)(gameState->screenHeight - input.mouse.y) };
+			player->destination = newDestination;
+		}
+	}
+
+	//If we press 4, we want to check the difference between the last heal and heal the player for 500 energy for a price of 500 science
+	if (input.key4)
+	{
+		if (gameState->clock.Since(player->last_heal) > SecondsToGameTime(1))
+		{
+			if (player->science >= 500 && player->energy < player->maxEnergy)
+			{
+				player->last_heal = gameState->clock.now;
+				player->science -= 500;
+				player->energy += 500;
+				if (player->energy > player->maxEnergy)
+					player->energy = player->maxEnergy;
+			}
+		}
+	}
+
+	//Set the ability index to the key that is pressed and -1 if none is pressed.
+	int abilityIndex = (input.key1) ? 0 : (input.key2) ? 1 : (input.key3) ? 2 : -1;
+
+	//If we fired an ability, instantiate a rocket of the ability type and fire it
+	if (abilityIndex > -1 && abilityIndex < NUM_ABILITIES)
+	{
+		Ability ability = player->abilities[abilityIndex];
+
+		//If we have enough science, we can use the ability
+		if (player->science >= ability.scienceCost)
+		{
+			if (gameState->clock.Since(player->abilityShotTime[abilityIndex]) > SecondsToGameTime(ability.cooldown))
+			{
+				//Set the ability shot time
+				player->abilityShotTime[abilityIndex] = gameState->clock.now;
+
+				//Rotate the rocket and fire it out of the front of the player ship
+				Vector2 direction = Vector2{ cosf(player->angle), sinf(player->angle) };
+				direction = Normalize(direction);
+
+				//Fire a rocket from the pool
+				gameState->rockets.Fire(player->position, ability.rocketSize, direction, (SpriteId)(SpritePlayerRocket + ability.rocketIndex), ability.speed, ability.damage);
+				player->science -= ability.scienceCost;
+
+				//Play rocket sound
+				PushAudioAt(gameState, AudioPlay, SoundMissileFire, -1500, player->position);
+			}
+		}
+	}
+
+	//Enemy shooting at player
+	GameTime now = gameState->clock.now;
+	for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
+	{
+		Ship* enemy = gameState->enemies.at(i);
+
+		//Enemy needs to cooldown after shooting any rocket (stops from double shooting between rocket types)
+		if (now - enemy->cooldown_time > SecondsToGameTime(enemy->cooldown))
+		{
+			enemy->cooldown_time = now;
+
+			for (int i = (gameState->currentSector / 10); i >= 0; i--)
+			{
+				//If the time between the last shot and now is greater than the shoot rate, shoot again.
+				if (now - enemy->abilityShotTime[i] > SecondsToGameTime(enemy->abilities[i].cooldown))
+				{
+					Ability ability = enemy->abilities[i];
+					enemy->abilityShotTime[i] = now;
+					SpriteId rocketSprite = (SpriteId)(SpriteEnemyRocket + ability.rocketIndex);
+
+					//If the enemy is a boss, we shoot double rockets offset to appear. Otherwise shoot single bullets
+					if (enemy->boss)
+					{
+						Vector2 offset = { 0.0f, 30.0f };
+						Vector2 rocket1Direction = Normalize((player->position + offset) - (enemy->position + offset));
+						Vector2 rocket2Direction = Normalize((player->position - offset) - (enemy->position - offset));
+						gameState->rockets.Fire(enemy->position + offset, ability.rocketSize, rocket1Direction, rocketSprite, ability.speed, ability.damage, 1);
+						gameState->rockets.Fire(enemy->position - offset, ability.rocketSize, rocket2Direction, rocketSprite, ability.speed, ability.damage, 1);
+					}
+					else
+					{
+						Vector2 newDirection = Normalize(player->position - enemy->position);
+						gameState->rockets.Fire(enemy->position, ability.rocketSize, newDirection, rocketSprite, ability.speed, ability.damage, 1);
+					}
+
+					//Play rocket sound
+					PushAudioAt(gameState, AudioPlay, SoundMissileFire, -1500, enemy->position);
+
+					break;
+				}
+			}
+		}
+	}
+
+	//Get the distances between the player and enemy and player to target
+	float playerDistanceToTarget = Magnitude(player->destination - player->position);
+
+	//Move the player towards the target
+	gameState->player->MoveTowardDestination(timeElapsed);
+
+	//If the player is moving (not at their destination) the engine sound loops, otherwise it is stopped
+	if (playerDistanceToTarget > SHIP_NEAR_THRESHOLD)
+	{
+		PushAudio(gameState, AudioLoop, SoundSpaceShipMove, 0);
+	}
+	else
+	{
+		PushAudio(gameState, AudioStop, SoundSpaceShipMove);
+	}
+
+	for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
+	{
+		Ship* enemy = gameState->enemies.at(i);
+
+		//Move the enemy towards the player
+		enemy->destination = player->position;
+		enemy->MoveTowardDestination(timeElapsed);
+
+		float enemyDistFromPlayer = Magnitude(player->position - enemy->position);
+
+		//If the enemy ship gets close enough, TURBOFIRE ROCKETS!
+		if (enemyDistFromPlayer < 100)
+		{
+			enemy->speed = enemy->maxspeed * SHIP_ENEMY_SPEEDBOOST;
+		}
+		else
+		{
+			enemy->speed = enemy->maxspeed;
+		}
+
+		//If the enemy is close enough to the player, deduct 300 energy and generate a new level
+		if (enemyDistFromPlayer < 10)
+		{
+			player->energy -= 300;
+			if (player->energy < 0)
+				player->energy = 0;
+
+			GenerateLevel(gameState);
+		}
+
+	}
+
+	//Move the enemies to the grid tiles they overlap now. Ships that stayed in the same tiles are left alone.
+	for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
+	{
+		gameState->enemyGrid.Update(gameState->enemies.at(i));
+	}
+
+	gameState->displayLevelNotClear = false;
+	//Generate a new level if we reach the end and continue
+	if (player->position.x >= gameState->screenWidth - (player->size.x / 2))
+	{
+		if (gameState->enemies.size() > 0)
+		{
+			gameState->displayLevelNotClear = true;
+		}
+		else
+		{
+			gameState->currentSector++;
+			GenerateLevel(gameState);
+		}
+	}
+
+	//Set near planet to false before every time we check if we are near a planet
+	gameState->nearPlanet = false;
+
+	//Test the player against the tiles of every planet at once
+	CollideBoxes(player->position.x - (player->size.x / 2), player->position.y - (player->size.y / 2), player->size.x, player->size.y, &gameState->planetBoxes);
+
+	//Update and draw all planets generated by the level
+	for (int planetIndex = 0; planetIndex != gameState->planets.size(); planetIndex++)
+	{
+		Planet* planet = gameState->planets[planetIndex];
+		if (!planet->visited)
+		{
+			//If player collides with a planet
+			if (gameState->planetBoxes.Hit(planetIndex))
+			{
+				gameState->nearPlanet = true;
+				if (input.keyE)
+				{
+					//Load the discovery scene and set planet information for recovery
+					gameState->levelState = LevelState::Discovery;
+					gameState->currentPlanet = planet;
+					gameState->currentPlanetLastPos = planet->position;
+					gameState->currentPlanet->position.x = 0;
+					gameState->currentPlanet->position.y = 0.2f;
+					gameState->currentPlanet->position.z = 2;
+					player->destination = player->position;
+					PushAudio(gameState, AudioStop, SoundSpaceShipMove);
+					return;
+				}
+			}
+		}
+
+		//Draw the planet at its current rotation, then update it
+		PushPlanet(gameState, planet);
+		planet->Update(timeElapsed);
+	}
+
+	//Move the rockets and collide them with the ships they were fired at
+	RunRockets(gameState, timeElapsed);
+
+	//Iterate through enemies and draw them at their positions
+	for (size_t i = 0, size = gameState->enemies.size(); i != size; i++)
+	{
+		Ship* enemy = gameState->enemies.at(i);
+		PushMovingSprite(gameState, enemy->texture, enemy->previousPosition, enemy->position, enemy->size, 10, enemy->angle);
+	}
+
+	//Draw the player ship
+	PushMovingSprite(gameState, player->texture, player->previousPosition, player->position, player->size, 20, player->angle);
+}
+
+
+//Function: RunRockets(GameState* gameState, float timeElapsed)
+//Description: This method moves all rockets that havent exploded, then checks their collisions with the appropriate targets.
+//Exploded rockets are removed a second later, the rest are drawn.
+//Returns: void.
+void RunRockets(GameState* gameState, float timeElapsed)
+{
+	PROFILE_SCOPE("Rockets");
+
+	Ship* player = gameState->player;
+	RocketPool* rockets = &gameState->rockets;
+	rockets->MoveInDirection(timeElapsed);
+
+	//Removing a rocket moves the last rocket into its slot, so we only advance the index when the rocket is kept
+	int rocketIndex = 0;
+	while (rocketIndex < rockets->count)
+	{
+		Vector2 rocketPosition = rockets->position[rocketIndex];
+		Vector2 rocketSize = rockets->size[rocketIndex];
+
+		//If the rocket hasnt exploded, we check collisions with the appropriate targets
+		if (!rockets->exploded[rocketIndex])
+		{
+			//If the rocket comes from shooter 0 (player) then we check collisions with the enemies near it, otherwise vice versa
+			if (rockets->shooter[rocketIndex] == 0)
+			{
+				std::vector<Ship*>& nearbyEnemies = gameState->enemyGrid.Query(rocketPosition.x - (rocketSize.x / 2), rocketPosition.y - (rocketSize.y / 2), rocketSize.x, rocketSize.y);
+
+				//Pack the nearby enemies and test the rocket against all of them at once
+				BoxArray* enemyBoxes = &gameState->nearbyEnemyBoxes;
+				enemyBoxes->Clear();
+				for (size_t i = 0, size = nearbyEnemies.size(); i != size; i++)
+				{
+					Ship* enemy = nearbyEnemies[i];
+					enemyBoxes->Add(enemy->position.x - (enemy->size.x / 2), enemy->position.y - (enemy->size.y / 2), enemy->size.x, enemy->size.y);
+				}
+				CollideBoxes(rocketPosition.x - (rocketSize.x / 2), rocketPosition.y - (rocketSize.y / 2), rocketSize.x, rocketSize.y, enemyBoxes);
+
+				for (size_t i = 0, size = nearbyEnemies.size(); i != size; i++)
+				{
+					Ship* enemy = nearbyEnemies[i];
+
+					//Explode and deal damage if a collision is met
+					if (enemyBoxes->Hit(i))
+					{
+						rockets->exploded[rocketIndex] = true;
+						enemy->energy -= rockets->damage[rocketIndex];
+
+						rockets->explosionTime[rocketIndex] = gameState->clock.now;
+						rockets->texture[rocketIndex] = SpriteExplosion;
+						PushAudioAt(gameState, AudioPlay, SoundMissileHit, -1000, rocketPosition);
+					}
+				}
+			}
+			else
+			{
+				//Check collisions with rockets, explode and deal damage if a collision is met
+				if (CheckCollision(rocketPosition.x - (rocketSize.x / 2), rocketPosition.y - (rocketSize.y / 2), rocketSize.x, rocketSize.y,
+					player->position.x - (player->size.x / 2), player->position.y - (player->size.y / 2), player->size.x, player->size.y))
+				{
+					rockets->exploded[rocketIndex] = true;
+					player->energy -= rockets->damage[rocketIndex];
+
+					rockets->explosionTime[rocketIndex] = gameState->clock.now;
+					rockets->texture[rocketIndex] = SpriteExplosion;
+					PushAudioAt(gameState, AudioPlay, SoundMissileHit, -1000, rocketPosition);
+				}
+			}
+
+			//If the rocket goes out of the map, we want to delete it as well
+			if (!(rocketPosition.x >= 0 - rocketSize.x && rocketPosition.x <= gameState->screenWidth + rocketSize.x &&
+				rocketPosition.y >= 0 - rocketSize.y && rocketPosition.y <= gameState->screenHeight + rocketSize.y))
+			{
+				rockets->exploded[rocketIndex] = true;
+				rockets->explosionTime[rocketIndex] = gameState->clock.now;
+			}
+		}
+		//Wait 1 second after exploded to delete the rocket from the pool (shows explosion for 1sec)
+		else if (gameState->clock.Since(rockets->explosionTime[rocketIndex]) > SecondsToGameTime(1))
+		{
+			rockets->Remove(rocketIndex);
+			continue;
+		}
+
+		//Draw the rocket
+		PushMovingSprite(gameState, rockets->texture[rocketIndex], rockets->previousPosition[rocketIndex], rocketPosition, rocketSize, 10, rockets->angle[rocketIndex]);
+		rocketIndex++;
+	}
+}
+
+
+//Function: RunDiscoveryScene(Input input, GameState* gameState, float timeElapsed)
+//Description: This method runs the discovery scene which allows the player to view a spinning 3d representation of the model,
+//along with allowing them to gather a random amount of energy from the planet.
+//Returns: void.
+void RunDiscoveryScene(Input input, GameState* gameState, float timeElapsed)
+{
+	Planet* planet = gameState->currentPlanet;
+
+	//If we press 3 or enter we want to go back to the exploration scene,
+	//if the planet is out of resources it becomes a black hole and is no longer interactable
+	if (input.key3 || input.enter)
+	{
+		gameState->levelState = LevelState::Exploration;
+		planet->position = gameState->currentPlanetLastPos;
+		if (planet->science == 0 && planet->energy == 0)
+		{
+			planet->visited = true;
+			planet->texture = (SpriteId)(SpritePlanet + BLACK_HOLE_INDEX);
+		}
+		return;
+	}
+	else if (input.key1)
+	{
+		int newEnergyCount = gameState->player->energy + planet->energy;
+		if (newEnergyCount > 2000)
+		{
+			newEnergyCount = 2000;
+		}
+		gameState->player->energy = newEnergyCount;
+		planet->energy = 0;
+	}
+	else if (input.key2)
+	{
+		gameState->player->science += planet->science;
+		gameState->scienceGathered += planet->science;
+		planet->science = 0;
+	}
+
+	planet->Update(timeElapsed);
+
+	//Position and draw the planet in the middle of the screen
+	PushPlanet(gameState, planet);
+
+	//Draw the ship beside the planet
+	PushSprite(gameState, gameState->player->texture, (gameState->screenWidth - gameState->tileWidth) / 4.0f, (gameState->screenHeight - gameState->tileHeight) / 2.0f, gameState->tileWidth * 2, gameState->tileHeight * 2, 20, 0);
+}
+
+
+//Function: RunGameOverScene(Input input, GameState* gameState)
+//Description: This method runs the game over scene which just checks for an enter and brings the player to the start screen.
+//Returns: void.
+void RunGameOverScene(Input input, GameState* gameState)
+{
+	if (input.enter)
+	{
+		gameState->levelState = LevelState::Start;
+	}
+}
+
+
+//Function: SeedSimulationRandom(GameState* gameState, uint32_t seed)
+//Description: This method seeds the random numbers the level generator draws, like srand.
+//Returns: void.
+void SeedSimulationRandom(GameState* gameState, uint32_t seed)
+{
+	gameState->randomState = seed;
+}
+
+
+//Function: SimulationRandom(GameState* gameState)
+//Description: This method draws the next random number for the level generator. It is the generator of the MSVC rand, so the
+//game makes the same levels as it always has, but the same on every compiler, which recordings and golden frames rely on.
+//Returns: int = a number from 0 to 32767.
+int SimulationRandom(GameState* gameState)
+{
+	gameState->randomState = gameState->randomState * 214013u + 2531011u;
+	return (int)((gameState->randomState >> 16) & 0x7FFF);
+}
+
+
+//Function: CheckCollision(float x1, float y1, float width1, float height1, float x2, float y2, float width2, float height2)
+//Description: This method uses standard AABB collision detection in order to detect collisions using the position and size of the vectors
+//Returns: bool = whether the boxes overlap.
+bool CheckCollision(float x1, float y1, float width1, float height1, float x2, float y2, float width2, float height2)
+{
+	if (x1 + width1 < x2 || x1 > x2 + width2)
+		return false;
+	if (y1 + height1 < y2 || y1 > y2 + height2)
+		return false;
+
+	return true;
+}
+
+
+#pragma region Level Generation
+
+
+//Function: InitializeSectorBattle(GameState* gameState)
+//Description: This method initializes the ships in the sector depending on what sector it is. It uses an algorithm to get the
+//number of enemies, their shooting rates, whether it is a boss level, and the rockets they use. This is my first shot at "Procedural" level design,
+//but works more like a pattern than anything :)
+//Returns: void.
+void InitializeSectorBattle(GameState* gameState)
+{
+	Vector2 shipSize = Vector2{ (float)gameState->tileWidth, (float)gameState->tileHeight };
+
+	int sector = gameState->currentSector;
+	int numberOfEnemies = 1 + (((sector % 10) - 1) / 3);
+
+	//Reposition player
+	Vector2 playerStartPos = Vector2{ (float)gameState->tileWidth, (float)gameState->screenHeight / 2.0f };
+	gameState->player->position = playerStartPos;
+	gameState->player->previousPosition = playerStartPos;
+	gameState->player->destination = playerStartPos;
+	gameState->player->speed = SHIP_PLAYER_SPEED;
+
+	for (size_t i = 0; i < gameState->enemies.size(); i++)
+	{
+		delete gameState->enemies[i];
+	}
+	gameState->enemies.clear();
+	gameState->enemyGrid.Clear();
+
+	//Every 10 levels there is a boss phase that gets increasingly harder
+	if (sector % 10 == 0)
+	{
+		//Boss index and energy
+		int bossIndex = (sector / 10 > 2) ? 2 : (sector / 10) - 1;
+		int bossEnergy = 2000 + (2000 * (sector / 10));
+
+		//Set the boss abilities to use the boss rockets
+		Ability bossAbilities[NUM_ABILITIES] = { bossRocket1, bossRocket2, bossRocket3 };
+
+		//Initialize the boss
+		Ship* boss = new Ship(0.0f, gameState->enemySpawnpoints[0], shipSize * 2, (SpriteId)(SpriteBoss + bossIndex), bossEnergy, bossAbilities, gameState->clock.now);
+		boss->cooldown = 1;
+		boss->boss = true;
+
+		//Get minion ability and energy info
+		Ability minionAbilities[NUM_ABILITIES] = { enemy2Laser, enemy2Laser, enemy2Laser };
+		int minionEnergy = 100 + (100 * (sector / 10));
+
+		//Initialize minions
+		Ship* minion1 = new Ship(SHIP_ENEMY_SPEED, gameState->enemySpawnpoints[1], shipSize, (SpriteId)(SpriteEnemy + 1), minionEnergy, minionAbilities, gameState->clock.now);
+		Ship* minion2 = new Ship(SHIP_ENEMY_SPEED, gameState->enemySpawnpoints[2], shipSize, (SpriteId)(SpriteEnemy + 1), minionEnergy, minionAbilities, gameState->clock.now);
+
+		//Add enemies to the list of enemies
+		gameState->enemies.push_back(boss);
+		gameState->enemies.push_back(minion1);
+		gameState->enemies.push_back(minion2);
+	}
+	else
+	{
+		//Loop through the number of enemies that we are spawning and get their information based on algorithms
+		for (int i = 0; i < numberOfEnemies; i++)
+		{
+			//Get the speed multiplier. Alternates every 3 for boost of 1, 1.25 and 1.5 then repeated.
+			//Every 10th is disregarded and starts again at the 1
+			float speedMultiplier = 0.75f + ((float)((((sector % 10) - 1) % 3) + 1) / 4);
+
+			//Get the starting information for the enemy
+			Vector2 enemyStartPos = gameState->enemySpawnpoints[i];
+			float enemySpeed = SHIP_ENEMY_SPEED * speedMultiplier;
+			SpriteId texture = SpriteEnemy;
+			int energy = 100 + (sector * 25);
+
+			//Get enemy abilities
+			Ability abilities[3] = { enemy1Rocket1, enemy1Rocket2, enemy1Rocket3 };
+
+			//If there are 3 enemies, we want the middle one to be the second type of rocket, with some different traits.
+			if (numberOfEnemies == 3 && i == 0)
+			{
+				enemySpeed += 10;
+				texture = (SpriteId)(SpriteEnemy + 1);
+				energy += 100;
+				abilities[0] = enemy2Laser;
+				abilities[1] = enemy2Laser;
+				abilities[2] = enemy2Laser;
+			}
+
+			//Initialize the enemy object and add it to enemies
+			Ship* enemy = new Ship(enemySpeed, enemyStartPos, shipSize, texture, energy, abilities, gameState->clock.now);
+			gameState->enemies.push_back(enemy);
+		}
+	}
+}
+
+
+//Function: ClearPlanets(GameState* gameState)
+//Description: This method deletes the planets of the current level and their collision boxes.
+//Returns: void.
+void ClearPlanets(GameState* gameState)
+{
+	std::vector<Planet*>::iterator it1 = gameState->planets.begin();
+	while (it1 != gameState->planets.end())
+	{
+		delete (*it1);
+		it1 = gameState->planets.erase(it1);
+	}
+	gameState->planetBoxes.Clear();
+}
+
+
+//Function: GenerateLevel()
+//Description: This method generates a random level by choosing a random universe background, placing a random number of planets
+//and positioning them with randomized values.
+//Returns: void.
+void GenerateLevel(GameState* gameState)
+{
+	PROFILE_SCOPE("GenerateLevel");
+
+	//The last background index to stop the previous music that was playing
+	int lastBackgroundIndex = gameState->backgroundIndex;
+	gameState->backgroundIndex = SimulationRandom(gameState) % NUM_BACKGROUNDS;
+
+	ClearPlanets(gameState);
+
+	//Clear rockets
+	gameState->rockets.Clear();
+
+	//Loop through all tiles and randomly assign planets to their positions
+	for (int tileY = 0; tileY != TILE_SIZE; tileY++)
+	{
+		for (int tileX = 0; tileX != TILE_SIZE; tileX++)
+		{
+			if (SimulationRandom(gameState) % 20 == 0)
+			{
+				if (gameState->planets.size() < MAX_PLANETS)
+				{
+					Vector3 newPosition = {};
+
+					//Set the planets position. I toyed around with a lot of these values to get the look and feel we want (THANK YOU REAL-TIME CODE RECOMPILATION)
+					newPosition.z = 9;
+					newPosition.x = (((float)tileX / (float)TILE_SIZE) * 23.0f) - 10.3f;
+					newPosition.y = (((float)tileY / (float)TILE_SIZE) * 17.5f) - 7.9f;
+
+					Vector3 newRotationAxis = Vector3{ (float)(SimulationRandom(gameState) % 100), (float)(SimulationRandom(gameState) % 100) , (float)(SimulationRandom(gameState) % 100) };
+					float newRotationSpeed = ((float)(SimulationRandom(gameState) % 100) / 100.f) * 0.5f + 0.5f;
+
+					int planetIndex = SimulationRandom(gameState) % (NUM_PLANET_TYPES - 1);
+
+					//Set the texture to a new random planet texture and set its position (Our last planet type is the black hole, dont use it for normal planets (subtract 1))
+					SpriteId newTexture = (SpriteId)(SpritePlanet + planetIndex);
+					std::string newName = gameState->planetNames[planetIndex];
+
+					int newTileX = tileX * gameState->tileWidth;
+					int newTileY = tileY * gameState->tileHeight;
+
+					//Initialize energy and science, science goes up per 10 sectors
+					int energy = (SimulationRandom(gameState) % 180) + 20;
+					int science = (SimulationRandom(gameState) % 350) + 100 + (100 * (gameState->currentSector / 10));
+
+					//Create new planet
+					Planet* newPlanet = new Planet(newRotationSpeed, newPosition, newTexture);
+					newPlanet->rotationAxis = newRotationAxis;
+					newPlanet->angle = 0.0f;
+					newPlanet->tileX = newTileX;
+					newPlanet->tileY = newTileY;
+					newPlanet->energy = energy;
+					newPlanet->science = science;
+					newPlanet->name = newName;
+
+					gameState->planets.push_back(newPlanet);
+					gameState->planetBoxes.Add(newTileX, newTileY, gameState->tileWidth, gameState->tileHeight);
+				}
+			}
+		}
+	}
+
+	//Initialize the sector
+	InitializeSectorBattle(gameState);
+
+	//Set start to exploration to start the exploration
+	gameState->levelState = LevelState::Exploration;
+
+	//Switch music tracks to the appropriate background music
+	PushAudio(gameState, AudioStop, (SoundId)(SoundBackground + lastBackgroundIndex));
+	PushAudio(gameState, AudioLoop, (SoundId)(SoundBackground + gameState->backgroundIndex), -1000);
+}
+
+#pragma endregion
+
+
+#pragma region Commands
+
+//Function: PushSprite(GameState* gameState, SpriteId sprite, float x, float y, float width, float height, int zOrder, float angle)
+//Description: This method queues a screen space sprite to be drawn by the platform layer.
+//Returns: void.
+void PushSprite(GameState* gameState, SpriteId sprite, float x, float y, float width, float height, int zOrder, float angle)
+{
+	RenderCommand command = {};
+	command.type = RenderSprite;
+	command.sprite = sprite;
+	command.previousX = x;
+	command.previousY = y;
+	command.x = x;
+	command.y = y;
+	command.width = width;
+	command.height = height;
+	command.zOrder = zOrder;
+	command.angle = angle;
+	gameState->renderCommands.push_back(command);
+}
+
+//Function: PushMovingSprite(GameState* gameState, SpriteId sprite, Vector2 previousCenter, Vector2 center, Vector2 size, int zOrder, float angle)
+//Description: This method queues a sprite that moved this step, centered on where it was at the start and end of the step.
+//Returns: void.
+void PushMovingSprite(GameState* gameState, SpriteId sprite, Vector2 previousCenter, Vector2 center, Vector2 size, int zOrder, float angle)
+{
+	PushSprite(gameState, sprite, center.x - (size.x / 2), center.y - (size.y / 2), size.x, size.y, zOrder, angle);
+
+	RenderCommand& command = gameState->renderCommands.back();
+	command.previousX = previousCenter.x - (size.x / 2);
+	command.previousY = previousCenter.y - (size.y / 2);
+}
+
+//Function: PushPlanet(GameState* gameState, Planet* planet)
+//Description: This method queues a planet to be drawn as a sphere at its world position and rotation.
+//Returns: void.
+void PushPlanet(GameState* gameState, Planet* planet)
+{
+	RenderCommand command = {};
+	command.type = RenderPlanet;
+	command.sprite = planet->texture;
+	command.angle = planet->angle;
+	command.position = planet->position;
+	command.rotationAxis = planet->rotationAxis;
+	gameState->renderCommands.push_back(command);
+}
+
+//Function: PushAudio(GameState* gameState, AudioCommandType type, SoundId sound, long volume)
+//Description: This method queues a sound to be played, looped or stopped by the platform layer.
+//Returns: void.
+void PushAudio(GameState* gameState, AudioCommandType type, SoundId sound, long volume)
+{
+	AudioCommand command = {};
+	command.type = type;
+	command.sound = sound;
+	command.volume = volume;
+	gameState->audioCommands.push_back(command);
+}
+
+//Function: PushAudioAt(GameState* gameState, AudioCommandType type, SoundId sound, long volume, Vector2 position)
+//Description: This method queues a sound that comes from a point on the screen, so the platform layer can pan it and let it
+//fade with its distance from the player.
+//Returns: void.
+void PushAudioAt(GameState* gameState, AudioCommandType type, SoundId sound, long volume, Vector2 position)
+{
+	AudioCommand command = {};
+	command.type = type;
+	command.sound = sound;
+	command.volume = volume;
+	command.positional = true;
+	command.offset = position - gameState->player->position;
+	gameState->audioCommands.push_back(command);
+}
+
+#pragma endregion
@@ -0,0 +1,610 @@
+/*
+File Name:		SoftwareRenderer.cpp
+Description:	This file holds the definition of the software renderer: the matrix math, the vertex transforms of texture.vs,
+				triangle setup and binning, and the tile rasterizer that does the work of texture.ps and the blend state.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/SoftwareRenderer.h"
+#include "../Include/JobQueue.h"
+#include "../Include/TGA.h"
+#include <math.h>
+
+//SSE2 is always there on x64, elsewhere the coverage test runs one pixel at a time
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+	#define SOFTWARE_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define SOFTWARE_SSE2 0
+#endif
+
+#define SUBPIXEL_SCALE (1 << SOFTWARE_SUBPIXEL_BITS)
+
+
+#pragma region Matrices
+
+//Function: MatrixIdentity()
+//Description: This method makes an identity matrix.
+//Returns: SoftwareMatrix = the matrix.
+SoftwareMatrix MatrixIdentity()
+{
+	SoftwareMatrix result = {};
+	for (int i = 0; i < 4; i++)
+	{
+		result.m[i][i] = 1.0f;
+	}
+	return result;
+}
+
+
+//Function: MatrixMultiply(const SoftwareMatrix& a, const SoftwareMatrix& b)
+//Description: This method multiplies two matrices, a row vector is transformed by a first and then by b.
+//Returns: SoftwareMatrix = the product.
+SoftwareMatrix MatrixMultiply(const SoftwareMatrix& a, const SoftwareMatrix& b)
+{
+	SoftwareMatrix result;
+	for (int row = 0; row < 4; row++)
+	{
+		for (int column = 0; column < 4; column++)
+		{
+			result.m[row][column] = a.m[row][0] * b.m[0][column] + a.m[row][1] * b.m[1][column] + a.m[row][2] * b.m[2][column] + a.m[row][3] * b.m[3][column];
+		}
+	}
+	return result;
+}
+
+
+//Function: MatrixScaling(float x, float y, float z)
+//Description: This method makes a scaling matrix.
+//Returns: SoftwareMatrix = the matrix.
+SoftwareMatrix MatrixScaling(float x, float y, float z)
+{
+	SoftwareMatrix result = MatrixIdentity();
+	result.m[0][0] = x;
+	result.m[1][1] = y;
+	result.m[2][2] = z;
+	return result;
+}
+
+
+//Function: MatrixTranslation(float x, float y, float z)
+//Description: This method makes a translation matrix.
+//Returns: SoftwareMatrix = the matrix.
+SoftwareMatrix MatrixTranslation(float x, float y, float z)
+{
+	SoftwareMatrix result = MatrixIdentity();
+	result.m[3][0] = x;
+	result.m[3][1] = y;
+	result.m[3][2] = z;
+	return result;
+}
+
+
+//Function: MatrixRotationX(float angle)
+//Description: This method makes a matrix that rotates around the x axis.
+//Returns: SoftwareMatrix = the matrix.
+SoftwareMatrix MatrixRotationX(float angle)
+{
+	float sinAngle = sinf(angle);
+	float cosAngle = cosf(angle);
+
+	SoftwareMatrix result = MatrixIdentity();
+	result.m[1][1] = cosAngle;
+	result.m[1][2] = sinAngle;
+	result.m[2][1] = -sinAngle;
+	result.m[2][2] = cosAngle;
+	return result;
+}
+
+
+//Function: MatrixRotationAxis(float x, float y, float z, float angle)
+//Description: This method makes a matrix that rotates around an axis, which does not have to be normalized.
+//Returns: SoftwareMatrix = the matrix.
+SoftwareMatrix MatrixRotationAxis(float x, float y, float z, float angle)
+{
+	float length = sqrtf(x * x + y * y + z * z);
+	x /= length;
+	y /= length;
+	z /= length;
+
+	float sinAngle = sinf(angle);
+	float cosAngle = cosf(angle);
+	float t = 1.0f - cosAngle;
+
+	SoftwareMatrix result = MatrixIdentity();
+	result.m[0][0] = x * x * t + cosAngle;
+	result.m[0][1] = x * y * t + z * sinAngle;
+	result.m[0][2] = x * z * t - y * sinAngle;
+	result.m[1][0] = x * y * t - z * sinAngle;
+	result.m[1][1] = y * y * t + cosAngle;
+	result.m[1][2] = y * z * t + x * sinAngle;
+	result.m[2][0] = x * z * t + y * sinAngle;
+	result.m[2][1] = y * z * t - x * sinAngle;
+	result.m[2][2] = z * z * t + cosAngle;
+	return result;
+}
+
+
+//Function: MatrixPerspectiveFovLH(float fieldOfView, float aspect, float nearZ, float farZ)
+//Description: This method makes a left handed perspective projection matrix.
+//Returns: SoftwareMatrix = the matrix.
+SoftwareMatrix MatrixPerspectiveFovLH(float fieldOfView, float aspect, float nearZ, float farZ)
+{
+	float yScale = cosf(fieldOfView * 0.5f) / sinf(fieldOfView * 0.5f);
+	float range = farZ / (farZ - nearZ);
+
+	SoftwareMatrix result = {};
+	result.m[0][0] = yScale / aspect;
+	result.m[1][1] = yScale;
+	result.m[2][2] = range;
+	result.m[2][3] = 1.0f;
+	result.m[3][2] = -range * nearZ;
+	return result;
+}
+
+
+//Function: MatrixOrthographicLH(float width, float height, float nearZ, float farZ)
+//Description: This method makes a left handed orthographic projection matrix.
+//Returns: SoftwareMatrix = the matrix.
+SoftwareMatrix MatrixOrthographicLH(float width, float height, float nearZ, float farZ)
+{
+	float range = 1.0f / (farZ - nearZ);
+
+	SoftwareMatrix result = MatrixIdentity();
+	result.m[0][0] = 2.0f / width;
+	result.m[1][1] = 2.0f / height;
+	result.m[2][2] = range;
+	result.m[3][2] = -range * nearZ;
+	return result;
+}
+
+#pragma endregion
+
+
+//Function: TransformVertex(const SoftwareMatrix& matrix, float x, float y, float z, float u, float v)
+//Description: This method transforms a position into clip space and passes the texture coordinates through.
+//Returns: ClipVertex = the transformed vertex.
+static ClipVertex TransformVertex(const SoftwareMatrix& matrix, float x, float y, float z, float u, float v)
+{
+	ClipVertex result;
+	result.x = x * matrix.m[0][0] + y * matrix.m[1][0] + z * matrix.m[2][0] + matrix.m[3][0];
+	result.y = x * matrix.m[0][1] + y * matrix.m[1][1] + z * matrix.m[2][1] + matrix.m[3][1];
+	result.z = x * matrix.m[0][2] + y * matrix.m[1][2] + z * matrix.m[2][2] + matrix.m[3][2];
+	result.w = x * matrix.m[0][3] + y * matrix.m[1][3] + z * matrix.m[2][3] + matrix.m[3][3];
+	result.u = u;
+	result.v = v;
+	return result;
+}
+
+
+//Function: MakePlane(const double* x, const double* y, const float* values)
+//Description: This method fits the plane through an attribute at the three corners of a triangle, in pixels.
+//Returns: SoftwarePlane = the plane, evaluated at pixel centers.
+static SoftwarePlane MakePlane(const double* x, const double* y, const float* values)
+{
+	double determinant = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	double dx = ((values[1] - values[0]) * (y[2] - y[0]) - (values[2] - values[0]) * (y[1] - y[0])) / determinant;
+	double dy = ((values[2] - values[0]) * (x[1] - x[0]) - (values[1] - values[0]) * (x[2] - x[0])) / determinant;
+
+	SoftwarePlane plane;
+	plane.c = (float)(values[0] - dx * x[0] - dy * y[0]);
+	plane.dx = (float)dx;
+	plane.dy = (float)dy;
+	return plane;
+}
+
+
+//Function: SampleTexture(const SoftwareTexture* texture, float u, float v, float* color)
+//Description: This method samples a texture bilinearly, clamping at the edges like the sampler the sprite batch leaves bound.
+//Returns: void.
+static void SampleTexture(const SoftwareTexture* texture, float u, float v, float* color)
+{
+	float x = u * texture->width - 0.5f;
+	float y = v * texture->height - 0.5f;
+	float left = floorf(x);
+	float top = floorf(y);
+	float fx = x - left;
+	float fy = y - top;
+
+	int x0 = (int)left;
+	int y0 = (int)top;
+	int x1 = x0 + 1;
+	int y1 = y0 + 1;
+	x0 = (x0 < 0) ? 0 : (x0 >= texture->width) ? texture->width - 1 : x0;
+	x1 = (x1 < 0) ? 0 : (x1 >= texture->width) ? texture->width - 1 : x1;
+	y0 = (y0 < 0) ? 0 : (y0 >= texture->height) ? texture->height - 1 : y0;
+	y1 = (y1 < 0) ? 0 : (y1 >= texture->height) ? texture->height - 1 : y1;
+
+	const unsigned char* p00 = texture->pixels + ((size_t)y0 * texture->width + x0) * 4;
+	const unsigned char* p01 = texture->pixels + ((size_t)y0 * texture->width + x1) * 4;
+	const unsigned char* p10 = texture->pixels + ((size_t)y1 * texture->width + x0) * 4;
+	const unsigned char* p11 = texture->pixels + ((size_t)y1 * texture->width + x1) * 4;
+
+	for (int c = 0; c < 4; c++)
+	{
+		float upper = p00[c] + (p01[c] - p00[c]) * fx;
+		float lower = p10[c] + (p11[c] - p10[c]) * fx;
+		color[c] = upper + (lower - upper) * fy;
+	}
+}
+
+
+//Function: Initialize(int screenWidth, int screenHeight)
+//Description: This method sizes the color buffer and the tile grid.
+//Returns: void.
+void SoftwareRenderer::Initialize(int screenWidth, int screenHeight)
+{
+	this->width = screenWidth;
+	this->height = screenHeight;
+	this->tilesX = (screenWidth + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+	this->tilesY = (screenHeight + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+
+	this->colorBuffer.assign((size_t)screenWidth * screenHeight * 4, 0);
+	this->tileBins.assign(this->tilesX * this->tilesY, std::vector<int>());
+	this->triangles.clear();
+}
+
+
+//Function: Clear(float red, float green, float blue)
+//Description: This method clears the color buffer like ClearRenderTargetView.
+//Returns: void.
+void SoftwareRenderer::Clear(float red, float green, float blue)
+{
+	unsigned char color[4] = { (unsigned char)(red * 255.0f + 0.5f), (unsigned char)(green * 255.0f + 0.5f), (unsigned char)(blue * 255.0f + 0.5f), 255 };
+
+	for (size_t i = 0; i < this->colorBuffer.size(); i += 4)
+	{
+		this->colorBuffer[i + 0] = color[0];
+		this->colorBuffer[i + 1] = color[1];
+		this->colorBuffer[i + 2] = color[2];
+		this->colorBuffer[i + 3] = color[3];
+	}
+}
+
+
+//Function: DrawSprite(const MeshData& quad, const SoftwareMatrix& viewProjection, const SoftwareTexture* texture, const float uvRect[4], float x, float y, float spriteWidth, float spriteHeight, int zOrder, float angle)
+//Description: This method queues a sprite, transformed the way SpriteVertexShader does it: the quad is rotated around its center,
+//scaled to the sprite size and moved into place, and its texture coordinates are mapped into the region it is drawn from.
+//Returns: void.
+void SoftwareRenderer::DrawSprite(const MeshData& quad, const SoftwareMatrix& viewProjection, const SoftwareTexture* texture, const float uvRect[4], float x, float y, float spriteWidth, float spriteHeight, int zOrder, float angle)
+{
+	float halfWidth = spriteWidth * 0.5f;
+	float halfHeight = spriteHeight * 0.5f;
+	float sinAngle = sinf(angle);
+	float cosAngle = cosf(angle);
+
+	this->clipVertices.resize(quad.vertexCount);
+	for (uint32_t i = 0; i < quad.vertexCount; i++)
+	{
+		const MeshVertex& vertex = quad.vertices[i];
+		float rotatedX = vertex.x * cosAngle - vertex.y * sinAngle;
+		float rotatedY = vertex.x * sinAngle + vertex.y * cosAngle;
+
+		this->clipVertices[i] = TransformVertex(viewProjection,
+			rotatedX * halfWidth + x + halfWidth, rotatedY * halfHeight + y + halfHeight, vertex.z + zOrder,
+			uvRect[0] + vertex.u * uvRect[2], uvRect[1] + vertex.v * uvRect[3]);
+	}
+
+	this->SubmitTriangles(quad, texture);
+}
+
+
+//Function: DrawMesh(const MeshData& mesh, const SoftwareMatrix& worldViewProjection, const SoftwareTexture* texture)
+//Description: This method queues a mesh, transformed the way PlanetVertexShader does it.
+//Returns: void.
+void SoftwareRenderer::DrawMesh(const MeshData& mesh, const SoftwareMatrix& worldViewProjection, const SoftwareTexture* texture)
+{
+	this->clipVertices.resize(mesh.vertexCount);
+	for (uint32_t i = 0; i < mesh.vertexCount; i++)
+	{
+		const MeshVertex& vertex = mesh.vertices[i];
+		this->clipVertices[i] = TransformVertex(worldViewProjection, vertex.x, vertex.y, vertex.z, vertex.u, vertex.v);
+	}
+
+	this->SubmitTriangles(mesh, texture);
+}
+
+
+//Function: SubmitTriangles(const MeshData& mesh, const SoftwareTexture* texture)
+//Description: This method queues the triangles of a mesh whose vertices have been transformed into clipVertices.
+//Returns: void.
+void SoftwareRenderer::SubmitTriangles(const MeshData& mesh, const SoftwareTexture* texture)
+{
+	if (mesh.indexCount)
+	{
+		for (uint32_t i = 0; i + 2 < mesh.indexCount; i += 3)
+		{
+			this->AddTriangle(this->clipVertices[mesh.indices[i]], this->clipVertices[mesh.indices[i + 1]], this->clipVertices[mesh.indices[i + 2]], texture);
+		}
+	}
+	else
+	{
+		for (uint32_t i = 0; i + 2 < mesh.vertexCount; i += 3)
+		{
+			this->AddTriangle(this->clipVertices[i], this->clipVertices[i + 1], this->clipVertices[i + 2], texture);
+		}
+	}
+}
+
+
+//Function: AddTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c, const SoftwareTexture* texture)
+//Description: This method sets up a triangle and adds it to the bins of the tiles it touches. Like the rasterizer state, triangles
+//that are counter clockwise on screen are culled. Nothing the game draws crosses the near or far plane, so triangles that do
+//are dropped instead of clipped, and so are triangles reaching past the guard band.
+//Returns: void.
+void SoftwareRenderer::AddTriangle(const ClipVertex& a, const ClipVertex& b, const ClipVertex& c, const SoftwareTexture* texture)
+{
+	const ClipVertex* vertices[3] = { &a, &b, &c };
+
+	SoftwareTriangle triangle;
+	double x[3];
+	double y[3];
+	float invW[3];
+	float uOverW[3];
+	float vOverW[3];
+
+	for (int i = 0; i < 3; i++)
+	{
+		const ClipVertex& vertex = *vertices[i];
+		if (!(vertex.w > 0.0f) || vertex.z < 0.0f || vertex.z > vertex.w)
+			return;
+
+		//Viewport transform, y goes down the screen
+		invW[i] = 1.0f / vertex.w;
+		float screenX = (vertex.x * invW[i] + 1.0f) * 0.5f * this->width;
+		float screenY = (1.0f - vertex.y * invW[i]) * 0.5f * this->height;
+		if (screenX < -SOFTWARE_GUARD_BAND || screenX > this->width + SOFTWARE_GUARD_BAND || screenY < -SOFTWARE_GUARD_BAND || screenY > this->height + SOFTWARE_GUARD_BAND)
+			return;
+
+		triangle.x[i] = (int32_t)lrintf(screenX * SUBPIXEL_SCALE);
+		triangle.y[i] = (int32_t)lrintf(screenY * SUBPIXEL_SCALE);
+		x[i] = (double)triangle.x[i] / SUBPIXEL_SCALE;
+		y[i] = (double)triangle.y[i] / SUBPIXEL_SCALE;
+		uOverW[i] = vertex.u * invW[i];
+		vOverW[i] = vertex.v * invW[i];
+	}
+
+	//Clockwise on screen is a positive area with y going down
+	int64_t area = (int64_t)(triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) - (int64_t)(triangle.y[1] - triangle.y[0]) * (triangle.x[2] - triangle.x[0]);
+	if (area <= 0)
+		return;
+
+	//Pixels whose centers can be inside, clamped to the screen
+	int32_t minX = triangle.x[0];
+	int32_t maxX = triangle.x[0];
+	int32_t minY = triangle.y[0];
+	int32_t maxY = triangle.y[0];
+	for (int i = 1; i < 3; i++)
+	{
+		minX = (triangle.x[i] < minX) ? triangle.x[i] : minX;
+		maxX = (triangle.x[i] > maxX) ? triangle.x[i] : maxX;
+		minY = (triangle.y[i] < minY) ? triangle.y[i] : minY;
+		maxY = (triangle.y[i] > maxY) ? triangle.y[i] : maxY;
+	}
+
+	triangle.minX = (int)floorf((float)(minX - SUBPIXEL_SCALE / 2) / SUBPIXEL_SCALE);
+	triangle.maxX = (int)ceilf((float)(maxX - SUBPIXEL_SCALE / 2) / SUBPIXEL_SCALE);
+	triangle.minY = (int)floorf((float)(minY - SUBPIXEL_SCALE / 2) / SUBPIXEL_SCALE);
+	triangle.maxY = (int)ceilf((float)(maxY - SUBPIXEL_SCALE / 2) / SUBPIXEL_SCALE);
+	triangle.minX = (triangle.minX < 0) ? 0 : triangle.minX;
+	triangle.minY = (triangle.minY < 0) ? 0 : triangle.minY;
+	triangle.maxX = (triangle.maxX >= this->width) ? this->width - 1 : triangle.maxX;
+	triangle.maxY = (triangle.maxY >= this->height) ? this->height - 1 : triangle.maxY;
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+		return;
+
+	triangle.invW = MakePlane(x, y, invW);
+	triangle.uOverW = MakePlane(x, y, uOverW);
+	triangle.vOverW = MakePlane(x, y, vOverW);
+	triangle.texture = texture;
+
+	int index = (int)this->triangles.size();
+	this->triangles.push_back(triangle);
+
+	for (int tileY = triangle.minY / SOFTWARE_TILE_SIZE; tileY <= triangle.maxY / SOFTWARE_TILE_SIZE; tileY++)
+	{
+		for (int tileX = triangle.minX / SOFTWARE_TILE_SIZE; tileX <= triangle.maxX / SOFTWARE_TILE_SIZE; tileX++)
+		{
+			this->tileBins[tileY * this->tilesX + tileX].push_back(index);
+		}
+	}
+}
+
+
+//Function: Flush()
+//Description: This method rasterizes every queued triangle, one job per tile. A tile draws its triangles in the order they were
+//queued, so blending comes out the same as drawing them one after another.
+//Returns: void.
+void SoftwareRenderer::Flush()
+{
+	if (this->triangles.empty())
+		return;
+
+	JobQueue jobs;
+	for (int tile = 0; tile < (int)this->tileBins.size(); tile++)
+	{
+		if (!this->tileBins[tile].empty())
+		{
+			jobs.Add([this, tile]() { this->RasterizeTile(tile); });
+		}
+	}
+	jobs.Run();
+
+	for (size_t i = 0; i < this->tileBins.size(); i++)
+	{
+		this->tileBins[i].clear();
+	}
+	this->triangles.clear();
+}
+
+
+//Function: RasterizeTile(int tile)
+//Description: This method draws the triangles binned to a tile. An edge that is entirely inside or outside the tile is settled
+//once for the whole tile. The edges that cross it are stepped 4 pixels at a time in 32 bit integers, which is exact since they
+//stay small inside one tile. Pixels on a shared edge belong to one triangle only, by the top-left rule, so nothing is blended twice.
+//Returns: void.
+void SoftwareRenderer::RasterizeTile(int tile)
+{
+	int tileLeft = (tile % this->tilesX) * SOFTWARE_TILE_SIZE;
+	int tileTop = (tile / this->tilesX) * SOFTWARE_TILE_SIZE;
+	int tileRight = (tileLeft + SOFTWARE_TILE_SIZE < this->width) ? tileLeft + SOFTWARE_TILE_SIZE - 1 : this->width - 1;
+	int tileBottom = (tileTop + SOFTWARE_TILE_SIZE < this->height) ? tileTop + SOFTWARE_TILE_SIZE - 1 : this->height - 1;
+
+	const std::vector<int>& bin = this->tileBins[tile];
+	for (size_t binIndex = 0; binIndex < bin.size(); binIndex++)
+	{
+		const SoftwareTriangle& triangle = this->triangles[bin[binIndex]];
+
+		int left = (triangle.minX > tileLeft) ? triangle.minX : tileLeft;
+		int right = (triangle.maxX < tileRight) ? triangle.maxX : tileRight;
+		int top = (triangle.minY > tileTop) ? triangle.minY : tileTop;
+		int bottom = (triangle.maxY < tileBottom) ? triangle.maxY : tileBottom;
+
+		//Edge k runs from vertex k + 1 to vertex k + 2, and is positive inside the triangle. Edges that are not top or left
+		//edges are biased by one so a sample exactly on them is outside.
+		int32_t rowStart[3];
+		int32_t stepX[3];
+		int32_t stepY[3];
+		bool culled = false;
+		for (int k = 0; k < 3 && !culled; k++)
+		{
+			int a = (k + 1) % 3;
+			int b = (k + 2) % 3;
+			int64_t dx = (int64_t)triangle.x[b] - triangle.x[a];
+			int64_t dy = (int64_t)triangle.y[b] - triangle.y[a];
+			int64_t bias = (dy < 0 || (dy == 0 && dx > 0)) ? 0 : -1;
+
+			//The edge function at the center of the top left pixel, and how it changes from pixel to pixel
+			int64_t sampleX = (int64_t)left * SUBPIXEL_SCALE + SUBPIXEL_SCALE / 2;
+			int64_t sampleY = (int64_t)top * SUBPIXEL_SCALE + SUBPIXEL_SCALE / 2;
+			int64_t value = dx * (sampleY - triangle.y[a]) - dy * (sampleX - triangle.x[a]) + bias;
+			int64_t changeX = -dy * SUBPIXEL_SCALE;
+			int64_t changeY = dx * SUBPIXEL_SCALE;
+
+			//Linear, so the extremes over the region are at its corners
+			int64_t spanX = changeX * (right - left);
+			int64_t spanY = changeY * (bottom - top);
+			int64_t minValue = value + ((spanX < 0) ? spanX : 0) + ((spanY < 0) ? spanY : 0);
+			int64_t maxValue = value + ((spanX > 0) ? spanX : 0) + ((spanY > 0) ? spanY : 0);
+
+			if (maxValue < 0)
+			{
+				culled = true;
+			}
+			else if (minValue >= 0)
+			{
+				//Inside everywhere in the region, the edge is left out of the test
+				rowStart[k] = 0;
+				stepX[k] = 0;
+				stepY[k] = 0;
+			}
+			else
+			{
+				rowStart[k] = (int32_t)value;
+				stepX[k] = (int32_t)changeX;
+				stepY[k] = (int32_t)changeY;
+			}
+		}
+
+		if (culled)
+			continue;
+
+#if SOFTWARE_SSE2
+		//The edge values of 4 neighbouring pixels, and how far they move for the next 4
+		__m128i laneSteps[3];
+		__m128i blockSteps[3];
+		for (int k = 0; k < 3; k++)
+		{
+			laneSteps[k] = _mm_set_epi32(stepX[k] * 3, stepX[k] * 2, stepX[k], 0);
+			blockSteps[k] = _mm_set1_epi32(stepX[k] * 4);
+		}
+#endif
+
+		for (int y = top; y <= bottom; y++)
+		{
+			unsigned char* row = &this->colorBuffer[((size_t)y * this->width) * 4];
+			float centerY = y + 0.5f;
+
+#if SOFTWARE_SSE2
+			__m128i values[3];
+			for (int k = 0; k < 3; k++)
+			{
+				values[k] = _mm_add_epi32(_mm_set1_epi32(rowStart[k]), laneSteps[k]);
+			}
+#else
+			int32_t values[3] = { rowStart[0], rowStart[1], rowStart[2] };
+#endif
+
+			for (int x = left; x <= right; x += 4)
+			{
+				//A pixel is covered when none of its edge values is negative
+				int covered = 0;
+
+#if SOFTWARE_SSE2
+				__m128i outside = _mm_or_si128(values[0], _mm_or_si128(values[1], values[2]));
+				covered = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+				for (int k = 0; k < 3; k++)
+				{
+					values[k] = _mm_add_epi32(values[k], blockSteps[k]);
+				}
+#else
+				for (int lane = 0; lane < 4; lane++)
+				{
+					int32_t outside = (values[0] + stepX[0] * lane) | (values[1] + stepX[1] * lane) | (values[2] + stepX[2] * lane);
+					if (outside >= 0)
+						covered |= 1 << lane;
+				}
+				for (int k = 0; k < 3; k++)
+				{
+					values[k] += stepX[k] * 4;
+				}
+#endif
+
+				//Lanes past the right edge of the region
+				if (right - x < 3)
+					covered &= (1 << (right - x + 1)) - 1;
+
+				while (covered)
+				{
+					int lane = 0;
+					while (!(covered & (1 << lane)))
+					{
+						lane++;
+					}
+					covered &= ~(1 << lane);
+
+					float centerX = x + lane + 0.5f;
+					float invW = triangle.invW.c + triangle.invW.dx * centerX + triangle.invW.dy * centerY;
+					float u = (triangle.uOverW.c + triangle.uOverW.dx * centerX + triangle.uOverW.dy * centerY) / invW;
+					float v = (triangle.vOverW.c + triangle.vOverW.dx * centerX + triangle.vOverW.dy * centerY) / invW;
+
+					float color[4];
+					SampleTexture(triangle.texture, u, v, color);
+
+					//SRC_ALPHA, INV_SRC_ALPHA like the blend state. The swap chain ignores alpha, so it is kept opaque.
+					float alpha = color[3] * (1.0f / 255.0f);
+					unsigned char* pixel = row + (size_t)(x + lane) * 4;
+					for (int c = 0; c < 3; c++)
+					{
+						pixel[c] = (unsigned char)(color[c] * alpha + pixel[c] * (1.0f - alpha) + 0.5f);
+					}
+				}
+			}
+
+			for (int k = 0; k < 3; k++)
+			{
+				rowStart[k] += stepY[k];
+			}
+		}
+	}
+}
+
+
+//Function: WriteFrame(const char* fileName)
+//Description: This method writes the color buffer out as a TGA file.
+//Returns: bool = whether the file was written.
+bool SoftwareRenderer::WriteFrame(const char* fileName)
+{
+	return WriteTGA(fileName, this->colorBuffer.data(), this->width, this->height);
+}
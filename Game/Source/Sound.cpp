@@ -1,157 +1,228 @@
 /*
 File Name:		Sound.cpp
-Description:	This file holds the functions for loading a wav file from file and playing a wav file. The only type of wav file supported
-				by this project are 44.1kHz 16bit 2channel wav file formats.
+Description:	This file holds the functions for reading a wav file and converting it to the mix format of the engine. Any PCM or
+				float wav file is supported, the conversion to 44.1kHz 16bit 2channel happens here, once, when it is packed.
 Programmer:		Kyle Jensen
 Date:			April 14, 2017
 */
 
-#include "..\Include\Sound.h"
+#include "../Include/Sound.h"
+#include "../Include/AudioConvert.h"
+#include <string.h>
 
+//The rate of the mix format, every sound is resampled to it
+#define WAVE_MIX_RATE 44100
 
-//Function: LoadWaveFile(char* fileName, IDirectSound8* directSound, SoundHandle* secondaryBuffer)
-//Description: This method loads a wav file into the secondary buffer provided.
-//Returns: bool : whether the wav file was loaded or not.
-bool LoadWaveFile(char* fileName, IDirectSound8* directSound, SoundHandle* secondaryBuffer)
+
+//Function: ReadLittle16(const unsigned char* bytes)
+//Description: This method reads a little endian 16 bit integer from bytes that may not be aligned.
+//Returns: uint16_t = the integer.
+static uint16_t ReadLittle16(const unsigned char* bytes)
 {
-	FILE* file;
-	WaveHeaderType waveFileHeader;
-	WAVEFORMATEX waveFormat;
-	DSBUFFERDESC bufferDesc;
-	HRESULT result;
-	IDirectSoundBuffer* tempBuffer;
-
-	//Open the wave file in binary read mode
-	if (fopen_s(&file, fileName, "rb") != 0)
-		return false;
+	return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
 
-	//Read the wave file header
-	unsigned int count = fread(&waveFileHeader, sizeof(waveFileHeader), 1, file);
-	if (count != 1)
-		return false;
-	
-	//Validate wave header before loading
-	if ((waveFileHeader.chunkId[0] != 'R') || (waveFileHeader.chunkId[1] != 'I') ||
-		(waveFileHeader.chunkId[2] != 'F') || (waveFileHeader.chunkId[3] != 'F'))
-		return false;
 
-	if ((waveFileHeader.format[0] != 'W') || (waveFileHeader.format[1] != 'A') ||
-		(waveFileHeader.format[2] != 'V') || (waveFileHeader.format[3] != 'E'))
-		return false;
+//Function: ReadLittle32(const unsigned char* bytes)
+//Description: This method reads a little endian 32 bit integer from bytes that may not be aligned.
+//Returns: uint32_t = the integer.
+static uint32_t ReadLittle32(const unsigned char* bytes)
+{
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
 
-	if ((waveFileHeader.subChunkId[0] != 'f') || (waveFileHeader.subChunkId[1] != 'm') ||
-		(waveFileHeader.subChunkId[2] != 't') || (waveFileHeader.subChunkId[3] != ' '))
-		return false;
 
-	if (waveFileHeader.audioFormat != WAVE_FORMAT_PCM)
+//Function: NextRiffChunk(const unsigned char** cursor, const unsigned char* end, RiffChunk* chunk)
+//Description: This method reads the chunk at the cursor and moves the cursor past it, and past the pad byte that follows a
+//chunk of odd size. A chunk that claims to run past the end is cut short at the end, as some writers leave the size unset.
+//Returns: bool = whether there was another chunk.
+bool NextRiffChunk(const unsigned char** cursor, const unsigned char* end, RiffChunk* chunk)
+{
+	const unsigned char* start = *cursor;
+	if (end - start < 8)
 		return false;
 
-	if (waveFileHeader.numChannels != 2)
-		return false;
+	memcpy(chunk->id, start, 4);
+	chunk->size = ReadLittle32(start + 4);
+	chunk->data = start + 8;
 
-	if (waveFileHeader.sampleRate != 44100)
-		return false;
+	size_t available = (size_t)(end - chunk->data);
+	if (chunk->size > available)
+	{
+		chunk->size = (uint32_t)available;
+	}
 
-	if (waveFileHeader.bitsPerSample != 16)
-		return false;
+	size_t advance = (size_t)chunk->size + (chunk->size & 1);
+	*cursor = (advance < available) ? chunk->data + advance : end;
+	return true;
+}
 
-	if ((waveFileHeader.dataChunkId[0] != 'd') || (waveFileHeader.dataChunkId[1] != 'a') ||
-		(waveFileHeader.dataChunkId[2] != 't') || (waveFileHeader.dataChunkId[3] != 'a'))
-		return false;
 
-	//Set the wave format of secondary buffer.
-	waveFormat.wFormatTag = WAVE_FORMAT_PCM;
-	waveFormat.nSamplesPerSec = 44100;
-	waveFormat.wBitsPerSample = 16;
-	waveFormat.nChannels = 2;
-	waveFormat.nBlockAlign = (waveFormat.wBitsPerSample / 8) * waveFormat.nChannels;
-	waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign;
-	waveFormat.cbSize = 0;
-
-	//Set the buffer description of the secondary sound buffer
-	bufferDesc.dwSize = sizeof(DSBUFFERDESC);
-	bufferDesc.dwFlags = DSBCAPS_CTRLVOLUME;
-	bufferDesc.dwBufferBytes = waveFileHeader.dataSize;
-	bufferDesc.dwReserved = 0;
-	bufferDesc.lpwfxFormat = &waveFormat;
-	bufferDesc.guid3DAlgorithm = GUID_NULL;
-
-	//Create a temporary sound buffer with the specific buffer settings
-	result = directSound->CreateSoundBuffer(&bufferDesc, &tempBuffer, NULL);
-	if (FAILED(result))
+//Function: ReadWaveFormat(const RiffChunk& chunk, WaveFormat* format)
+//Description: This method reads a fmt chunk and checks it is one we can convert: PCM of 8 to 32 bits or float of 32 or 64,
+//plain or extensible, with whole bytes per sample.
+//Returns: bool = whether the format is supported.
+bool ReadWaveFormat(const RiffChunk& chunk, WaveFormat* format)
+{
+	if (chunk.size < 16)
 		return false;
 
-	//Test the buffer format against the direct sound 8 interface and create the secondary buffer
-	result = tempBuffer->QueryInterface(IID_IDirectSoundBuffer8, (void**)&*secondaryBuffer);
-	if (FAILED(result))
-		return false;
+	format->formatTag = ReadLittle16(chunk.data);
+	format->channels = ReadLittle16(chunk.data + 2);
+	format->sampleRate = ReadLittle32(chunk.data + 4);
+	format->blockAlign = ReadLittle16(chunk.data + 12);
+	format->bitsPerSample = ReadLittle16(chunk.data + 14);
+	format->channelMask = 0;
 
-	//Release the temporary buffer
-	tempBuffer->Release();
-	tempBuffer = NULL;
+	//Extensible files give the speaker layout, and the real format tag as the start of a GUID
+	if (format->formatTag == WAVE_TAG_EXTENSIBLE)
+	{
+		if (chunk.size < 40)
+			return false;
 
-	//Move to the beginning of the wave data. (After header)
-	fseek(file, sizeof(WaveHeaderType), SEEK_SET);
+		format->channelMask = ReadLittle32(chunk.data + 20);
+		format->formatTag = ReadLittle16(chunk.data + 24);
+	}
 
-	//Create a temporary buffer to hold the wave file data
-	unsigned char* waveData = new unsigned char[waveFileHeader.dataSize];
-	if (!waveData)
+	if (!format->channels || !format->sampleRate)
 		return false;
 
-	//Read in the wave file data into the newly created buffer
-	count = fread(waveData, 1, waveFileHeader.dataSize, file);
-	if (count != waveFileHeader.dataSize)
+	int bytesPerSample = format->bitsPerSample / 8;
+	if (format->bitsPerSample % 8 || format->blockAlign != bytesPerSample * format->channels)
 		return false;
 
-	if (fclose(file) != 0)
-	{
-		return false;
-	}
+	if (format->formatTag == WAVE_TAG_PCM)
+		return bytesPerSample >= 1 && bytesPerSample <= 4;
 
-	// Lock the secondary buffer to write wave data into it.
-	unsigned char* bufferPtr;
-	unsigned long bufferSize;
-	result = (*secondaryBuffer)->Lock(0, waveFileHeader.dataSize, (void**)&bufferPtr, (DWORD*)&bufferSize, NULL, 0, 0);
-	if (FAILED(result))
-		return false;
+	if (format->formatTag == WAVE_TAG_FLOAT)
+		return bytesPerSample == 4 || bytesPerSample == 8;
 
-	//Copy the wave data into the buffer
-	memcpy(bufferPtr, waveData, waveFileHeader.dataSize);
+	return false;
+}
 
-	//Unlock the secondary buffer after the data has been written to it
-	result = (*secondaryBuffer)->Unlock((void*)bufferPtr, bufferSize, NULL, 0);
-	if (FAILED(result))
-		return false;
 
-	//Release the wave data since it was copied into the secondary buffer
-	delete[] waveData;
-	waveData = 0;
+//Function: DecodeSamples(const WaveFormat& format, const unsigned char* data, uint32_t frameCount, std::vector<float>* samples)
+//Description: This method turns the samples of a data chunk into interleaved floats, full scale at -1 and 1. 8 bit PCM is
+//unsigned, wider PCM is signed.
+//Returns: void.
+static void DecodeSamples(const WaveFormat& format, const unsigned char* data, uint32_t frameCount, std::vector<float>* samples)
+{
+	size_t count = (size_t)frameCount * format.channels;
+	samples->resize(count);
+	float* output = samples->data();
 
-	return true;
+	int bytesPerSample = format.bitsPerSample / 8;
+	if (format.formatTag == WAVE_TAG_FLOAT)
+	{
+		for (size_t i = 0; i < count; i++, data += bytesPerSample)
+		{
+			if (bytesPerSample == 4)
+			{
+				float sample;
+				memcpy(&sample, data, sizeof(sample));
+				output[i] = sample;
+			}
+			else
+			{
+				double sample;
+				memcpy(&sample, data, sizeof(sample));
+				output[i] = (float)sample;
+			}
+		}
+		return;
+	}
+
+	switch (bytesPerSample)
+	{
+	case 1:
+		for (size_t i = 0; i < count; i++)
+			output[i] = ((int)data[i] - 128) * (1.0f / 128.0f);
+		break;
+	case 2:
+		for (size_t i = 0; i < count; i++)
+			output[i] = (int16_t)ReadLittle16(data + i * 2) * (1.0f / 32768.0f);
+		break;
+	case 3:
+		for (size_t i = 0; i < count; i++)
+		{
+			//Shift the 24 bits to the top, so the sign comes with them
+			const unsigned char* bytes = data + i * 3;
+			int32_t sample = (int32_t)(((uint32_t)bytes[0] << 8) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 24));
+			output[i] = (float)(sample / 2147483648.0);
+		}
+		break;
+	case 4:
+		for (size_t i = 0; i < count; i++)
+			output[i] = (float)((int32_t)ReadLittle32(data + i * 4) / 2147483648.0);
+		break;
+	}
 }
 
 
-//Function: PlayWaveFile(SoundHandle secondaryBuffer, long volume, bool looping)
-//Description: This method sets the position of the secondary buffer to the start of the song, sets the volume, and plays.
-//Returns: bool : whether the wav file was loaded or not.
-bool PlayWaveFile(SoundHandle secondaryBuffer, long volume, bool looping)
+//Function: ReadWaveFile(const char* fileName, WaveFile* wave)
+//Description: This method reads a wav file, walking its chunks for fmt and data and skipping anything else, such as LIST and
+//fact. The samples are mixed down to stereo, resampled to 44.1kHz and stored as 16 bits, a 44.1kHz 16bit stereo file comes
+//through bit for bit.
+//Returns: bool : whether the wav file is one we can convert.
+bool ReadWaveFile(const char* fileName, WaveFile* wave)
 {
-	HRESULT result;
-
-	result = secondaryBuffer->SetCurrentPosition(0);
-	if (FAILED(result))
+	MappedFile file;
+	if (!file.Open(fileName))
 		return false;
 
-	result = secondaryBuffer->SetVolume(volume);
-	if (FAILED(result))
+	const unsigned char* cursor = file.data;
+	const unsigned char* end = file.data + file.size;
+
+	RiffChunk riff;
+	if (!NextRiffChunk(&cursor, end, &riff) || memcmp(riff.id, "RIFF", 4) || riff.size < 4 || memcmp(riff.data, "WAVE", 4))
 		return false;
 
-	//If we want to loop, set the DSPPLAY_LOOPING flag
-	DWORD flag = (looping) ? DSBPLAY_LOOPING : 0;
-	result = secondaryBuffer->Play(0, 0, flag);
-	if (FAILED(result))
+	//The chunks of the file are inside the RIFF chunk, after the WAVE form type
+	cursor = riff.data + 4;
+	end = riff.data + riff.size;
+
+	bool haveFormat = false;
+	RiffChunk data = {};
+	RiffChunk chunk;
+	while (NextRiffChunk(&cursor, end, &chunk))
+	{
+		if (!memcmp(chunk.id, "fmt ", 4))
+		{
+			if (!ReadWaveFormat(chunk, &wave->source))
+				return false;
+			haveFormat = true;
+		}
+		else if (!memcmp(chunk.id, "data", 4))
+		{
+			data = chunk;
+		}
+	}
+
+	if (!haveFormat || !data.data)
 		return false;
 
+	const WaveFormat& source = wave->source;
+	uint32_t frameCount = data.size / source.blockAlign;
+
+	std::vector<float> samples;
+	DecodeSamples(source, data.data, frameCount, &samples);
+
+	std::vector<float> left;
+	std::vector<float> right;
+	MixToStereo(samples, source.channels, source.channelMask, &left, &right);
+	samples.clear();
+	samples.shrink_to_fit();
+
+	if (source.sampleRate != WAVE_MIX_RATE)
+	{
+		std::vector<float> resampled;
+		Resample(left, source.sampleRate, WAVE_MIX_RATE, &resampled);
+		left.swap(resampled);
+		Resample(right, source.sampleRate, WAVE_MIX_RATE, &resampled);
+		right.swap(resampled);
+	}
+
+	QuantizeStereo(left, right, &wave->samples);
+	wave->frameCount = (uint32_t)(wave->samples.size() / 2);
 	return true;
 }
-
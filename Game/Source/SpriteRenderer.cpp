@@ -0,0 +1,136 @@
+/*
+File Name:		SpriteRenderer.cpp
+Description:	This file holds the definition of the batched sprite renderer and the methods to collect and draw sprites.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/SpriteRenderer.h"
+#include <algorithm>
+
+
+//Function: Initialize(ID3D11Device* device)
+//Description: This method creates the dynamic instance buffer. It is only created once, so reinitializing the game reuses it.
+//Returns: bool = whether the buffer exists.
+bool SpriteRenderer::Initialize(ID3D11Device* device)
+{
+	if (this->instanceBuffer)
+		return true;
+
+	D3D11_BUFFER_DESC instanceBufferDesc = {};
+	instanceBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	instanceBufferDesc.ByteWidth = sizeof(SpriteInstance) * MAX_SPRITE_INSTANCES;
+	instanceBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	instanceBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	HRESULT result = device->CreateBuffer(&instanceBufferDesc, NULL, &this->instanceBuffer);
+	this->bufferUsed = MAX_SPRITE_INSTANCES;
+
+	return SUCCEEDED(result);
+}
+
+
+//Function: Push(const SpriteRegion& region, float x, float y, float width, float height, int zOrder, float angle)
+//Description: This method queues a sprite for the next flush. Sprites in the same atlas share a texture and batch together.
+//Returns: void.
+void SpriteRenderer::Push(const SpriteRegion& region, float x, float y, float width, float height, int zOrder, float angle)
+{
+	SpriteInstance instance;
+	instance.rect = XMFLOAT4(x, y, width, height);
+	instance.depthAngle = XMFLOAT2((float)zOrder, angle);
+	instance.uvRect = XMFLOAT4(region.u, region.v, region.width, region.height);
+
+	this->instances.push_back(instance);
+	this->textures.push_back(region.texture);
+}
+
+
+//Function: Flush(RenderStateCache* renderState, DXBuffer* quadVertexBuffer, RenderStats* stats)
+//Description: This method draws the queued sprites with the orthographic matrices that are currently bound. They are sorted
+//back to front, then by texture, so every run of one texture is a single DrawInstanced. The instances are appended to the
+//buffer without stalling on earlier flushes, and the buffer is only discarded when it fills up.
+//The sprite shader and input layout are left bound, binds go through the render state cache so a flush right after
+//another one only binds the textures that changed.
+//Returns: void.
+void SpriteRenderer::Flush(RenderStateCache* renderState, DXBuffer* quadVertexBuffer, RenderStats* stats)
+{
+	ID3D11DeviceContext* deviceContext = renderState->deviceContext;
+
+	int count = (int)this->instances.size();
+	if (count == 0 || !this->instanceBuffer)
+		return;
+
+	//Order by depth, far sprites first, then group the textures at the same depth. The sort is stable so sprites that share
+	//a depth and a texture keep the order they were pushed in.
+	this->order.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		this->order[i] = i;
+	}
+
+	std::vector<SpriteInstance>& instances = this->instances;
+	std::vector<TextureHandle>& textures = this->textures;
+	std::stable_sort(this->order.begin(), this->order.end(), [&](int a, int b)
+	{
+		if (instances[a].depthAngle.x != instances[b].depthAngle.x)
+			return instances[a].depthAngle.x > instances[b].depthAngle.x;
+		return textures[a] < textures[b];
+	});
+
+	this->sorted.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		this->sorted[i] = instances[this->order[i]];
+	}
+
+	ID3D11Buffer* buffers[2] = { quadVertexBuffer->data, this->instanceBuffer };
+	UINT strides[2] = { sizeof(VertexType), sizeof(SpriteInstance) };
+	renderState->SetVertexBuffers(2, buffers, strides);
+	renderState->SetIndexBuffer(quadVertexBuffer->indices);
+	renderState->SetInputLayout(this->layout);
+	renderState->SetVertexShader(this->vertexShader);
+
+	for (int first = 0; first < count;)
+	{
+		//Append to the buffer, discarding it only when this pass does not fit
+		int passCount = (count - first < MAX_SPRITE_INSTANCES) ? count - first : MAX_SPRITE_INSTANCES;
+		D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+		if (this->bufferUsed + passCount > MAX_SPRITE_INSTANCES)
+		{
+			mapType = D3D11_MAP_WRITE_DISCARD;
+			this->bufferUsed = 0;
+		}
+
+		D3D11_MAPPED_SUBRESOURCE mappedResource = {};
+		if (FAILED(deviceContext->Map(this->instanceBuffer, 0, mapType, 0, &mappedResource)))
+			break;
+		stats->mapCalls++;
+
+		SpriteInstance* bufferInstances = (SpriteInstance*)mappedResource.pData + this->bufferUsed;
+		memcpy(bufferInstances, &this->sorted[first], passCount * sizeof(SpriteInstance));
+		deviceContext->Unmap(this->instanceBuffer, 0);
+
+		//Draw every run of the same texture with one call
+		for (int runStart = 0; runStart < passCount;)
+		{
+			TextureHandle texture = textures[this->order[first + runStart]];
+			int runEnd = runStart + 1;
+			while (runEnd < passCount && textures[this->order[first + runEnd]] == texture)
+			{
+				runEnd++;
+			}
+
+			renderState->SetPSResource(0, texture);
+			quadVertexBuffer->DrawInstanced(deviceContext, runEnd - runStart, this->bufferUsed + runStart);
+			stats->drawCalls++;
+
+			runStart = runEnd;
+		}
+
+		this->bufferUsed += passCount;
+		first += passCount;
+	}
+
+	this->instances.clear();
+	this->textures.clear();
+}
@@ -0,0 +1,445 @@
+/*
+File Name:		TGA.cpp
+Description:	This file holds the TGA decoder. Every row is converted straight from the file into its final place in the caller's
+				buffer, so the vertical flip and the BGRA to RGBA swizzle happen in the same pass. On CPUs with SSSE3 the swizzle
+				converts 4 pixels at a time with pshufb, otherwise a scalar loop is used.
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include "../Include/TGA.h"
+#include "../Include/MappedFile.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define TGA_X86 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define TGA_TARGET_SSSE3
+	#else
+		#define TGA_TARGET_SSSE3 __attribute__((target("ssse3")))
+	#endif
+#else
+	#define TGA_X86 0
+#endif
+
+//Images bigger than this on either side are rejected rather than risking a huge allocation
+#define TGA_MAX_DIMENSION 16384
+
+typedef void ConvertFunction(const unsigned char* source, unsigned char* destination, int count);
+
+static ConvertFunction* convertBGRA = 0;
+static ConvertFunction* convertBGR = 0;
+
+
+//Function: ReadUInt16(const unsigned char* data)
+//Description: This method reads a little endian 16 bit value from the header.
+//Returns: int = the value.
+static int ReadUInt16(const unsigned char* data)
+{
+	return data[0] | (data[1] << 8);
+}
+
+
+//Function: ConvertBGRAScalar(const unsigned char* source, unsigned char* destination, int count)
+//Description: This method converts BGRA pixels to RGBA one at a time.
+//Returns: void.
+static void ConvertBGRAScalar(const unsigned char* source, unsigned char* destination, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		destination[0] = source[2];
+		destination[1] = source[1];
+		destination[2] = source[0];
+		destination[3] = source[3];
+		source += 4;
+		destination += 4;
+	}
+}
+
+
+//Function: ConvertBGRScalar(const unsigned char* source, unsigned char* destination, int count)
+//Description: This method converts BGR pixels to opaque RGBA one at a time.
+//Returns: void.
+static void ConvertBGRScalar(const unsigned char* source, unsigned char* destination, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		destination[0] = source[2];
+		destination[1] = source[1];
+		destination[2] = source[0];
+		destination[3] = 255;
+		source += 3;
+		destination += 4;
+	}
+}
+
+
+//Function: ConvertGray(const unsigned char* source, unsigned char* destination, int count)
+//Description: This method converts 8 bit grayscale pixels to opaque RGBA.
+//Returns: void.
+static void ConvertGray(const unsigned char* source, unsigned char* destination, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		destination[0] = source[i];
+		destination[1] = source[i];
+		destination[2] = source[i];
+		destination[3] = 255;
+		destination += 4;
+	}
+}
+
+
+#if TGA_X86
+
+//Function: ConvertBGRASSSE3(const unsigned char* source, unsigned char* destination, int count)
+//Description: This method converts BGRA pixels to RGBA 4 at a time by swapping the red and blue bytes with a shuffle.
+//Returns: void.
+TGA_TARGET_SSSE3 static void ConvertBGRASSSE3(const unsigned char* source, unsigned char* destination, int count)
+{
+	const __m128i swizzle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i bgra = _mm_loadu_si128((const __m128i*)(source + i * 4));
+		_mm_storeu_si128((__m128i*)(destination + i * 4), _mm_shuffle_epi8(bgra, swizzle));
+	}
+
+	ConvertBGRAScalar(source + i * 4, destination + i * 4, count - i);
+}
+
+
+//Function: ConvertBGRSSSE3(const unsigned char* source, unsigned char* destination, int count)
+//Description: This method converts BGR pixels to opaque RGBA 4 at a time. The shuffle spreads 12 bytes over 16 and the alpha
+//bytes are set afterwards. Every load reads 16 bytes, so the last pixels that would read past the row are done one at a time.
+//Returns: void.
+TGA_TARGET_SSSE3 static void ConvertBGRSSSE3(const unsigned char* source, unsigned char* destination, int count)
+{
+	const __m128i swizzle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+	const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+
+	int i = 0;
+	for (; i + 6 <= count; i += 4)
+	{
+		__m128i bgr = _mm_loadu_si128((const __m128i*)(source + i * 3));
+		_mm_storeu_si128((__m128i*)(destination + i * 4), _mm_or_si128(_mm_shuffle_epi8(bgr, swizzle), alpha));
+	}
+
+	ConvertBGRScalar(source + i * 3, destination + i * 4, count - i);
+}
+
+#endif
+
+
+//Function: SelectConvertersOnce()
+//Description: This method picks the converters the first time it is called, unless they were forced already. Images are decoded
+//on several threads at once, the static makes sure only one of them picks the converters.
+//Returns: void.
+static void SelectConvertersOnce()
+{
+	static bool convertersSelected = (convertBGRA || (SelectTGAConverter(), true));
+	(void)convertersSelected;
+}
+
+
+//Function: ReadTGAInfo(const unsigned char* data, size_t size, TGAInfo* info)
+//Description: This method reads the header of a TGA file in memory and checks that the decoder supports the image.
+//Returns: bool = whether the image can be decoded.
+bool ReadTGAInfo(const unsigned char* data, size_t size, TGAInfo* info)
+{
+	if (size < TGA_HEADER_SIZE)
+		return false;
+
+	int idLength = data[0];
+	int colorMapType = data[1];
+	int colorMapEntryBits = data[7];
+	int pixelBits = data[16];
+	int descriptor = data[17];
+
+	info->imageType = data[2];
+	info->colorMapFirst = ReadUInt16(data + 3);
+	info->colorMapLength = ReadUInt16(data + 5);
+	info->colorMapBytes = colorMapEntryBits / 8;
+	info->width = ReadUInt16(data + 12);
+	info->height = ReadUInt16(data + 14);
+	info->bytesPerPixel = pixelBits / 8;
+	info->topOrigin = (descriptor & 0x20) != 0;
+	info->rightOrigin = (descriptor & 0x10) != 0;
+
+	//The color map follows the image id, the pixels follow the color map, even when an image does not use it
+	info->colorMapOffset = TGA_HEADER_SIZE + idLength;
+	info->pixelOffset = info->colorMapOffset;
+	if (colorMapType == 1)
+	{
+		info->pixelOffset += (size_t)info->colorMapLength * ((colorMapEntryBits + 7) / 8);
+	}
+
+	if (info->width == 0 || info->height == 0 || info->width > TGA_MAX_DIMENSION || info->height > TGA_MAX_DIMENSION)
+		return false;
+	if (info->pixelOffset > size)
+		return false;
+
+	switch (info->imageType)
+	{
+	case TGATrueColor:
+	case TGATrueColorRLE:
+		return pixelBits == 24 || pixelBits == 32;
+	case TGAGrayscale:
+	case TGAGrayscaleRLE:
+		return pixelBits == 8;
+	case TGAColorMapped:
+	case TGAColorMappedRLE:
+		return colorMapType == 1 && pixelBits == 8 && (colorMapEntryBits == 24 || colorMapEntryBits == 32);
+	default:
+		return false;
+	}
+}
+
+
+//Function: DecodeTGA(const unsigned char* data, size_t size, const TGAInfo& info, unsigned char* pixels)
+//Description: This method decodes the image into pixels, which has to hold width * height RGBA pixels. Rows are written to
+//their final place as they are read, so images stored bottom up are flipped on the way.
+//Returns: bool = whether the whole image was decoded, false if the file is truncated or uses a color map entry it does not have.
+bool DecodeTGA(const unsigned char* data, size_t size, const TGAInfo& info, unsigned char* pixels)
+{
+	SelectConvertersOnce();
+
+	const unsigned char* source = data + info.pixelOffset;
+	const unsigned char* end = data + size;
+	int width = info.width;
+	int height = info.height;
+	int bytesPerPixel = info.bytesPerPixel;
+	size_t rowBytes = (size_t)width * 4;
+
+	//Color mapped images are converted through a table of RGBA entries indexed by the pixel values
+	bool colorMapped = (info.imageType == TGAColorMapped || info.imageType == TGAColorMappedRLE);
+	uint32_t colorMap[256];
+	if (colorMapped)
+	{
+		if (info.colorMapOffset + (size_t)info.colorMapLength * info.colorMapBytes > size)
+			return false;
+
+		for (int i = 0; i < 256; i++)
+		{
+			int entry = i - info.colorMapFirst;
+			if (entry >= 0 && entry < info.colorMapLength)
+			{
+				unsigned char rgba[4];
+				ConvertFunction* convert = (info.colorMapBytes == 4) ? convertBGRA : convertBGR;
+				convert(data + info.colorMapOffset + entry * info.colorMapBytes, rgba, 1);
+				memcpy(&colorMap[i], rgba, 4);
+			}
+			else
+			{
+				colorMap[i] = 0;
+			}
+		}
+	}
+
+	ConvertFunction* convert = (bytesPerPixel == 4) ? convertBGRA : (bytesPerPixel == 3) ? convertBGR : ConvertGray;
+
+	bool rle = (info.imageType == TGAColorMappedRLE || info.imageType == TGATrueColorRLE || info.imageType == TGAGrayscaleRLE);
+
+	//Walk the image in file order, x is the next pixel of the current file row
+	int x = 0;
+	int fileRow = 0;
+	unsigned char* row = pixels + (info.topOrigin ? 0 : (size_t)(height - 1) * rowBytes);
+
+	while (fileRow < height)
+	{
+		//Uncompressed images are one raw span per row, RLE images are a packet header followed by the span or the repeated pixel
+		int count = width - x;
+		bool repeat = false;
+		if (rle)
+		{
+			if (source >= end)
+				return false;
+
+			count = (*source & 0x7F) + 1;
+			repeat = (*source & 0x80) != 0;
+			source++;
+		}
+
+		//Packets may carry on into the next row
+		size_t spanBytes = (size_t)(repeat ? 1 : count) * bytesPerPixel;
+		if ((size_t)(end - source) < spanBytes)
+			return false;
+
+		uint32_t repeated = 0;
+		if (repeat)
+		{
+			if (colorMapped)
+				repeated = colorMap[*source];
+			else
+				convert(source, (unsigned char*)&repeated, 1);
+		}
+
+		while (count > 0 && fileRow < height)
+		{
+			int spanCount = (count < width - x) ? count : width - x;
+			unsigned char* destination = row + (size_t)x * 4;
+
+			if (repeat)
+			{
+				for (int i = 0; i < spanCount; i++)
+				{
+					memcpy(destination + i * 4, &repeated, 4);
+				}
+			}
+			else if (colorMapped)
+			{
+				for (int i = 0; i < spanCount; i++)
+				{
+					memcpy(destination + i * 4, &colorMap[source[i]], 4);
+				}
+				source += spanCount;
+			}
+			else
+			{
+				convert(source, destination, spanCount);
+				source += (size_t)spanCount * bytesPerPixel;
+			}
+
+			x += spanCount;
+			count -= spanCount;
+
+			//Finished a row, mirror it if it was stored right to left and move on to where the next file row goes
+			if (x == width)
+			{
+				if (info.rightOrigin)
+				{
+					uint32_t* rowPixels = (uint32_t*)row;
+					for (int left = 0, right = width - 1; left < right; left++, right--)
+					{
+						uint32_t swap = rowPixels[left];
+						rowPixels[left] = rowPixels[right];
+						rowPixels[right] = swap;
+					}
+				}
+
+				x = 0;
+				fileRow++;
+				row = info.topOrigin ? row + rowBytes : row - rowBytes;
+			}
+		}
+
+		if (repeat)
+		{
+			source += bytesPerPixel;
+		}
+	}
+
+	return true;
+}
+
+
+//Function: ReadTGA(const char* fileName, std::vector<unsigned char>* pixels, int* width, int* height)
+//Description: This method maps a TGA file and decodes it straight out of the mapping into RGBA pixels stored top to bottom.
+//Returns: bool = whether the file could be read and decoded.
+bool ReadTGA(const char* fileName, std::vector<unsigned char>* pixels, int* width, int* height)
+{
+	MappedFile file;
+	if (!file.Open(fileName))
+		return false;
+
+	TGAInfo info;
+	if (!ReadTGAInfo(file.data, file.size, &info))
+		return false;
+
+	pixels->resize((size_t)info.width * info.height * 4);
+	if (!DecodeTGA(file.data, file.size, info, pixels->data()))
+		return false;
+
+	*width = info.width;
+	*height = info.height;
+	return true;
+}
+
+
+//Function: WriteTGA(const char* fileName, const unsigned char* pixels, int width, int height)
+//Description: This method writes RGBA pixels stored top to bottom as an uncompressed 32 bit TGA with a top origin.
+//Returns: bool = whether the whole file was written.
+bool WriteTGA(const char* fileName, const unsigned char* pixels, int width, int height)
+{
+	FILE* file = fopen(fileName, "wb");
+	if (!file)
+		return false;
+
+	unsigned char header[TGA_HEADER_SIZE] = {};
+	header[2] = TGATrueColor;
+	header[12] = (unsigned char)(width & 0xFF);
+	header[13] = (unsigned char)(width >> 8);
+	header[14] = (unsigned char)(height & 0xFF);
+	header[15] = (unsigned char)(height >> 8);
+	header[16] = 32;
+	header[17] = 0x28;	//8 alpha bits, top origin
+
+	bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+	//TGA stores BGRA, swap a row at a time
+	std::vector<unsigned char> row((size_t)width * 4);
+	for (int y = 0; y < height && written; y++)
+	{
+		const unsigned char* source = pixels + (size_t)y * width * 4;
+		for (int x = 0; x < width; x++)
+		{
+			row[x * 4 + 0] = source[x * 4 + 2];
+			row[x * 4 + 1] = source[x * 4 + 1];
+			row[x * 4 + 2] = source[x * 4 + 0];
+			row[x * 4 + 3] = source[x * 4 + 3];
+		}
+		written = fwrite(row.data(), 1, row.size(), file) == row.size();
+	}
+
+	return (fclose(file) == 0) && written;
+}
+
+
+//Function: SelectTGAConverter()
+//Description: This method picks the SSSE3 converters when the CPU supports them.
+//Returns: TGAConverter = the converters that will be used.
+TGAConverter SelectTGAConverter()
+{
+	TGAConverter converter = TGAConverterScalar;
+
+#if TGA_X86
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		bool ssse3 = (info[2] & (1 << 9)) != 0;
+	#else
+		__builtin_cpu_init();
+		bool ssse3 = __builtin_cpu_supports("ssse3");
+	#endif
+
+	if (ssse3)
+		converter = TGAConverterSSSE3;
+#endif
+
+	SetTGAConverter(converter);
+	return converter;
+}
+
+
+//Function: SetTGAConverter(TGAConverter converter)
+//Description: This method forces the converters, mostly to compare them. Converters that were not compiled in fall back to the
+//scalar ones. It must not be called while images are being decoded.
+//Returns: void.
+void SetTGAConverter(TGAConverter converter)
+{
+	convertBGRA = ConvertBGRAScalar;
+	convertBGR = ConvertBGRScalar;
+
+#if TGA_X86
+	if (converter == TGAConverterSSSE3)
+	{
+		convertBGRA = ConvertBGRASSSE3;
+		convertBGR = ConvertBGRSSSE3;
+	}
+#endif
+}
@@ -0,0 +1,315 @@
+/*
+File Name:		TGACheck.cpp
+Description:	This file is the TGA decoder check and benchmark. It decodes every texture the asset manifest packs with the scalar
+				converters and with the SSSE3 ones and compares the pixels. Every texture is also encoded again in memory as
+				24 bit, RLE and right to left images, since the corpus itself is all uncompressed 32 bit, and those must decode
+				to the same pixels as the original too. Last it times decoding the corpus with each converter and prints MB/s
+				of RGBA pixels written.
+				Usage: TGACheck <manifest> <asset directory> [repeats]
+Programmer:		Kyle Jensen
+Date:			October 17, 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../Include/TGA.h"
+#include "../Include/MappedFile.h"
+
+//A texture of the corpus, the file as it is on disk and the pixels it decodes to
+struct CorpusImage
+{
+	std::string name;
+	std::vector<unsigned char> file;
+	std::vector<unsigned char> pixels;
+	int width;
+	int height;
+};
+
+//How an image is encoded again to reach the paths the corpus does not use
+struct TGAVariant
+{
+	const char* name;
+	int bytesPerPixel;
+	bool rle;
+	bool topOrigin;
+	bool rightOrigin;
+};
+
+static const TGAVariant variants[] =
+{
+	{ "24 bit", 3, false, true, false },
+	{ "32 bit RLE", 4, true, false, false },
+	{ "24 bit RLE right to left", 3, true, true, true },
+};
+
+static const char* converterNames[] = { "scalar", "SSSE3" };
+
+
+//Function: ReadManifestTextures(const char* manifestName, const char* assetDirectory, std::vector<std::string>* fileNames)
+//Description: This method finds every TGA file the manifest reads. A line packs its second column instead of its first when
+//that is a file, every file is listed once.
+//Returns: bool = whether the manifest could be read.
+static bool ReadManifestTextures(const char* manifestName, const char* assetDirectory, std::vector<std::string>* fileNames)
+{
+	FILE* manifest = fopen(manifestName, "r");
+	if (!manifest)
+		return false;
+
+	std::set<std::string> seen;
+	char line[1024];
+	while (fgets(line, sizeof(line), manifest))
+	{
+		char first[512];
+		char second[512];
+		int columns = sscanf(line, "%511s %511s", first, second);
+		if (columns < 1 || first[0] == '#')
+			continue;
+
+		std::string source = (columns == 2 && strstr(second, ".tga")) ? second : first;
+		if (source.size() < 4 || source.compare(source.size() - 4, 4, ".tga") != 0 || !seen.insert(source).second)
+			continue;
+
+		fileNames->push_back(std::string(assetDirectory) + "/" + source);
+	}
+
+	fclose(manifest);
+	return true;
+}
+
+
+//Function: Decode(const std::vector<unsigned char>& file, TGAConverter converter, std::vector<unsigned char>* pixels)
+//Description: This method decodes a TGA file in memory with the given converters.
+//Returns: bool = whether it decoded.
+static bool Decode(const std::vector<unsigned char>& file, TGAConverter converter, std::vector<unsigned char>* pixels)
+{
+	TGAInfo info;
+	if (!ReadTGAInfo(file.data(), file.size(), &info))
+		return false;
+
+	SetTGAConverter(converter);
+	pixels->assign((size_t)info.width * info.height * 4, 0);
+	return DecodeTGA(file.data(), file.size(), info, pixels->data());
+}
+
+
+//Function: PutPixel(std::vector<unsigned char>* file, const unsigned char* rgba, int bytesPerPixel)
+//Description: This method appends a pixel to a TGA file in BGR or BGRA order.
+//Returns: void.
+static void PutPixel(std::vector<unsigned char>* file, const unsigned char* rgba, int bytesPerPixel)
+{
+	file->push_back(rgba[2]);
+	file->push_back(rgba[1]);
+	file->push_back(rgba[0]);
+	if (bytesPerPixel == 4)
+	{
+		file->push_back(rgba[3]);
+	}
+}
+
+
+//Function: EncodeVariant(const CorpusImage& image, const TGAVariant& variant)
+//Description: This method encodes decoded pixels again as a TGA file in memory. RLE packets run on across rows, which the decoder
+//has to handle, and a run of equal pixels becomes a repeat packet.
+//Returns: std::vector<unsigned char> = the file.
+static std::vector<unsigned char> EncodeVariant(const CorpusImage& image, const TGAVariant& variant)
+{
+	std::vector<unsigned char> file(TGA_HEADER_SIZE, 0);
+	file[2] = variant.rle ? TGATrueColorRLE : TGATrueColor;
+	file[12] = (unsigned char)(image.width & 0xFF);
+	file[13] = (unsigned char)(image.width >> 8);
+	file[14] = (unsigned char)(image.height & 0xFF);
+	file[15] = (unsigned char)(image.height >> 8);
+	file[16] = (unsigned char)(variant.bytesPerPixel * 8);
+	file[17] = (unsigned char)((variant.bytesPerPixel == 4 ? 8 : 0) | (variant.topOrigin ? 0x20 : 0) | (variant.rightOrigin ? 0x10 : 0));
+
+	//Lay the pixels out in file order first
+	std::vector<const unsigned char*> order;
+	order.reserve((size_t)image.width * image.height);
+	for (int fileRow = 0; fileRow < image.height; fileRow++)
+	{
+		int y = variant.topOrigin ? fileRow : image.height - 1 - fileRow;
+		for (int fileColumn = 0; fileColumn < image.width; fileColumn++)
+		{
+			int x = variant.rightOrigin ? image.width - 1 - fileColumn : fileColumn;
+			order.push_back(&image.pixels[((size_t)y * image.width + x) * 4]);
+		}
+	}
+
+	size_t count = order.size();
+	size_t i = 0;
+	while (i < count)
+	{
+		if (!variant.rle)
+		{
+			PutPixel(&file, order[i++], variant.bytesPerPixel);
+			continue;
+		}
+
+		//Only the bytes that end up in the file count when looking for a run
+		size_t run = 1;
+		while (i + run < count && run < 128 && memcmp(order[i], order[i + run], variant.bytesPerPixel) == 0)
+		{
+			run++;
+		}
+
+		if (run > 1)
+		{
+			file.push_back((unsigned char)(0x80 | (run - 1)));
+			PutPixel(&file, order[i], variant.bytesPerPixel);
+			i += run;
+		}
+		else
+		{
+			size_t raw = 1;
+			while (i + raw < count && raw < 128 && memcmp(order[i + raw - 1], order[i + raw], variant.bytesPerPixel) != 0)
+			{
+				raw++;
+			}
+
+			file.push_back((unsigned char)(raw - 1));
+			for (size_t j = 0; j < raw; j++)
+			{
+				PutPixel(&file, order[i + j], variant.bytesPerPixel);
+			}
+			i += raw;
+		}
+	}
+
+	return file;
+}
+
+
+//Function: CheckVariant(const CorpusImage& image, const TGAVariant& variant, TGAConverter widest)
+//Description: This method encodes an image as a variant and checks that every converter decodes it to the original pixels, with
+//alpha opaque when the variant has none.
+//Returns: bool = whether every converter did.
+static bool CheckVariant(const CorpusImage& image, const TGAVariant& variant, TGAConverter widest)
+{
+	std::vector<unsigned char> file = EncodeVariant(image, variant);
+
+	std::vector<unsigned char> expected = image.pixels;
+	if (variant.bytesPerPixel == 3)
+	{
+		for (size_t i = 3; i < expected.size(); i += 4)
+		{
+			expected[i] = 255;
+		}
+	}
+
+	std::vector<unsigned char> pixels;
+	for (int converter = TGAConverterScalar; converter <= widest; converter++)
+	{
+		if (!Decode(file, (TGAConverter)converter, &pixels) || pixels != expected)
+		{
+			printf("TGACheck: %s as %s does not decode to the same pixels with the %s converters\n", image.name.c_str(), variant.name, converterNames[converter]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//Function: main()
+//Description: This is the main method of the TGA decoder check.
+//Returns: int = 0 if every image decoded the same every way, 1 otherwise.
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		printf("Usage: TGACheck <manifest> <asset directory> [repeats]\n");
+		return 1;
+	}
+
+	int repeats = (argc > 3) ? atoi(argv[3]) : 10;
+	if (repeats <= 0)
+		repeats = 1;
+
+	std::vector<std::string> fileNames;
+	if (!ReadManifestTextures(argv[1], argv[2], &fileNames))
+	{
+		printf("TGACheck: could not read %s\n", argv[1]);
+		return 1;
+	}
+
+	//Only the converters up to the widest the CPU supports can run
+	TGAConverter widest = SelectTGAConverter();
+
+	std::vector<CorpusImage> corpus;
+	size_t pixelBytes = 0;
+	for (size_t i = 0; i < fileNames.size(); i++)
+	{
+		MappedFile mapped;
+		if (!mapped.Open(fileNames[i].c_str()))
+		{
+			printf("TGACheck: could not open %s\n", fileNames[i].c_str());
+			return 1;
+		}
+
+		CorpusImage image;
+		image.name = fileNames[i];
+		image.file.assign(mapped.data, mapped.data + mapped.size);
+
+		TGAInfo info;
+		if (!ReadTGAInfo(image.file.data(), image.file.size(), &info) || !Decode(image.file, TGAConverterScalar, &image.pixels))
+		{
+			printf("TGACheck: could not decode %s\n", image.name.c_str());
+			return 1;
+		}
+		image.width = info.width;
+		image.height = info.height;
+
+		std::vector<unsigned char> pixels;
+		for (int converter = TGAConverterScalar + 1; converter <= widest; converter++)
+		{
+			if (!Decode(image.file, (TGAConverter)converter, &pixels) || pixels != image.pixels)
+			{
+				printf("TGACheck: %s does not decode to the same pixels with the %s converters\n", image.name.c_str(), converterNames[converter]);
+				return 1;
+			}
+		}
+
+		for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++)
+		{
+			if (!CheckVariant(image, variants[v], widest))
+				return 1;
+		}
+
+		pixelBytes += image.pixels.size();
+		corpus.push_back(image);
+	}
+
+	printf("TGACheck: %d textures decode to the same pixels with the scalar to %s converters, as %d variants too\n", (int)corpus.size(),
+		converterNames[widest], (int)(sizeof(variants) / sizeof(variants[0])));
+
+	//The same buffer for every image so the timing is the decoder and not the allocator
+	std::vector<unsigned char> pixels;
+	for (int converter = TGAConverterScalar; converter <= widest; converter++)
+	{
+		SetTGAConverter((TGAConverter)converter);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int repeat = 0; repeat < repeats; repeat++)
+		{
+			for (size_t i = 0; i < corpus.size(); i++)
+			{
+				TGAInfo info;
+				ReadTGAInfo(corpus[i].file.data(), corpus[i].file.size(), &info);
+				pixels.resize(corpus[i].pixels.size());
+				DecodeTGA(corpus[i].file.data(), corpus[i].file.size(), info, pixels.data());
+			}
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		printf("TGACheck: %-6s converters decode %.1f MB of pixels %d times at %.0f MB/s\n", converterNames[converter],
+			pixelBytes / (1024.0 * 1024.0), repeats, (seconds > 0.0) ? pixelBytes * (double)repeats / (1024.0 * 1024.0) / seconds : 0.0);
+	}
+
+	return 0;
+}
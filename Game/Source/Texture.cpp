@@ -13,99 +13,87 @@ Date:			March 24, 2017
 //Returns: TextureHandle = A handle to the texture.
 TextureHandle LoadTextureFromTGA(ID3D11Device* device, ID3D11DeviceContext* deviceContext, char* fileName)
 {
-	TextureHandle textureView;
-	ID3D11Texture2D* texture;
-
-	unsigned char* tgaData;
-	int height = 0;
+	std::vector<unsigned char> pixels;
 	int width = 0;
-	int bpp = 0;
-	int imageSize = 0;
-
-	D3D11_TEXTURE2D_DESC textureDesc;
-	HRESULT hResult;
-	unsigned int rowPitch;
-	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
-
-	FILE* ifp;
-	TGAHeader tgaFileHeader;
-	unsigned char* tgaImageData;
+	int height = 0;
 
-	//Open up the file for reading in binary
-	int error = fopen_s(&ifp, fileName, "rb");
-	if (error != 0)
-		return false;
+	if (!ReadTGA(fileName, &pixels, &width, &height))
+		return 0;
 
-	//Read in the file header information
-	unsigned int count = (unsigned int)fread(&tgaFileHeader, sizeof(TGAHeader), 1, ifp);
-	if (count != 1)
-		return false;
+	return CreateTextureFromPixels(device, deviceContext, pixels.data(), width, height);
+}
 
-	//Get the important information from the header
-	height = (int)tgaFileHeader.height;
-	width = (int)tgaFileHeader.width;
-	bpp = (int)tgaFileHeader.bpp;
 
-	//Only support 32 bit densities
-	if (bpp != 32)
-		return false;
+//Function: CreateTextureFromPixels()
+//Description: This method creates a mipmapped texture from RGBA pixels stored top to bottom, with mipLevels mips or, when it
+//is 0, the whole chain.
+//Returns: TextureHandle = A handle to the texture.
+TextureHandle CreateTextureFromPixels(ID3D11Device* device, ID3D11DeviceContext* deviceContext, const unsigned char* pixels, int width, int height, int mipLevels)
+{
+	TextureHandle textureView = 0;
+	ID3D11Texture2D* texture = 0;
+	D3D11_TEXTURE2D_DESC textureDesc;
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+	HRESULT hResult;
 
-	//Calculate the size of the image data
-	imageSize = width * height * 4;
+	//Set up texture description
+	textureDesc.Height = height;
+	textureDesc.Width = width;
+	textureDesc.MipLevels = mipLevels;
+	textureDesc.ArraySize = 1;
+	textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	textureDesc.SampleDesc.Count = 1;
+	textureDesc.SampleDesc.Quality = 0;
+	textureDesc.Usage = D3D11_USAGE_DEFAULT;
+	textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+	textureDesc.CPUAccessFlags = 0;
+	textureDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
 
-	//Allocate memory for the image data based on the size of the image
-	tgaImageData = new unsigned char[imageSize];
-	if (!tgaImageData)
-		return false;
+	//Create empty texture so we can copy our TGA data into it
+	hResult = device->CreateTexture2D(&textureDesc, NULL, &texture);
+	if (FAILED(hResult))
+		return 0;
 
-	//Read the target image data into the buffer
-	count = (unsigned int)fread(tgaImageData, 1, imageSize, ifp);
-	if (count != imageSize)
-		return false;
+	//Copy the image data into the texture
+	unsigned int rowPitch = (width * 4) * sizeof(unsigned char);
+	deviceContext->UpdateSubresource(texture, 0, NULL, pixels, rowPitch, 0);
 
-	error = fclose(ifp);
-	if (error != 0)
-		return false;
+	//Set the shader resource view description
+	srvDesc.Format = textureDesc.Format;
+	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Texture2D.MostDetailedMip = 0;
+	srvDesc.Texture2D.MipLevels = -1;
 
-	// Allocate memory for the targa destination data.
-	tgaData = new unsigned char[imageSize];
-	if (!tgaData)
-		return false;
+	//Create a shader resource view for the given texture, the view keeps the texture alive
+	hResult = device->CreateShaderResourceView(texture, &srvDesc, &textureView);
+	texture->Release();
+	if (FAILED(hResult))
+		return 0;
 
-	//Initialize the index into the targa image data
-	int k = (width * height * 4) - (width * 4);
+	//Generate mipmaps
+	deviceContext->GenerateMips(textureView);
 
-	//Initialize the index into the targa destination data array
-	int index = 0;
+	return textureView;
+}
 
-	//Because the TGA image format stores images upside down, we need to load the image data into the tga destination in the correct order
-	for (int j = 0; j < height; j++)
-	{
-		for (int i = 0; i < width; i++)
-		{
-			//Set tga data
-			tgaData[index + 0] = tgaImageData[k + 2];  // Red.
-			tgaData[index + 1] = tgaImageData[k + 1];  // Green.
-			tgaData[index + 2] = tgaImageData[k + 0];  // Blue
-			tgaData[index + 3] = tgaImageData[k + 3];  // Alpha
-
-													   // Increment the indexes into the targa data.
-			k += 4;
-			index += 4;
-		}
-
-		//Set the targa image data index back to the preceding row at the beginning of the column since its reading it in upside down
-		k -= (width * 8);
-	}
 
-	delete[] tgaImageData;
-	tgaImageData = 0;
+//Function: CreateTextureArrayFromPixels()
+//Description: This method creates a mipmapped texture array with one slice per image. Every image has to be RGBA pixels of the
+//same size, stored top to bottom.
+//Returns: TextureHandle = A handle to the texture array.
+TextureHandle CreateTextureArrayFromPixels(ID3D11Device* device, ID3D11DeviceContext* deviceContext, const unsigned char* const* slices, int sliceCount, int width, int height)
+{
+	TextureHandle textureView = 0;
+	ID3D11Texture2D* texture = 0;
+	D3D11_TEXTURE2D_DESC textureDesc;
+	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
+	HRESULT hResult;
 
 	//Set up texture description
 	textureDesc.Height = height;
 	textureDesc.Width = width;
 	textureDesc.MipLevels = 0;
-	textureDesc.ArraySize = 1;
+	textureDesc.ArraySize = sliceCount;
 	textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 	textureDesc.SampleDesc.Count = 1;
 	textureDesc.SampleDesc.Quality = 0;
@@ -114,30 +102,45 @@ TextureHandle LoadTextureFromTGA(ID3D11Device* device, ID3D11DeviceContext* devi
 	textureDesc.CPUAccessFlags = 0;
 	textureDesc.MiscFlags = D3D11_RESOURCE_MISC_GENERATE_MIPS;
 
-	//Create empty texture so we can copy our TGA data into it
 	hResult = device->CreateTexture2D(&textureDesc, NULL, &texture);
+	if (FAILED(hResult))
+		return 0;
 
-	//Set the row pitch of the TGA image data
-	rowPitch = (width * 4) * sizeof(unsigned char);
+	//Read back how many mips the texture got, the top mip of every slice is that many subresources after the last one
+	texture->GetDesc(&textureDesc);
 
-	//Copy the image data from the TGA data array to the texture
-	deviceContext->UpdateSubresource(texture, 0, NULL, tgaData, rowPitch, 0);
+	unsigned int rowPitch = (width * 4) * sizeof(unsigned char);
+	for (int i = 0; i < sliceCount; i++)
+	{
+		UINT subresource = D3D11CalcSubresource(0, i, textureDesc.MipLevels);
+		deviceContext->UpdateSubresource(texture, subresource, NULL, slices[i], rowPitch, 0);
+	}
 
 	//Set the shader resource view description
 	srvDesc.Format = textureDesc.Format;
-	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Texture2D.MostDetailedMip = 0;
-	srvDesc.Texture2D.MipLevels = -1;
+	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+	srvDesc.Texture2DArray.MostDetailedMip = 0;
+	srvDesc.Texture2DArray.MipLevels = -1;
+	srvDesc.Texture2DArray.FirstArraySlice = 0;
+	srvDesc.Texture2DArray.ArraySize = sliceCount;
 
-	//Create a shader resource view for the given texture
+	//Create a shader resource view for the given texture, the view keeps the texture alive
 	hResult = device->CreateShaderResourceView(texture, &srvDesc, &textureView);
+	texture->Release();
+	if (FAILED(hResult))
+		return 0;
 
-	//Generate mipmaps
+	//Generate mipmaps for every slice
 	deviceContext->GenerateMips(textureView);
 
-	//Release the TGA data array as the texture is successfully loaded into memory
-	delete[] tgaData;
-	tgaData = NULL;
-
 	return textureView;
-}
\ No newline at end of file
+}
+
+
+//Function: FullTextureRegion()
+//Description: This method makes a region covering a whole texture, for textures that are not packed into an atlas.
+//Returns: SpriteRegion = the region.
+SpriteRegion FullTextureRegion(TextureHandle texture)
+{
+	return SpriteRegion{ texture, 0.0f, 0.0f, 1.0f, 1.0f };
+}
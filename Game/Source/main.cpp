@@ -7,7 +7,11 @@
 */
 
 #include <windows.h>
+#include <stdio.h>
+#include <string.h>
 #include "../Include/Game.h"
+#include "../Include/Archive.h"
+#include "../Include/DirectSoundBackend.h"
 
 
 IDXGISwapChain* swapChain;
@@ -27,12 +31,13 @@ struct GameCode
 };
 
 //Function: CompileShaderFromFile()
-//Description: This method takes in a shader filename and loads the shader buffer.
+//Description: This method takes in a shader filename and loads the shader buffer. The entry point defaults to the texture pixel
+//shader, vertex shaders always name theirs.
 //Returns: void.
-void CompileShaderFromFile(wchar_t* shaderFileName, ID3D10Blob** shaderBuffer, bool pixel)
+void CompileShaderFromFile(wchar_t* shaderFileName, ID3D10Blob** shaderBuffer, bool pixel, char* entryPoint = 0)
 {
     D3DCompileFromFile((LPCWSTR)shaderFileName, NULL, NULL, 
-		pixel ? "TexturePixelShader" : "TextureVertexShader",
+		entryPoint ? entryPoint : "TexturePixelShader",
         pixel ? "ps_5_0" : "vs_5_0", D3D10_SHADER_ENABLE_STRICTNESS, 
 		0, shaderBuffer, 0
 	);
@@ -95,6 +100,10 @@ LRESULT CALLBACK WinProc(HWND window, UINT message, WPARAM wParam, LPARAM lParam
 //Returns: int = result of the main method.
 int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine, int cmdShow)
 {
+	//Startup is timed from here to the end of the first frame
+	LARGE_INTEGER startCounter;
+	QueryPerformanceCounter(&startCounter);
+
     WNDCLASSA windowClass = {};
 
 	windowClass.style = CS_HREDRAW|CS_VREDRAW;
@@ -398,36 +407,26 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine,
 				//TODO: Extend this into a Shader object that will encapsulate the loading and compiling of the shader on the GPU,
 				//to allow different shaders to be bound to different models. For the purposes of this assignment we only need 1 basic shader.
 
-				ID3D11VertexShader* vertexShader = 0;
 				ID3D11PixelShader* pixelShader = 0;
-				ID3D11InputLayout* layout = 0;
 
 				ID3D10Blob* errorMessage = 0;
-				ID3D10Blob* vertexShaderBuffer = 0;
 				ID3D10Blob* pixelShaderBuffer = 0;
 
 				D3D11_INPUT_ELEMENT_DESC polygonLayout[2];
-				unsigned int numElements;
 
 				TCHAR filepath[MAX_PATH];
 				GetModuleFileName(NULL, filepath, MAX_PATH);
 
 				LPWSTR vsFilename = L"Assets//Shaders//texture.vs";
 				LPWSTR psFilename = L"Assets//Shaders//texture.ps";
-				CompileShaderFromFile(vsFilename, &vertexShaderBuffer, false);
 				CompileShaderFromFile(psFilename, &pixelShaderBuffer, true);
 
-				// Create the vertex shader from the buffer.
-				result = device->CreateVertexShader(vertexShaderBuffer->GetBufferPointer(), vertexShaderBuffer->GetBufferSize(), NULL, &vertexShader);
-				if (FAILED(result))
-					return false;
-
 				// Create the pixel shader from the buffer.
 				result = device->CreatePixelShader(pixelShaderBuffer->GetBufferPointer(), pixelShaderBuffer->GetBufferSize(), NULL, &pixelShader);
 				if (FAILED(result))
 					return false;
 
-				//Set up the layout of the data in the shader (matches format of shader file)
+				//The per-vertex part of the layout the sprite and planet shaders share, their per-instance parts follow it
 				polygonLayout[0].SemanticName = "POSITION";
 				polygonLayout[0].SemanticIndex = 0;
 				polygonLayout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
@@ -444,18 +443,97 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine,
 				polygonLayout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
 				polygonLayout[1].InstanceDataStepRate = 0;
 
-				// Get a count of the elements in the layout.
-				numElements = sizeof(polygonLayout) / sizeof(polygonLayout[0]);
+				//The sprite shader lives in the same file, it adds the per-instance rectangle, depth, angle and atlas region in a second slot
+				ID3D11VertexShader* spriteVertexShader = 0;
+				ID3D11InputLayout* spriteLayout = 0;
+				ID3D10Blob* spriteShaderBuffer = 0;
+				CompileShaderFromFile(vsFilename, &spriteShaderBuffer, false, "SpriteVertexShader");
+
+				result = device->CreateVertexShader(spriteShaderBuffer->GetBufferPointer(), spriteShaderBuffer->GetBufferSize(), NULL, &spriteVertexShader);
+				if (FAILED(result))
+					return false;
+
+				D3D11_INPUT_ELEMENT_DESC spriteLayoutDesc[5];
+				spriteLayoutDesc[0] = polygonLayout[0];
+				spriteLayoutDesc[1] = polygonLayout[1];
+
+				spriteLayoutDesc[2].SemanticName = "TEXCOORD";
+				spriteLayoutDesc[2].SemanticIndex = 1;
+				spriteLayoutDesc[2].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+				spriteLayoutDesc[2].InputSlot = 1;
+				spriteLayoutDesc[2].AlignedByteOffset = 0;
+				spriteLayoutDesc[2].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+				spriteLayoutDesc[2].InstanceDataStepRate = 1;
+
+				spriteLayoutDesc[3].SemanticName = "TEXCOORD";
+				spriteLayoutDesc[3].SemanticIndex = 2;
+				spriteLayoutDesc[3].Format = DXGI_FORMAT_R32G32_FLOAT;
+				spriteLayoutDesc[3].InputSlot = 1;
+				spriteLayoutDesc[3].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+				spriteLayoutDesc[3].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+				spriteLayoutDesc[3].InstanceDataStepRate = 1;
+
+				spriteLayoutDesc[4].SemanticName = "TEXCOORD";
+				spriteLayoutDesc[4].SemanticIndex = 3;
+				spriteLayoutDesc[4].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+				spriteLayoutDesc[4].InputSlot = 1;
+				spriteLayoutDesc[4].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+				spriteLayoutDesc[4].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+				spriteLayoutDesc[4].InstanceDataStepRate = 1;
+
+				result = device->CreateInputLayout(spriteLayoutDesc, ArrayCount(spriteLayoutDesc), spriteShaderBuffer->GetBufferPointer(),
+					spriteShaderBuffer->GetBufferSize(), &spriteLayout);
+				if (FAILED(result))
+					return false;
+
+				spriteShaderBuffer->Release();
+				spriteShaderBuffer = 0;
+
+				//Planets are drawn instanced too, with a world matrix and a texture array slice per instance
+				ID3D11VertexShader* planetVertexShader = 0;
+				ID3D11PixelShader* planetPixelShader = 0;
+				ID3D11InputLayout* planetLayout = 0;
+				ID3D10Blob* planetShaderBuffer = 0;
+				ID3D10Blob* planetPixelShaderBuffer = 0;
+				CompileShaderFromFile(vsFilename, &planetShaderBuffer, false, "PlanetVertexShader");
+				CompileShaderFromFile(psFilename, &planetPixelShaderBuffer, true, "PlanetPixelShader");
+
+				result = device->CreateVertexShader(planetShaderBuffer->GetBufferPointer(), planetShaderBuffer->GetBufferSize(), NULL, &planetVertexShader);
+				if (FAILED(result))
+					return false;
 
-				// Create the vertex input layout.
-				result = device->CreateInputLayout(polygonLayout, numElements, vertexShaderBuffer->GetBufferPointer(),
-					vertexShaderBuffer->GetBufferSize(), &layout);
+				result = device->CreatePixelShader(planetPixelShaderBuffer->GetBufferPointer(), planetPixelShaderBuffer->GetBufferSize(), NULL, &planetPixelShader);
 				if (FAILED(result))
 					return false;
 
-				// Release the vertex shader buffer and pixel shader buffer since they are no longer needed.
-				vertexShaderBuffer->Release();
-				vertexShaderBuffer = 0;
+				//The world matrix rows are TEXCOORD1 to TEXCOORD4, the slice is TEXCOORD5
+				D3D11_INPUT_ELEMENT_DESC planetLayoutDesc[7];
+				planetLayoutDesc[0] = polygonLayout[0];
+				planetLayoutDesc[1] = polygonLayout[1];
+
+				for (int i = 2; i < 7; i++)
+				{
+					planetLayoutDesc[i].SemanticName = "TEXCOORD";
+					planetLayoutDesc[i].SemanticIndex = i - 1;
+					planetLayoutDesc[i].Format = (i < 6) ? DXGI_FORMAT_R32G32B32A32_FLOAT : DXGI_FORMAT_R32_FLOAT;
+					planetLayoutDesc[i].InputSlot = 1;
+					planetLayoutDesc[i].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+					planetLayoutDesc[i].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+					planetLayoutDesc[i].InstanceDataStepRate = 1;
+				}
+				planetLayoutDesc[2].AlignedByteOffset = 0;
+
+				result = device->CreateInputLayout(planetLayoutDesc, ArrayCount(planetLayoutDesc), planetShaderBuffer->GetBufferPointer(),
+					planetShaderBuffer->GetBufferSize(), &planetLayout);
+				if (FAILED(result))
+					return false;
+
+				planetShaderBuffer->Release();
+				planetShaderBuffer = 0;
+				planetPixelShaderBuffer->Release();
+				planetPixelShaderBuffer = 0;
+
+				// Release the pixel shader buffer since it is no longer needed.
 				pixelShaderBuffer->Release();
 				pixelShaderBuffer = 0;
 
@@ -493,8 +571,6 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine,
 			#pragma region Shader Input and Alpha Blending
 
 				deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-				deviceContext->IASetInputLayout(layout);
-				deviceContext->VSSetShader(vertexShader, NULL, 0);
 				deviceContext->PSSetShader(pixelShader, NULL, 0);
 
 				ID3D11BlendState* blendState = NULL;
@@ -520,19 +596,22 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine,
 			
 			#pragma region Matrix Buffer
 			
+				//The cameras get a constant buffer each so switching between them is a bind, not an upload
 				D3D11_BUFFER_DESC matrixBufferDesc;
-				ID3D11Buffer* matrixBuffer;
+				ID3D11Buffer* perspectiveBuffer = 0;
+				ID3D11Buffer* orthoBuffer = 0;
 
-				// Setup the description of the dynamic matrix constant buffer that is in the vertex shader.
+				// Setup the description of the dynamic matrix constant buffers that are in the vertex shader.
 				matrixBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-				matrixBufferDesc.ByteWidth = sizeof(MatrixBufferType);
+				matrixBufferDesc.ByteWidth = sizeof(CameraBufferType);
 				matrixBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
 				matrixBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 				matrixBufferDesc.MiscFlags = 0;
 				matrixBufferDesc.StructureByteStride = 0;
 
-				// Create the constant buffer pointer so we can access the vertex shader constant buffer from within this class.
-				device->CreateBuffer(&matrixBufferDesc, NULL, &matrixBuffer);
+				// Create the constant buffer pointers so we can access the vertex shader constant buffers from within this class.
+				device->CreateBuffer(&matrixBufferDesc, NULL, &perspectiveBuffer);
+				device->CreateBuffer(&matrixBufferDesc, NULL, &orthoBuffer);
 			
 			#pragma endregion
 
@@ -542,8 +621,25 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine,
 				std::unique_ptr<SpriteFont> spriteFontLucida24;
 				std::unique_ptr<SpriteFont> spriteFontLucida56;
 				spriteBatch.reset(new SpriteBatch(deviceContext));
-				spriteFontLucida24.reset(new SpriteFont(device, L"Assets//Fonts//lucida.spritefont"));
-				spriteFontLucida56.reset(new SpriteFont(device, L"Assets//Fonts//lucida56.spritefont"));
+
+				//Every asset comes from the archive the asset packer builds, it stays mapped for as long as the game runs
+				AssetArchive archive;
+				if (!archive.Open("Assets.pak"))
+				{
+					MessageBoxA(window, "Could not open Assets.pak, build it with the asset packer.", "Missing assets", MB_OK | MB_ICONERROR);
+					return false;
+				}
+
+				//Fonts are parsed straight out of the archive rather than read into a buffer by DirectXTK first
+				const ArchiveEntry* font24 = archive.Find("Fonts/lucida.spritefont");
+				const ArchiveEntry* font56 = archive.Find("Fonts/lucida56.spritefont");
+				if (!font24 || !font56)
+				{
+					MessageBoxA(window, "Assets.pak is missing the fonts, rebuild it with the asset packer.", "Missing assets", MB_OK | MB_ICONERROR);
+					return false;
+				}
+				spriteFontLucida24.reset(new SpriteFont(device, archive.Data(font24), (size_t)font24->size));
+				spriteFontLucida56.reset(new SpriteFont(device, archive.Data(font56), (size_t)font56->size));
 				
 			#pragma endregion
 
@@ -591,6 +687,14 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine,
 				if (FAILED(result))
 					return false;
 
+				//Every sound is mixed in software and streamed through one sound buffer, refilled by a thread of the platform layer.
+				//The mixer holds a decode buffer for every voice, far too much for the stack next to the game memory.
+				static AudioMixer mixer;
+				mixer.Initialize();
+				DirectSoundBackend audioOutput(directSound);
+				if (!audioOutput.Start(&mixer))
+					return false;
+
 			#pragma endregion
 
 			#pragma region Main Game Loop
@@ -604,32 +708,66 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine,
 				//Try Dynamic code reload, being the first time this should pass and start the program
 				TryReloadGameCode(&gameCode, gameDLLPath, gameTempDLLPath);
 
-				//Initialize the game state information with the rendering information we previously setup
-				GameState gameState = {};
-				gameState.swapChain = swapChain;
-				gameState.matrixBuffer = matrixBuffer;
-				gameState.spriteBatch = spriteBatch.get();
-				gameState.spriteFontLucida24 = spriteFontLucida24.get();
-				gameState.spriteFontLucida56 = spriteFontLucida56.get();
-				gameState.vertexShader = vertexShader;
-				gameState.pixelShader = pixelShader;
-				gameState.layout = layout;
-				gameState.rasterState = rasterState;
-				gameState.sampleState = sampleState;
-				gameState.blendState = blendState;
-				gameState.directSound = directSound;
-				gameState.primaryBuffer = primaryBuffer;
-				gameState.levelState = LevelState::Start;
+				//Initialize the game memory with the rendering information we previously setup
+				GameMemory gameMemory = {};
+				gameMemory.archive = &archive;
+				gameMemory.swapChain = swapChain;
+				gameMemory.perspectiveBuffer = perspectiveBuffer;
+				gameMemory.orthoBuffer = orthoBuffer;
+				gameMemory.spriteBatch = spriteBatch.get();
+				gameMemory.spriteFontLucida24 = spriteFontLucida24.get();
+				gameMemory.spriteFontLucida56 = spriteFontLucida56.get();
+				gameMemory.pixelShader = pixelShader;
+				gameMemory.spriteRenderer.vertexShader = spriteVertexShader;
+				gameMemory.spriteRenderer.layout = spriteLayout;
+				gameMemory.planetRenderer.vertexShader = planetVertexShader;
+				gameMemory.planetRenderer.pixelShader = planetPixelShader;
+				gameMemory.planetRenderer.layout = planetLayout;
+				gameMemory.rasterState = rasterState;
+				gameMemory.sampleState = sampleState;
+				gameMemory.blendState = blendState;
+				gameMemory.directSound = directSound;
+				gameMemory.primaryBuffer = primaryBuffer;
+				gameMemory.mixer = &mixer;
+				gameMemory.state.levelState = LevelState::Start;
+
+				//Started with -serialload, the assets are paged in without the workers, to time startup against them
+				gameMemory.serialLoad = strstr(cmdLine, "-serialload") != 0;
+
+				//Started with -timestartup, the time to the end of the first frame is appended to startup.log and the game quits,
+				//so cold starts can be timed in a loop. Both go before -record, which takes the rest of the command line.
+				bool timeStartup = strstr(cmdLine, "-timestartup") != 0;
+
+				//Started with -record <file>, the game records the input of every step for the replay tool
+				const char* recordSwitch = strstr(cmdLine, "-record ");
+				if (recordSwitch)
+				{
+					gameMemory.recordFileName = recordSwitch + strlen("-record ");
+				}
 
 				Input gameInput = {};
 				MouseInput currentMouseInput = {};
 				MouseInput lastMouseInput = {};
+				bool lastTraceKey = false;
+
+				//Setup the frame clock, the game turns the time between frames into fixed simulation steps
+				LARGE_INTEGER counterFrequency;
+				LARGE_INTEGER lastCounter;
+				QueryPerformanceFrequency(&counterFrequency);
+				QueryPerformanceCounter(&lastCounter);
+				bool firstFrame = true;
 
 				bool running = true;
 				while (running)
 				{
 					TryReloadGameCode(&gameCode, gameDLLPath, gameTempDLLPath);
 
+					//Measure how long the last frame took
+					LARGE_INTEGER currentCounter;
+					QueryPerformanceCounter(&currentCounter);
+					float frameTime = (float)(currentCounter.QuadPart - lastCounter.QuadPart) / (float)counterFrequency.QuadPart;
+					lastCounter = currentCounter;
+
 					MSG message;
 					while (PeekMessage(&message, 0, 0, 0, PM_REMOVE))
 					{
@@ -670,15 +808,46 @@ int CALLBACK WinMain(HINSTANCE instance, HINSTANCE prevInstance, LPSTR cmdLine,
 					gameInput.key4 = GetAsyncKeyState('4') & 0x0F;
 					gameInput.keyE = GetAsyncKeyState('E') & 0x0F;
 
+					//F9 writes the profiler trace once per press, when the profiler is compiled in
+					bool traceKey = (GetAsyncKeyState(VK_F9) & 0x8000) != 0;
+					if (traceKey && !lastTraceKey)
+						gameMemory.traceRequested = true;
+					lastTraceKey = traceKey;
+
 					//If the game update and render method was successfully loaded from DLL into the program, run it :D 
 					if (gameCode.GameUpdateAndRender)
 					{
-						gameCode.GameUpdateAndRender(&gameState, deviceContext, device, renderTargetView, depthStencilView, screenWidth, screenHeight, gameInput);
+						gameCode.GameUpdateAndRender(&gameMemory, deviceContext, device, renderTargetView, depthStencilView, screenWidth, screenHeight, gameInput, frameTime);
+
+						//The first frame loads the assets, report how long startup took and do not hand the load time to the simulation
+						if (firstFrame)
+						{
+							QueryPerformanceCounter(&lastCounter);
+							double startupTime = (double)(lastCounter.QuadPart - startCounter.QuadPart) * 1000.0 / counterFrequency.QuadPart;
+							char startupMessage[64];
+							sprintf_s(startupMessage, "Startup took %.1f ms, %s load\n", startupTime, gameMemory.serialLoad ? "serial" : "parallel");
+							OutputDebugStringA(startupMessage);
+							firstFrame = false;
+
+							if (timeStartup)
+							{
+								FILE* startupLog = fopen("startup.log", "a");
+								if (startupLog)
+								{
+									fputs(startupMessage, startupLog);
+									fclose(startupLog);
+								}
+								running = false;
+							}
+						}
 					}
 						
 					//Set input information	
 					lastMouseInput = currentMouseInput;
 				}
+
+				gameMemory.recorder.End();
+				audioOutput.Stop();
 	
 			#pragma endregion   
 
@@ -11,15 +11,82 @@ IF "%arg1%"=="" (
     SET dxtk_path=.\Include\DirectXTK\
     SET dxtk_lib=.\Libraries\DirectXTK.lib
 
-    SET game_cpp=Source\Game.cpp Source\Texture.cpp Source\Planet.cpp Source\Ship.cpp Source\Vector.cpp Source\Sound.cpp Source\Rocket.cpp
+    REM Add /DPROFILER_ENABLED=1 to compile the frame profiler into the game, F9 then writes trace.json
+    SET game_defines=
+
+    SET game_cpp=Source\Game.cpp Source\Texture.cpp Source\Planet.cpp Source\Ship.cpp Source\Vector.cpp Source\Simulation.cpp Source\Grid.cpp Source\Collision.cpp Source\Clock.cpp Source\SpriteRenderer.cpp Source\PlanetRenderer.cpp Source\RenderState.cpp Source\TGA.cpp Source\MappedFile.cpp Source\JobQueue.cpp Source\Archive.cpp Source\Mesh.cpp Source\Replay.cpp Source\Profiler.cpp Source\Mixer.cpp Source\Adpcm.cpp
+
+    ECHO.
+    ECHO Compiling and running the asset packer...
+    cl /Zi /MD /EHsc /nologo /I%assimp_path% Source\AssetPacker.cpp Source\Atlas.cpp Source\Archive.cpp Source\MappedFile.cpp Source\TGA.cpp Source\Sound.cpp Source\AudioConvert.cpp Source\Mesh.cpp Source\Adpcm.cpp /FeAssetPacker.exe /link %assimp_lib% User32.lib
+    AssetPacker.exe Assets\assets.txt Assets Assets.pak
+    IF ERRORLEVEL 1 EXIT /B 1
+
+    ECHO.
+    ECHO Compiling and running the mesh check against the golden sphere...
+    cl /O2 /Zi /MD /EHsc /nologo Source\MeshCheck.cpp Source\Archive.cpp Source\MappedFile.cpp Source\Mesh.cpp /FeMeshCheck.exe
+    MeshCheck.exe Assets.pak Models/sphere.mesh Assets\Golden\sphere.mesh
+    IF ERRORLEVEL 1 EXIT /B 1
+
+    ECHO.
+    ECHO Compiling the mesh stats tool...
+    cl /Zi /MD /EHsc /nologo /I%assimp_path% Source\MeshStats.cpp Source\Mesh.cpp /FeMeshStats.exe /link %assimp_lib%
+
+    ECHO.
+    ECHO Compiling and running the TGA decoder check...
+    cl /O2 /Zi /MD /EHsc /nologo Source\TGACheck.cpp Source\TGA.cpp Source\MappedFile.cpp /FeTGACheck.exe
+    TGACheck.exe Assets\assets.txt Assets
+    IF ERRORLEVEL 1 EXIT /B 1
+
+    ECHO.
+    ECHO Compiling and running the headless frame renderer against the golden frame...
+    cl /O2 /Zi /MD /EHsc /nologo Source\RenderFrame.cpp Source\SoftwareRenderer.cpp Source\Simulation.cpp Source\Planet.cpp Source\Ship.cpp Source\Vector.cpp Source\Grid.cpp Source\Collision.cpp Source\Clock.cpp Source\TGA.cpp Source\MappedFile.cpp Source\JobQueue.cpp Source\Archive.cpp Source\Mesh.cpp /FeRenderFrame.exe
+    REM The golden frame was made with g++ from an archive packed without Assimp, so a difference only warns until it has passed
+    REM here. Once it has, or once it has been regenerated here with the same arguments, make the difference fatal.
+    RenderFrame.exe Assets.pak frame.tga -steps 240 -frames 0 -seed 1 -golden Assets\Golden\frame.tga -tolerance 2 -maxpixels 200
+    IF ERRORLEVEL 1 ECHO Warning: the frame differs from the golden frame, see frame.tga.
+
+    ECHO.
+    ECHO Compiling the replay driver...
+    cl /O2 /Zi /MD /EHsc /nologo Source\ReplayRun.cpp Source\Replay.cpp Source\Simulation.cpp Source\Planet.cpp Source\Ship.cpp Source\Vector.cpp Source\Grid.cpp Source\Collision.cpp Source\Clock.cpp Source\MappedFile.cpp Source\Archive.cpp Source\Mixer.cpp Source\Adpcm.cpp /FeReplayRun.exe
+
+    ECHO.
+    ECHO Compiling the audio benchmark...
+    cl /O2 /Zi /MD /EHsc /nologo Source\AudioBench.cpp Source\Sound.cpp Source\AudioConvert.cpp Source\Adpcm.cpp Source\Mixer.cpp Source\Archive.cpp Source\MappedFile.cpp /FeAudioBench.exe
+
+    ECHO.
+    ECHO Compiling and running the audio mixer check...
+    cl /O2 /Zi /MD /EHsc /nologo Source\MixerCheck.cpp Source\Mixer.cpp Source\Adpcm.cpp Source\Archive.cpp Source\MappedFile.cpp /FeMixerCheck.exe
+    MixerCheck.exe
+    IF ERRORLEVEL 1 EXIT /B 1
+
+    ECHO.
+    ECHO Compiling the rocket benchmark...
+    cl /O2 /Zi /MD /EHsc /nologo Source\RocketBench.cpp Source\Vector.cpp /FeRocketBench.exe
+
+    ECHO.
+    ECHO Compiling the broadphase benchmark...
+    cl /O2 /Zi /MD /EHsc /nologo Source\BroadphaseBench.cpp Source\Simulation.cpp Source\Planet.cpp Source\Ship.cpp Source\Vector.cpp Source\Grid.cpp Source\Collision.cpp Source\Clock.cpp /FeBroadphaseBench.exe
+
+    ECHO.
+    ECHO Compiling and running the collision kernel check...
+    cl /O2 /Zi /MD /EHsc /nologo Source\CollisionCheck.cpp Source\Simulation.cpp Source\Planet.cpp Source\Ship.cpp Source\Vector.cpp Source\Grid.cpp Source\Collision.cpp Source\Clock.cpp /FeCollisionCheck.exe
+    CollisionCheck.exe
+    IF ERRORLEVEL 1 EXIT /B 1
+
+    ECHO.
+    ECHO Compiling and running the render state cache check on WARP...
+    cl /Zi /MD /EHsc /nologo Source\RenderStateCheck.cpp Source\RenderState.cpp /FeRenderStateCheck.exe
+    RenderStateCheck.exe
+    IF ERRORLEVEL 1 EXIT /B 1
 
     ECHO.
     ECHO Compiling and linking Game DLL...    
-    cl /Zi /MD /EHsc /nologo /I%assimp_path% /I%dxtk_path% %game_cpp% /FeGame.dll /link -PDB:game_%random%.pdb /DLL -EXPORT:GameUpdateAndRender %assimp_lib% %dxtk_lib% User32.lib
+    cl /Zi /MD /EHsc /nologo %game_defines% /I%dxtk_path% %game_cpp% /FeGame.dll /link -PDB:game_%random%.pdb /DLL -EXPORT:GameUpdateAndRender %dxtk_lib% User32.lib
     
     ECHO.
     ECHO Compiling and linking Main EXE...  
-    cl /Zi /MD /EHsc /nologo /I%assimp_path% /I%dxtk_path% Source\main.cpp /link %dxtk_lib% User32.lib
+    cl /Zi /MD /EHsc /nologo /I%dxtk_path% Source\main.cpp Source\MappedFile.cpp Source\Archive.cpp Source\Replay.cpp Source\Mixer.cpp Source\Adpcm.cpp Source\DirectSoundBackend.cpp /link %dxtk_lib% User32.lib
 
 ) ELSE (
 
@@ -30,6 +97,20 @@ IF "%arg1%"=="" (
         del .\Game.dll
         del .\Game.lib
         del .\Gametemp.dll
+        del .\AssetPacker.exe
+        del .\MeshStats.exe
+        del .\MeshCheck.exe
+        del .\TGACheck.exe
+        del .\RenderFrame.exe
+        del .\frame.tga
+        del .\ReplayRun.exe
+        del .\MixerCheck.exe
+        del .\AudioBench.exe
+        del .\RocketBench.exe
+        del .\BroadphaseBench.exe
+        del .\CollisionCheck.exe
+        del .\RenderStateCheck.exe
+        del .\Assets.pak
         del .\*.obj
         del .\*.exp
         del .\*.pdb